@@ -0,0 +1,257 @@
+#include "AssembleDiffusionTerm.hpp"
+#include "DecomposeMesh.hpp"
+#include "DistributedLinearSolver.hpp"
+#include "DistributedMesh.hpp"
+#include "Field.hpp"
+#include "GenerateMesh.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Whether a case is stored decomposed into exactly nRanks pieces
+bool isDecomposedFor(const std::string &caseDir, int nRanks)
+{
+  auto processorDir = [&caseDir](int iProcessor) {
+    return caseDir + "/processor" + std::to_string(iProcessor);
+  };
+  return std::filesystem::exists(processorDir(nRanks - 1)) &&
+         !std::filesystem::exists(processorDir(nRanks));
+}
+
+#if GINKGO_BUILD_MPI
+// The z-slab of cell layers of one rank in an nx * ny * nz unit box, plus the
+// neighboring layer on each side as halo. No rank holds the whole box.
+DistributedMesh syntheticSlab(const std::array<std::size_t, 3> &nCells,
+                              int rank, int nRanks)
+{
+  const std::size_t nz = nCells[2];
+  auto firstLayer = [nz, nRanks](int iRank) {
+    return nz * static_cast<std::size_t>(iRank) /
+           static_cast<std::size_t>(nRanks);
+  };
+  const std::size_t kBegin = firstLayer(rank);
+  const std::size_t kEnd = firstLayer(rank + 1);
+  if (kBegin == kEnd) {
+    throw std::runtime_error("Error: " + std::to_string(nz) +
+                             " cell layers cannot be split over " +
+                             std::to_string(nRanks) + " ranks");
+  }
+  const std::size_t haloBegin = kBegin > 0 ? kBegin - 1 : 0;
+  const std::size_t haloEnd = std::min(kEnd + 1, nz);
+
+  Mesh localMesh;
+  GenerateMesh meshGenerator;
+  meshGenerator.cartesianBoxLayers(localMesh, nCells, {1.0, 1.0, 1.0},
+                                   haloBegin, haloEnd);
+
+  // Global cells of a layer are contiguous, so the owned cells of the ranks
+  // are contiguous ranges in rank order
+  const std::size_t layerCells = nCells[0] * nCells[1];
+  std::vector<std::size_t> globalCells(localMesh.nCells());
+  std::vector<std::size_t> cellSubdomains(localMesh.nCells(), rank);
+  for (std::size_t iLocal = 0; iLocal < localMesh.nCells(); ++iLocal) {
+    globalCells[iLocal] = layerCells * haloBegin + iLocal;
+    const std::size_t k = haloBegin + iLocal / layerCells;
+    if (k < kBegin) {
+      cellSubdomains[iLocal] = rank - 1;
+    } else if (k >= kEnd) {
+      cellSubdomains[iLocal] = rank + 1;
+    }
+  }
+  return DistributedMesh(std::move(localMesh), std::move(globalCells),
+                         cellSubdomains, rank, layerCells * nz);
+}
+
+// The piece of a case stored decomposed that belongs to this rank, read from
+// its processor directory only. The cells next to the processor patches are
+// exchanged with the neighboring ranks to form the halo.
+DistributedMesh processorPiece(const std::string &caseDir,
+                               const gko::experimental::mpi::communicator &comm)
+{
+  static_assert(sizeof(std::size_t) == sizeof(std::uint64_t),
+                "Cell indices are exchanged as MPI_UINT64_T");
+  const int rank = comm.rank();
+  Mesh piece(caseDir + "/processor" + std::to_string(rank));
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(piece);
+
+  // Owned cells are numbered contiguously in rank order
+  const std::uint64_t nPieceCells = piece.nCells();
+  std::vector<std::uint64_t> pieceCells(comm.size());
+  MPI_Allgather(&nPieceCells, 1, MPI_UINT64_T, pieceCells.data(), 1,
+                MPI_UINT64_T, comm.get());
+  const std::size_t firstGlobalCell =
+      std::accumulate(pieceCells.begin(), pieceCells.begin() + rank,
+                      std::uint64_t{0});
+  const std::size_t nGlobalCells =
+      std::accumulate(pieceCells.begin(), pieceCells.end(), std::uint64_t{0});
+
+  // Processor patches list their faces in the same order on both sides, and
+  // messages between two ranks arrive in the order they were sent
+  std::vector<ProcessorPatchCells> sentCells(piece.nBoundaries());
+  std::vector<ProcessorPatchCells> receivedCells(piece.nBoundaries());
+  std::vector<MPI_Request> requests;
+  for (std::size_t iBoundary = 0; iBoundary < piece.nBoundaries();
+       ++iBoundary) {
+    const int neighbor = piece.boundaries()[iBoundary].neighborProcessor();
+    if (neighbor < 0) {
+      continue;
+    }
+    const int nFaces = static_cast<int>(piece.boundaries()[iBoundary].nFaces());
+    ProcessorPatchCells &sent = sentCells[iBoundary];
+    ProcessorPatchCells &received = receivedCells[iBoundary];
+    sent = DistributedMesh::processorPatchCells(piece, iBoundary,
+                                                firstGlobalCell);
+    received.globalCells.resize(nFaces);
+    received.centroids.resize(nFaces);
+    requests.resize(requests.size() + 4);
+    MPI_Request *request = &requests[requests.size() - 4];
+    MPI_Isend(sent.globalCells.data(), nFaces, MPI_UINT64_T, neighbor, 0,
+              comm.get(), &request[0]);
+    MPI_Isend(sent.centroids.data(), 3 * nFaces, MPI_DOUBLE, neighbor, 1,
+              comm.get(), &request[1]);
+    MPI_Irecv(received.globalCells.data(), nFaces, MPI_UINT64_T, neighbor, 0,
+              comm.get(), &request[2]);
+    MPI_Irecv(received.centroids.data(), 3 * nFaces, MPI_DOUBLE, neighbor, 1,
+              comm.get(), &request[3]);
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+              MPI_STATUSES_IGNORE);
+
+  return DistributedMesh(std::move(piece), firstGlobalCell, receivedCells,
+                         rank, nGlobalCells);
+}
+#endif
+
+// Steady heat conduction solved on N MPI ranks:
+//   mpirun -np N distributedHeatConduction <caseDirectory>
+//   mpirun -np N distributedHeatConduction synthetic <nx> <ny> <nz> [weak]
+// The synthetic case is a unit box split into z-slabs, each generated by its
+// own rank; with "weak", nz is the number of cell layers per rank so that the
+// work and memory per rank stay constant. A case stored decomposed into N
+// processor directories keeps its decomposition, and each rank reads only
+// its own piece.
+int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[])
+{
+#if GINKGO_BUILD_MPI
+  const gko::experimental::mpi::environment env(argc, argv);
+  const gko::experimental::mpi::communicator comm(MPI_COMM_WORLD);
+  const int rank = comm.rank();
+  const int nRanks = comm.size();
+
+  if (argc < 2 || (std::string(argv[1]) == "synthetic" && argc < 5)) {
+    if (rank == 0) {
+      std::cerr << "Usage: " << argv[0]
+                << " <caseDirectory> | synthetic <nx> <ny> <nz> [weak]"
+                << std::endl;
+    }
+    return 1;
+  }
+
+  auto wallTime = [&comm](auto tic) {
+    const double localTime = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - tic)
+                                 .count();
+    double maxTime = 0.0;
+    MPI_Allreduce(&localTime, &maxTime, 1, MPI_DOUBLE, MPI_MAX, comm.get());
+    return maxTime;
+  };
+
+  // --- Local mesh with one halo layer ---
+  auto tic = std::chrono::steady_clock::now();
+  Decomposition decomposition;
+  auto buildLocalMesh = [&]() {
+    if (std::string(argv[1]) == "synthetic") {
+      std::array<std::size_t, 3> nCells = {std::stoul(argv[2]),
+                                           std::stoul(argv[3]),
+                                           std::stoul(argv[4])};
+      if (argc > 5 && std::string(argv[5]) == "weak") {
+        nCells[2] *= nRanks;
+      }
+      return syntheticSlab(nCells, rank, nRanks);
+    }
+
+    if (isDecomposedFor(argv[1], nRanks)) {
+      return processorPiece(argv[1], comm);
+    }
+
+    // An undecomposed case is read and decomposed identically on all ranks
+    Mesh globalMesh(argv[1]);
+    ReadMesh meshReader;
+    meshReader.readOpenFoamMesh(globalMesh);
+    DecomposeMesh meshDecomposer;
+    meshDecomposer.nSubdomains() = nRanks;
+    meshDecomposer.method() = DecompositionMethod::multilevel;
+    decomposition = meshDecomposer.decompose(globalMesh);
+    return DistributedMesh(globalMesh, decomposition, rank);
+  };
+  DistributedMesh distributedMesh = buildLocalMesh();
+  Mesh &localMesh = distributedMesh.localMesh();
+  const double meshTime = wallTime(tic);
+
+  // --- Assemble the local rows: T = 1 on the first patch, 0 elsewhere ---
+  tic = std::chrono::steady_clock::now();
+  std::vector<boundaryField<double>> boundaryTemperatureFields(
+      localMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < localMesh.nBoundaries();
+       ++iBoundary) {
+    boundaryTemperatureFields[iBoundary].setBoundaryType("fixedValue");
+    boundaryTemperatureFields[iBoundary].resize(
+        localMesh.boundaries()[iBoundary].nFaces());
+    boundaryTemperatureFields[iBoundary].set(iBoundary == 0 ? 1.0 : 0.0);
+  }
+  const std::vector<double> diffusionCoef(localMesh.nFaces(), 1.0);
+  const std::vector<double> heatSource(localMesh.nCells(), 0.0);
+  gko::matrix_data<double, int> localMatrix;
+  std::vector<double> localRHS(localMesh.nCells(), 0.0);
+  AssembleDiffusionTerm diffusionTermAssembler;
+  diffusionTermAssembler.faceBasedAssemble(localMesh, diffusionCoef, heatSource,
+                                           boundaryTemperatureFields,
+                                           localMatrix, localRHS);
+  const auto ownedRows =
+      distributedMesh.ownedRows<std::int64_t>(localMatrix);
+  std::vector<double> RHS = distributedMesh.ownedValues(localRHS);
+  const double assemblyTime = wallTime(tic);
+
+  // --- Solve ---
+  tic = std::chrono::steady_clock::now();
+  std::vector<double> temperature(RHS.size(), 0.0);
+  DistributedLinearSolver solver(comm);
+  if (decomposition.cellToSubdomain().empty()) {
+    solver.solve(ownedRows, RHS, temperature, 1.0e-8, 10000);
+  } else {
+    solver.solve(ownedRows, decomposition.cellToSubdomain(), RHS, temperature,
+                 1.0e-8, 10000);
+  }
+  const double solveTime = wallTime(tic);
+
+  if (rank == 0) {
+    std::cout << "Ranks: " << nRanks << "\n"
+              << "Cells: " << distributedMesh.nGlobalCells() << "\n";
+    if (!decomposition.cellToSubdomain().empty()) {
+      std::cout << "Edge cut: " << decomposition.edgeCut()
+                << ", imbalance: " << decomposition.imbalance() << "\n";
+    }
+    std::cout << "Local mesh: " << meshTime << " ms\n"
+              << "Assembly: " << assemblyTime << " ms\n"
+              << "Solve: " << solveTime << " ms (" << solver.nIterations()
+              << " iterations)" << std::endl;
+  }
+  return 0;
+#else
+  std::cerr << "Ginkgo was built without MPI support (GINKGO_BUILD_MPI)."
+            << std::endl;
+  return 1;
+#endif
+}
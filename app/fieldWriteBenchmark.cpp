@@ -0,0 +1,129 @@
+#include "AsyncWriteField.hpp"
+#include "WriteField.hpp"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Throughput of writing a scalar field, against formatting every value with
+// std::ofstream, with and without compression, and the time a loop spends
+// in asynchronous writes:
+//   fieldWriteBenchmark [nValues] [nRepeats]     (default 4000000 values)
+int main(int argc, char *argv[])
+{
+  const std::size_t nValues = argc > 1 ? std::stoul(argv[1]) : 4000000;
+  const std::size_t nRepeats = argc > 2 ? std::stoul(argv[2]) : 3;
+
+  // A case with the initial conditions that the writer takes the
+  // dimensions and boundaryField entries from
+  const std::filesystem::path caseDirectory =
+      std::filesystem::temp_directory_path() / "fieldWriteBenchmark";
+  std::filesystem::create_directories(caseDirectory / "0");
+  std::ofstream(caseDirectory / "0" / "T")
+      << "dimensions      [0 0 0 1 0 0 0];\n\n"
+      << "internalField   uniform 0;\n\n"
+      << "boundaryField\n{\n    walls\n    {\n        type            "
+         "zeroGradient;\n    }\n}\n";
+
+  std::vector<double> values(nValues);
+  for (std::size_t i = 0; i < nValues; ++i) {
+    values[i] = 300.0 + 50.0 * std::sin(1.0e-3 * static_cast<double>(i));
+  }
+
+  const auto measure = [nRepeats](const auto &writeOnce) {
+    std::size_t nBytes = writeOnce(); // Warm-up
+    const auto tic = std::chrono::steady_clock::now();
+    for (std::size_t iRepeat = 0; iRepeat < nRepeats; ++iRepeat) {
+      nBytes = writeOnce();
+    }
+    const double time = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - tic)
+                            .count() /
+                        static_cast<double>(nRepeats);
+    std::cout << std::setw(10) << std::fixed << std::setprecision(1)
+              << 1.0e-6 * static_cast<double>(nBytes) << std::setw(12)
+              << 1.0e3 * time << std::setw(10)
+              << 1.0e-6 * static_cast<double>(nBytes) / time << "\n";
+  };
+
+  std::cout << "Values: " << nValues << "\n"
+            << std::setw(24) << "" << std::setw(10) << "size [MB]"
+            << std::setw(12) << "time [ms]" << std::setw(10) << "MB/s"
+            << "\n";
+
+  // Reference: the values formatted one by one by the stream
+  std::cout << std::setw(24) << std::left << "ofstream, fixed 6"
+            << std::right;
+  measure([&]() {
+    const std::filesystem::path filePath = caseDirectory / "1" / "T";
+    std::filesystem::create_directories(filePath.parent_path());
+    std::ofstream outFile(filePath);
+    outFile << "internalField   nonuniform List<scalar>\n"
+            << values.size() << "\n(\n";
+    for (const auto &value : values) {
+      outFile << "    " << std::fixed << std::setprecision(6) << value
+              << "\n";
+    }
+    outFile << ");\n";
+    outFile.close();
+    return static_cast<std::size_t>(std::filesystem::file_size(filePath));
+  });
+
+  WriteField fieldWriter(caseDirectory.string());
+  for (const int precision : {6, 0}) {
+    fieldWriter.writePrecision() = precision;
+    std::cout << std::setw(24) << std::left
+              << (precision > 0 ? "WriteField, precision 6"
+                                : "WriteField, shortest")
+              << std::right;
+    measure([&]() {
+      fieldWriter.write(values, "1", "T");
+      return fieldWriter.bytesWritten();
+    });
+  }
+  // Compressed on the OpenMP threads, sizes of the .gz files
+  fieldWriter.writePrecision() = 6;
+  fieldWriter.writeCompression() = true;
+  std::cout << std::setw(24) << std::left << "WriteField, 6, gzip"
+            << std::right;
+  measure([&]() {
+    fieldWriter.write(values, "1", "T");
+    return fieldWriter.bytesWritten();
+  });
+  fieldWriter.writeCompression() = false;
+
+  fieldWriter.writeFormat() = WriteFormat::binary;
+  std::cout << std::setw(24) << std::left << "WriteField, binary"
+            << std::right;
+  measure([&]() {
+    fieldWriter.write(values, "1", "T");
+    return fieldWriter.bytesWritten();
+  });
+
+  // In a time loop the asynchronous writer blocks only for the snapshot,
+  // until the queue is full
+  AsyncWriteField asyncFieldWriter(caseDirectory.string());
+  asyncFieldWriter.fieldWriter().writePrecision() = 6;
+  const auto tic = std::chrono::steady_clock::now();
+  for (std::size_t iRepeat = 0; iRepeat < nRepeats; ++iRepeat) {
+    asyncFieldWriter.write(values, std::to_string(iRepeat + 1), "T");
+  }
+  const double submitTime = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - tic)
+                                .count();
+  asyncFieldWriter.flush();
+  const double totalTime = std::chrono::duration<double, std::milli>(
+                               std::chrono::steady_clock::now() - tic)
+                               .count();
+  std::cout << "AsyncWriteField, precision 6: "
+            << submitTime / static_cast<double>(nRepeats)
+            << " ms per write in the loop, " << totalTime
+            << " ms until flushed\n";
+
+  std::filesystem::remove_all(caseDirectory);
+  return 0;
+}
@@ -0,0 +1,180 @@
+#include "AssembleDiffusionTerm.hpp"
+#include "CsrMatrix.hpp"
+#include "DecomposeMesh.hpp"
+#include "DistributedMesh.hpp"
+#include "Field.hpp"
+#include "GenerateMesh.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Communication hidden behind computation in the distributed SpMV:
+//   mpirun -np N haloOverlapBenchmark <caseDirectory> [nRepeats]
+//   mpirun -np N haloOverlapBenchmark synthetic <nx> <ny> <nz> [nRepeats]
+// The local cells are numbered interior first, so the rows that need no halo
+// values are multiplied while the non-blocking halo exchange is in flight
+// and the interface rows are finished after it completes.
+int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[])
+{
+#if GINKGO_BUILD_MPI
+  const gko::experimental::mpi::environment env(argc, argv);
+  const gko::experimental::mpi::communicator comm(MPI_COMM_WORLD);
+  const int rank = comm.rank();
+  const int nRanks = comm.size();
+
+  const bool synthetic = argc > 1 && std::string(argv[1]) == "synthetic";
+  if (argc < 2 || (synthetic && argc < 5)) {
+    if (rank == 0) {
+      std::cerr << "Usage: " << argv[0]
+                << " <caseDirectory> [nRepeats] | synthetic <nx> <ny> <nz> "
+                   "[nRepeats]"
+                << std::endl;
+    }
+    return 1;
+  }
+  const int repeatArg = synthetic ? 5 : 2;
+  const std::size_t nRepeats =
+      argc > repeatArg ? std::stoul(argv[repeatArg]) : 1000;
+
+  // --- Mesh, decomposition and local rows ---
+  Mesh globalMesh;
+  DecomposeMesh meshDecomposer;
+  if (synthetic) {
+    GenerateMesh meshGenerator;
+    meshGenerator.cartesianBox(
+        globalMesh,
+        {std::stoul(argv[2]), std::stoul(argv[3]), std::stoul(argv[4])},
+        {1.0, 1.0, 1.0});
+    meshDecomposer.method() = DecompositionMethod::recursiveBisection;
+  } else {
+    globalMesh.caseDir() = argv[1];
+    ReadMesh meshReader;
+    meshReader.readOpenFoamMesh(globalMesh);
+    meshDecomposer.method() = DecompositionMethod::multilevel;
+  }
+  meshDecomposer.nSubdomains() = nRanks;
+  Decomposition decomposition = meshDecomposer.decompose(globalMesh);
+  DistributedMesh distributedMesh(globalMesh, decomposition, rank,
+                                  LocalCellOrdering::interiorFirst);
+  Mesh &localMesh = distributedMesh.localMesh();
+
+  std::vector<boundaryField<double>> boundaryFields(localMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < localMesh.nBoundaries();
+       ++iBoundary) {
+    boundaryFields[iBoundary].setBoundaryType("fixedValue");
+    boundaryFields[iBoundary].resize(
+        localMesh.boundaries()[iBoundary].nFaces());
+    boundaryFields[iBoundary].set(1.0);
+  }
+  const std::vector<double> diffusionCoef(localMesh.nFaces(), 1.0);
+  const std::vector<double> source(localMesh.nCells(), 0.0);
+  gko::matrix_data<double, int> localMatrix;
+  std::vector<double> RHS(localMesh.nCells(), 0.0);
+  AssembleDiffusionTerm diffusionTermAssembler;
+  diffusionTermAssembler.faceBasedAssemble(localMesh, diffusionCoef, source,
+                                           boundaryFields, localMatrix, RHS);
+  const CsrMatrix<double, int> matrix(localMatrix);
+
+  // --- Non-blocking halo exchange of x ---
+  const auto &exchanges = distributedMesh.haloExchanges();
+  std::vector<double> x(localMesh.nCells(), 1.0);
+  std::vector<double> y(localMesh.nCells(), 0.0);
+  std::vector<std::vector<double>> sendBuffers(exchanges.size());
+  std::vector<std::vector<double>> receiveBuffers(exchanges.size());
+  for (std::size_t k = 0; k < exchanges.size(); ++k) {
+    sendBuffers[k].resize(exchanges[k].sendCells.size());
+    receiveBuffers[k].resize(exchanges[k].receiveCells.size());
+  }
+  std::vector<MPI_Request> requests(2 * exchanges.size());
+
+  auto startExchange = [&]() {
+    for (std::size_t k = 0; k < exchanges.size(); ++k) {
+      const int neighbor = static_cast<int>(exchanges[k].neighbor);
+      MPI_Irecv(receiveBuffers[k].data(),
+                static_cast<int>(receiveBuffers[k].size()), MPI_DOUBLE,
+                neighbor, 0, comm.get(), &requests[2 * k]);
+      for (std::size_t i = 0; i < sendBuffers[k].size(); ++i) {
+        sendBuffers[k][i] = x[exchanges[k].sendCells[i]];
+      }
+      MPI_Isend(sendBuffers[k].data(), static_cast<int>(sendBuffers[k].size()),
+                MPI_DOUBLE, neighbor, 0, comm.get(), &requests[2 * k + 1]);
+    }
+  };
+  auto finishExchange = [&]() {
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+                MPI_STATUSES_IGNORE);
+    for (std::size_t k = 0; k < exchanges.size(); ++k) {
+      for (std::size_t i = 0; i < receiveBuffers[k].size(); ++i) {
+        x[exchanges[k].receiveCells[i]] = receiveBuffers[k][i];
+      }
+    }
+  };
+
+  // Mean time of one repetition in ms, the slowest rank counts
+  auto timeLoop = [&](auto &&body) {
+    MPI_Barrier(comm.get());
+    const auto tic = std::chrono::steady_clock::now();
+    for (std::size_t iRepeat = 0; iRepeat < nRepeats; ++iRepeat) {
+      body();
+    }
+    const double localTime = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - tic)
+                                 .count() /
+                             static_cast<double>(nRepeats);
+    double maxTime = 0.0;
+    MPI_Allreduce(&localTime, &maxTime, 1, MPI_DOUBLE, MPI_MAX, comm.get());
+    return maxTime;
+  };
+
+  const std::size_t nInteriorCells = distributedMesh.nInteriorCells();
+  const std::size_t nOwnedCells = distributedMesh.nOwnedCells();
+  const double exchangeTime = timeLoop([&]() {
+    startExchange();
+    finishExchange();
+  });
+  const double spmvTime = timeLoop(
+      [&]() { matrix.apply(x.data(), y.data(), 0, nOwnedCells); });
+  const double sequentialTime = timeLoop([&]() {
+    startExchange();
+    finishExchange();
+    matrix.apply(x.data(), y.data(), 0, nOwnedCells);
+  });
+  const double overlappedTime = timeLoop([&]() {
+    startExchange();
+    matrix.apply(x.data(), y.data(), 0, nInteriorCells);
+    finishExchange();
+    matrix.apply(x.data(), y.data(), nInteriorCells, nOwnedCells);
+  });
+
+  unsigned long long counts[2] = {nInteriorCells, nOwnedCells};
+  unsigned long long totals[2] = {0, 0};
+  MPI_Reduce(counts, totals, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0,
+             comm.get());
+  if (rank == 0) {
+    const double hiddenTime = std::clamp(sequentialTime - overlappedTime, 0.0,
+                                         exchangeTime);
+    std::cout << "Ranks: " << nRanks << "\n"
+              << "Cells: " << globalMesh.nCells() << " ("
+              << 100.0 * static_cast<double>(totals[0]) /
+                     static_cast<double>(totals[1])
+              << "% interior)\n"
+              << "Halo exchange: " << exchangeTime << " ms\n"
+              << "SpMV: " << spmvTime << " ms\n"
+              << "Exchange then SpMV: " << sequentialTime << " ms\n"
+              << "Overlapped: " << overlappedTime << " ms\n"
+              << "Hidden communication: " << hiddenTime << " ms ("
+              << (exchangeTime > 0.0 ? 100.0 * hiddenTime / exchangeTime : 0.0)
+              << "% of the exchange)" << std::endl;
+  }
+  return 0;
+#else
+  std::cerr << "Ginkgo was built without MPI support (GINKGO_BUILD_MPI)."
+            << std::endl;
+  return 1;
+#endif
+}
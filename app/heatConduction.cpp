@@ -4,9 +4,12 @@
 #include "LinearSolver.hpp"
 #include "Matrix.hpp"
 #include "Mesh.hpp"
+#include "MeshQuality.hpp"
 #include "PostProcessing.hpp"
 #include "ReadInitialBoundaryConditions.hpp"
 #include "ReadMesh.hpp"
+#include "WriteField.hpp"
+#include "WriteVtu.hpp"
 #include "ginkgo/ginkgo.hpp"
 #include <iomanip>
 #include <vector>
@@ -45,6 +48,8 @@ int main(int argc, char *argv[])
   Mesh fvMesh(caseDirectory);
   ReadMesh meshReader;
   meshReader.readOpenFoamMesh(fvMesh);
+  MeshQuality meshQuality;
+  meshQuality.writeSummary(meshQuality.check(fvMesh), std::cout);
 
   using ValueType = std::array<double, 3>;
   using IndexType = int;
@@ -106,6 +111,30 @@ int main(int argc, char *argv[])
   auto generate_time =
       std::chrono::duration_cast<std::chrono::nanoseconds>(g_tac - g_tic);
   std::cout << "Matrix assembly took " << generate_time.count() / 1000000 << "ms \n";
+
+  // Solve for each velocity component and write the velocity in the
+  // writeFormat of the controlDict
+  std::vector<ValueType> velocity(fvMesh.nCells(), {0.0, 0.0, 0.0});
+  LinearSolver solver;
+  for (std::size_t dim = 0; dim < 3; ++dim) {
+    std::vector<double> componentRHS(fvMesh.nCells());
+    std::vector<double> componentSolution(fvMesh.nCells(), 0.0);
+    for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+      componentRHS[iElement] = RHS[iElement][dim];
+    }
+    solver.solve(coeffMatrix[dim], componentRHS, componentSolution, 1.0e-8,
+                 1000);
+    for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+      velocity[iElement][dim] = componentSolution[iElement];
+    }
+  }
+  WriteField fieldWriter(caseDirectory);
+  fieldWriter.write(velocity, "1", "U", fvMesh.cellOrdering());
+
+  // The same time step for ParaView, as VTK/<case>.pvd
+  WriteVtu vtuWriter(fvMesh);
+  vtuWriter.addField("U", velocity);
+  vtuWriter.writeTimeStep(1.0);
   // for (size_t dim = 0; dim < 3; dim++) {
 
   //   using mtx = gko::matrix::Csr<double, int>;
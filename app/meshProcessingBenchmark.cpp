@@ -0,0 +1,86 @@
+#include "GenerateMesh.hpp"
+#include "Mesh.hpp"
+#include "MeshQuality.hpp"
+#include "ProcessMesh.hpp"
+#include "ReadMesh.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Thread scaling of the mesh geometry processing:
+//   meshProcessingBenchmark [n] [nRepeats]          n x n x n box (default 128)
+//   meshProcessingBenchmark <caseDirectory> [nRepeats]
+int main(int argc, char *argv[])
+{
+  Mesh fvMesh;
+  const std::string meshArg = argc > 1 ? argv[1] : "128";
+  if (meshArg.find_first_not_of("0123456789") == std::string::npos) {
+    const std::size_t n = std::stoul(meshArg);
+    GenerateMesh meshGenerator;
+    meshGenerator.cartesianBox(fvMesh, {n, n, n}, {1.0, 1.0, 1.0});
+  } else {
+    fvMesh.caseDir() = meshArg;
+    ReadMesh meshReader;
+    meshReader.readOpenFoamMesh(fvMesh);
+  }
+  const std::size_t nRepeats = argc > 2 ? std::stoul(argv[2]) : 5;
+
+  std::vector<int> threadCounts = {1};
+#ifdef _OPENMP
+  const int maxThreads = omp_get_max_threads();
+  for (int nThreads = 2; nThreads < maxThreads; nThreads *= 2) {
+    threadCounts.push_back(nThreads);
+  }
+  if (maxThreads > 1) {
+    threadCounts.push_back(maxThreads);
+  }
+#endif
+
+  std::cout << "Cells: " << fvMesh.nCells() << ", faces: " << fvMesh.nFaces()
+            << "\n"
+            << std::setw(8) << "threads" << std::setw(14) << "time [ms]"
+            << std::setw(10) << "speedup" << "\n";
+  ProcessMesh meshProcessor;
+  double serialTime = 0.0;
+  for (const int nThreads : threadCounts) {
+#ifdef _OPENMP
+    omp_set_num_threads(nThreads);
+#endif
+    meshProcessor.processOpenFoamMesh(fvMesh); // Warm-up
+    const auto tic = std::chrono::steady_clock::now();
+    for (std::size_t iRepeat = 0; iRepeat < nRepeats; ++iRepeat) {
+      meshProcessor.processOpenFoamMesh(fvMesh);
+    }
+    const double time = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - tic)
+                            .count() /
+                        static_cast<double>(nRepeats);
+    if (nThreads == 1) {
+      serialTime = time;
+    }
+    std::cout << std::setw(8) << nThreads << std::setw(14) << std::fixed
+              << std::setprecision(2) << time << std::setw(10)
+              << serialTime / time << "\n";
+  }
+
+  // The quality check is meant to run on every load, so it has to stay a
+  // small fraction of the processing time
+  MeshQuality meshQuality;
+  MeshQualityReport report = meshQuality.check(fvMesh);
+  const auto tic = std::chrono::steady_clock::now();
+  for (std::size_t iRepeat = 0; iRepeat < nRepeats; ++iRepeat) {
+    report = meshQuality.check(fvMesh);
+  }
+  const double qualityTime = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - tic)
+                                 .count() /
+                             static_cast<double>(nRepeats);
+  std::cout << "Quality check: " << qualityTime << " ms\n";
+  meshQuality.writeSummary(report, std::cout);
+  return 0;
+}
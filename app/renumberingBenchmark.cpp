@@ -0,0 +1,121 @@
+#include "AssembleDiffusionTerm.hpp"
+#include "CsrMatrix.hpp"
+#include "Field.hpp"
+#include "Graph.hpp"
+#include "GraphOrdering.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "RenumberMesh.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult
+{
+  std::size_t bandwidth = 0;
+  double assemblyTime = 0.0; // ms per assembly
+  double spmvTime = 0.0;     // ms per SpMV
+};
+
+// Time the face-based assembly and the SpMV of the diffusion matrix. Run the
+// benchmark under `perf stat -e cache-misses,LLC-load-misses` to compare the
+// cache misses of the orderings.
+BenchmarkResult runBenchmark(Mesh &fvMesh, const std::size_t nRepeats)
+{
+  BenchmarkResult result;
+  result.bandwidth = GraphOrdering::bandwidth(Graph(fvMesh));
+
+  std::vector<boundaryField<double>> boundaryFields(fvMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    boundaryFields[iBoundary].setBoundaryType("fixedValue");
+    boundaryFields[iBoundary].resize(fvMesh.boundaries()[iBoundary].nFaces());
+    boundaryFields[iBoundary].set(1.0);
+  }
+  const std::vector<double> diffusionCoef(fvMesh.nFaces(), 1.0);
+  const std::vector<double> source(fvMesh.nCells(), 0.0);
+  AssembleDiffusionTerm diffusionTermAssembler;
+
+  gko::matrix_data<double, int> coeffMatrix;
+  std::vector<double> RHS;
+  auto tic = std::chrono::steady_clock::now();
+  for (std::size_t iRepeat = 0; iRepeat < nRepeats; ++iRepeat) {
+    coeffMatrix = gko::matrix_data<double, int>();
+    RHS.assign(fvMesh.nCells(), 0.0);
+    diffusionTermAssembler.faceBasedAssemble(
+        fvMesh, diffusionCoef, source, boundaryFields, coeffMatrix, RHS);
+  }
+  auto tac = std::chrono::steady_clock::now();
+  result.assemblyTime =
+      std::chrono::duration<double, std::milli>(tac - tic).count() / nRepeats;
+
+  const CsrMatrix<double, int> matrix(coeffMatrix);
+  std::vector<double> x(fvMesh.nCells(), 1.0);
+  std::vector<double> y(fvMesh.nCells(), 0.0);
+  tic = std::chrono::steady_clock::now();
+  for (std::size_t iRepeat = 0; iRepeat < 10 * nRepeats; ++iRepeat) {
+    matrix.apply(x.data(), y.data());
+    std::swap(x, y);
+  }
+  tac = std::chrono::steady_clock::now();
+  result.spmvTime = std::chrono::duration<double, std::milli>(tac - tic).count() /
+                    (10 * nRepeats);
+
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0]
+              << " <caseDirectory> [ordering: rcm/hilbert/morton] [nRepeats]"
+              << std::endl;
+    return 1;
+  }
+  std::string caseDirectory(argv[1]);
+  std::string ordering(argc > 2 ? argv[2] : "rcm");
+  const std::size_t nRepeats = argc > 3 ? std::stoul(argv[3]) : 10;
+
+  if (ordering != "rcm" && ordering != "hilbert" && ordering != "morton") {
+    std::cerr << "Invalid ordering. Use 'rcm', 'hilbert', or 'morton'."
+              << std::endl;
+    return 1;
+  }
+
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  const BenchmarkResult before = runBenchmark(fvMesh, nRepeats);
+
+  auto tic = std::chrono::steady_clock::now();
+  RenumberMesh meshRenumberer;
+  if (ordering == "rcm") {
+    meshRenumberer.reverseCuthillMcKee(fvMesh);
+  } else if (ordering == "hilbert") {
+    meshRenumberer.spaceFillingCurve(fvMesh, SpaceFillingCurve::hilbert);
+  } else {
+    meshRenumberer.spaceFillingCurve(fvMesh, SpaceFillingCurve::morton);
+  }
+  auto tac = std::chrono::steady_clock::now();
+  const double renumberTime =
+      std::chrono::duration<double, std::milli>(tac - tic).count();
+
+  const BenchmarkResult after = runBenchmark(fvMesh, nRepeats);
+
+  std::cout << "Cells: " << fvMesh.nCells() << "\n"
+            << "Renumbering took " << renumberTime << " ms\n"
+            << "             original " << std::setw(10) << ordering
+            << "    speedup\n"
+            << "bandwidth  " << std::setw(10) << before.bandwidth << " "
+            << std::setw(10) << after.bandwidth << "\n"
+            << "assembly   " << std::setw(10) << before.assemblyTime << " "
+            << std::setw(10) << after.assemblyTime << " " << std::setw(10)
+            << before.assemblyTime / after.assemblyTime << "\n"
+            << "SpMV       " << std::setw(10) << before.spmvTime << " "
+            << std::setw(10) << after.spmvTime << " " << std::setw(10)
+            << before.spmvTime / after.spmvTime << std::endl;
+  return 0;
+}
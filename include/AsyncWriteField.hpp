@@ -0,0 +1,73 @@
+#ifndef ASYNC_WRITE_FIELD_HPP
+#define ASYNC_WRITE_FIELD_HPP
+
+#include "WriteField.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Write fields on a background thread, so that a time loop only pays for a
+// copy of the values. At most maxQueueDepth writes wait behind the one in
+// progress; further writes block until the queue has room, which bounds the
+// memory of the snapshots when the disk cannot keep up. An error of a
+// background write is thrown by the next call of write() or flush().
+class AsyncWriteField {
+public:
+  explicit AsyncWriteField(const std::string &caseDirectory,
+                           std::size_t maxQueueDepth = 2);
+  ~AsyncWriteField();
+
+  AsyncWriteField(const AsyncWriteField &) = delete;
+  AsyncWriteField &operator=(const AsyncWriteField &) = delete;
+
+  // Queue a write of the values, which are taken as a snapshot. Pass the
+  // values with std::move to avoid the copy, e.g. to swap between two
+  // buffers.
+  template <typename ValueType>
+  void write(std::vector<ValueType> values, const std::string &timePoint,
+             const std::string &fieldName,
+             std::vector<std::size_t> cellOrdering = {});
+
+  // Wait until all queued writes are on disk
+  void flush();
+
+  // The writer of the background thread; change its settings only after
+  // flush()
+  WriteField &fieldWriter() { return fieldWriter_; }
+
+private:
+  void enqueue(std::function<void()> task);
+  void rethrowError();
+  void run();
+
+  WriteField fieldWriter_;
+  std::size_t maxQueueDepth_;
+
+  std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  std::condition_variable progress_;
+  std::deque<std::function<void()>> queue_;
+  bool busy_ = false;
+  bool stop_ = false;
+  std::exception_ptr error_;
+
+  // Started last, once the members it uses are constructed
+  std::thread worker_;
+};
+
+// Prevent implicit instantiation of the template function for these types
+extern template void AsyncWriteField::write(
+    std::vector<double> values, const std::string &timePoint,
+    const std::string &fieldName, std::vector<std::size_t> cellOrdering);
+extern template void AsyncWriteField::write(
+    std::vector<std::array<double, 3>> values, const std::string &timePoint,
+    const std::string &fieldName, std::vector<std::size_t> cellOrdering);
+
+#endif // ASYNC_WRITE_FIELD_HPP
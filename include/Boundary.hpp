@@ -1,6 +1,9 @@
 #ifndef BOUNDARY_HPP
 #define BOUNDARY_HPP
+#include <array>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 class Boundary {
 public:
@@ -10,11 +13,28 @@ public:
   std::size_t &nFaces() { return nFaces_; }
   std::size_t &startFace() { return startFace_; }
 
+  // Piece on the other side of a processor patch (-1 for other patches)
+  int &neighborProcessor() { return neighborProcessor_; }
+
+  // Geometry of the faces of the patch in patch order, gathered from the faces
+  // by ProcessMesh so that boundary loops stream through contiguous arrays
+  std::vector<std::size_t> &faceOwners() { return faceOwners_; }
+  std::vector<double> &gDiff() { return gDiff_; }
+  std::vector<double> &area() { return area_; }
+  std::vector<std::array<double, 3>> &Sf() { return Sf_; }
+  std::vector<double> &walldist() { return walldist_; }
+
 private:
   std::string userName_ = "";
   std::size_t index_ = 0;
   std::string type_ = "";
   std::size_t nFaces_ = 0;
   std::size_t startFace_ = 0;
+  int neighborProcessor_ = -1;
+  std::vector<std::size_t> faceOwners_;
+  std::vector<double> gDiff_;
+  std::vector<double> area_;
+  std::vector<std::array<double, 3>> Sf_;
+  std::vector<double> walldist_;
 };
 #endif
\ No newline at end of file
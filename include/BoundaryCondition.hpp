@@ -0,0 +1,81 @@
+#ifndef BOUNDARY_CONDITION_HPP
+#define BOUNDARY_CONDITION_HPP
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Boundary condition types. The type names of the field files are resolved
+// once when a field is read, so that assembly dispatches on the enum once per
+// patch and never compares strings.
+enum class BoundaryConditionType {
+  fixedValue,    // Dirichlet
+  zeroGradient,  // Zero Neumann
+  fixedGradient, // Neumann
+  mixed,         // Robin: valueFraction blends fixedValue and fixedGradient
+  empty          // No contribution (1D and 2D cases)
+};
+
+// Types that add nothing to the matrix here and are treated as
+// zeroGradient; the field keeps the original name for writing it back
+inline bool isZeroGradientLike(const std::string &typeName)
+{
+  const std::string wallFunction = "WallFunction";
+  return typeName == "calculated" || typeName == "symmetryPlane" ||
+         typeName == "symmetry" || typeName == "slip" ||
+         (typeName.size() > wallFunction.size() &&
+          typeName.compare(typeName.size() - wallFunction.size(),
+                           wallFunction.size(), wallFunction) == 0);
+}
+
+// Resolve a type name of a field file; noSlip is a zero fixedValue. Coupled
+// types (processor, cyclic) and unknown names, e.g. a misspelled fixedvalue,
+// are rejected with std::invalid_argument.
+inline BoundaryConditionType
+toBoundaryConditionType(const std::string &typeName)
+{
+  if (typeName == "fixedValue" || typeName == "noSlip") {
+    return BoundaryConditionType::fixedValue;
+  }
+  if (typeName == "zeroGradient" || isZeroGradientLike(typeName)) {
+    return BoundaryConditionType::zeroGradient;
+  }
+  if (typeName == "fixedGradient") {
+    return BoundaryConditionType::fixedGradient;
+  }
+  if (typeName == "mixed") {
+    return BoundaryConditionType::mixed;
+  }
+  if (typeName == "empty") {
+    return BoundaryConditionType::empty;
+  }
+  if (typeName.rfind("processor", 0) == 0 || typeName.rfind("cyclic", 0) == 0) {
+    throw std::invalid_argument("Coupled boundary condition type " + typeName +
+                                " is not supported");
+  }
+  throw std::invalid_argument("Unknown boundary condition type " + typeName);
+}
+
+// Call f(std::integral_constant<BoundaryConditionType, type>{}), so that the
+// kernel called by f is compiled separately for each type
+template <typename Function>
+decltype(auto) dispatchBoundaryCondition(BoundaryConditionType type,
+                                         Function &&f)
+{
+  using Type = BoundaryConditionType;
+  switch (type) {
+  case Type::fixedValue:
+    return f(std::integral_constant<Type, Type::fixedValue>{});
+  case Type::zeroGradient:
+    return f(std::integral_constant<Type, Type::zeroGradient>{});
+  case Type::fixedGradient:
+    return f(std::integral_constant<Type, Type::fixedGradient>{});
+  case Type::mixed:
+    return f(std::integral_constant<Type, Type::mixed>{});
+  case Type::empty:
+    break;
+  }
+  return f(std::integral_constant<Type, Type::empty>{});
+}
+
+#endif // BOUNDARY_CONDITION_HPP
@@ -0,0 +1,55 @@
+#ifndef CHEBYSHEV_PRECONDITIONER_HPP
+#define CHEBYSHEV_PRECONDITIONER_HPP
+
+#include "CsrMatrix.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Methods to bound the spectrum of the Jacobi scaled matrix D^{-1} * A
+enum class SpectralEstimate
+{
+  gershgorin, // Gershgorin discs of the assembled rows (no reductions at all)
+  lanczos     // A few Lanczos steps, sharper but needs inner products at setup
+};
+
+// Chebyshev polynomial preconditioner (or smoother) for symmetric positive
+// definite matrices. It approximates A^{-1} by a fixed polynomial in
+// D^{-1} * A, so applying it only needs matrix-vector products and vector
+// updates and no global reductions.
+template <typename ValueType, typename IndexType>
+class ChebyshevPreconditioner
+{
+public:
+  ChebyshevPreconditioner(std::shared_ptr<const CsrMatrix<ValueType, IndexType>> matrix,
+                          std::size_t degree = 3,
+                          SpectralEstimate estimate = SpectralEstimate::lanczos,
+                          std::size_t nLanczosSteps = 10,
+                          ValueType eigenvalueRatio = 30.0);
+
+  // Compute z = p(D^{-1} * A) * D^{-1} * r; z must not alias r
+  void apply(const ValueType *r, ValueType *z) const;
+
+  // Interval of D^{-1} * A the polynomial is optimized for
+  ValueType minEigenvalue() const { return minEigenvalue_; }
+  ValueType maxEigenvalue() const { return maxEigenvalue_; }
+
+private:
+  void estimateGershgorin();
+  void estimateLanczos(std::size_t nSteps);
+
+  std::shared_ptr<const CsrMatrix<ValueType, IndexType>> matrix_;
+  std::size_t degree_;
+  ValueType eigenvalueRatio_;
+  std::vector<ValueType> invDiag_;
+  ValueType minEigenvalue_ = 0.0;
+  ValueType maxEigenvalue_ = 0.0;
+
+  // Work vectors for the Chebyshev recurrence
+  mutable std::vector<ValueType> direction_;
+};
+
+// Prevent implicit instantiation of the template class for these types
+extern template class ChebyshevPreconditioner<double, int>;
+
+#endif // CHEBYSHEV_PRECONDITIONER_HPP
@@ -0,0 +1,55 @@
+#ifndef CSR_MATRIX_HPP
+#define CSR_MATRIX_HPP
+
+#include "ginkgo/ginkgo.hpp"
+#include <cstddef>
+#include <vector>
+
+// Compressed sparse row matrix used by the native preconditioners and solvers.
+// Column indices are sorted within each row and duplicates are summed.
+template <typename ValueType, typename IndexType>
+class CsrMatrix
+{
+public:
+  CsrMatrix() = default;
+
+  // Convert an assembled matrix (in any order, possibly with duplicates)
+  CsrMatrix(const gko::matrix_data<ValueType, IndexType> &data);
+
+  // Take ownership of already compressed arrays
+  CsrMatrix(std::vector<IndexType> rowPtrs, std::vector<IndexType> colIdxs,
+            std::vector<ValueType> values);
+
+  std::size_t nRows() const { return nRows_; }
+  std::size_t nNonzeros() const { return colIdxs_.size(); }
+  std::vector<IndexType> &rowPtrs() { return rowPtrs_; }
+  std::vector<IndexType> &colIdxs() { return colIdxs_; }
+  std::vector<ValueType> &values() { return values_; }
+  const std::vector<IndexType> &rowPtrs() const { return rowPtrs_; }
+  const std::vector<IndexType> &colIdxs() const { return colIdxs_; }
+  const std::vector<ValueType> &values() const { return values_; }
+
+  // Compute y = A * x
+  void apply(const ValueType *x, ValueType *y) const;
+
+  // Compute the rows [rowBegin, rowEnd) of y = A * x
+  void apply(const ValueType *x, ValueType *y, std::size_t rowBegin,
+             std::size_t rowEnd) const;
+
+  // Extract the main diagonal (zero where a row has no diagonal entry)
+  std::vector<ValueType> diagonal() const;
+
+  // Check whether two matrices share the same sparsity pattern
+  bool samePattern(const CsrMatrix &other) const;
+
+private:
+  std::size_t nRows_ = 0;
+  std::vector<IndexType> rowPtrs_{0};
+  std::vector<IndexType> colIdxs_;
+  std::vector<ValueType> values_;
+};
+
+// Prevent implicit instantiation of the template class for these types
+extern template class CsrMatrix<double, int>;
+
+#endif // CSR_MATRIX_HPP
@@ -0,0 +1,54 @@
+#ifndef DECOMPOSE_MESH_HPP
+#define DECOMPOSE_MESH_HPP
+
+#include "Decomposition.hpp"
+#include "Mesh.hpp"
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+enum class DecompositionMethod {
+  simple,             // Equal-count slabs in each direction independently
+  hierarchical,       // Slabs in one direction, then within each slab
+  recursiveBisection, // Recursive coordinate bisection of the longest extent
+  multilevel          // Multilevel graph bisection of the cell adjacency
+};
+
+// Split a mesh into subdomains following system/decomposeParDict
+class DecomposeMesh {
+public:
+  // Read numberOfSubdomains, method and the n/order coefficients. The graph
+  // methods scotch, metis and kahip are mapped to the native multilevel
+  // partitioner.
+  void readDecomposeParDict(Mesh &fvMesh);
+
+  std::size_t &nSubdomains() { return nSubdomains_; }
+  DecompositionMethod &method() { return method_; }
+
+  // Number of subdomains in x, y and z for simple and hierarchical
+  std::array<std::size_t, 3> &n() { return n_; }
+
+  // Direction order of hierarchical, e.g. "xyz"
+  std::string &order() { return order_; }
+
+  Decomposition decompose(Mesh &fvMesh);
+
+  // Decomposition of a given subdomain for each cell, e.g. the one stored in
+  // a decomposed case
+  Decomposition decompose(Mesh &fvMesh,
+                          std::vector<std::size_t> cellToSubdomain);
+
+private:
+  std::size_t nSubdomains_ = 1;
+  DecompositionMethod method_ = DecompositionMethod::multilevel;
+  std::array<std::size_t, 3> n_ = {1, 1, 1};
+  std::string order_ = "xyz";
+
+  std::vector<std::size_t> simpleSplit(Mesh &fvMesh);
+  std::vector<std::size_t> hierarchicalSplit(Mesh &fvMesh);
+  std::vector<std::size_t> recursiveBisection(Mesh &fvMesh);
+  std::vector<std::size_t> multilevelPartition(Mesh &fvMesh);
+};
+
+#endif // DECOMPOSE_MESH_HPP
@@ -0,0 +1,55 @@
+#ifndef DECOMPOSED_MESH_HPP
+#define DECOMPOSED_MESH_HPP
+
+#include "Decomposition.hpp"
+#include "Mesh.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// A case stored decomposed as processor0..N/constant/polyMesh. Every piece is
+// a complete local mesh whose processor patches are the interfaces to the
+// neighboring pieces. The addressing maps relate the local cells, faces and
+// nodes to the undecomposed mesh.
+class DecomposedMesh {
+public:
+  DecomposedMesh() = default;
+  DecomposedMesh(std::string caseDir) : caseDir_(caseDir) {}
+  std::string &caseDir() { return caseDir_; }
+  std::size_t nProcessors() const { return processorMeshes_.size(); }
+  std::vector<Mesh> &processorMeshes() { return processorMeshes_; }
+
+  // Global index of each local cell, face and node of every piece
+  std::vector<std::vector<std::size_t>> &cellAddressing() { return cellAddressing_; }
+  std::vector<std::vector<std::size_t>> &faceAddressing() { return faceAddressing_; }
+  std::vector<std::vector<std::size_t>> &nodeAddressing() { return nodeAddressing_; }
+
+  // Whether a local face is the reverse of its global face, which is the case
+  // on the neighbor side of the processor patches
+  std::vector<std::vector<bool>> &faceFlipped() { return faceFlipped_; }
+
+  // Processor patches of every piece as local faces, sorted by neighbor
+  std::vector<std::vector<Interface>> &interfaces() { return interfaces_; }
+
+  // Piece holding each global cell
+  std::vector<std::size_t> &cellToProcessor() { return cellToProcessor_; }
+
+  std::size_t &nGlobalCells() { return nGlobalCells_; }
+  std::size_t &nGlobalFaces() { return nGlobalFaces_; }
+  std::size_t &nGlobalNodes() { return nGlobalNodes_; }
+
+private:
+  std::string caseDir_ = "";
+  std::vector<Mesh> processorMeshes_;
+  std::vector<std::vector<std::size_t>> cellAddressing_;
+  std::vector<std::vector<std::size_t>> faceAddressing_;
+  std::vector<std::vector<std::size_t>> nodeAddressing_;
+  std::vector<std::vector<bool>> faceFlipped_;
+  std::vector<std::vector<Interface>> interfaces_;
+  std::vector<std::size_t> cellToProcessor_;
+  std::size_t nGlobalCells_ = 0;
+  std::size_t nGlobalFaces_ = 0;
+  std::size_t nGlobalNodes_ = 0;
+};
+
+#endif // DECOMPOSED_MESH_HPP
@@ -0,0 +1,55 @@
+#ifndef DECOMPOSITION_HPP
+#define DECOMPOSITION_HPP
+
+#include <cstddef>
+#include <vector>
+
+// Faces shared with one neighboring subdomain, listed in the same order on
+// both sides
+struct Interface {
+  std::size_t neighbor = 0;
+  std::vector<std::size_t> faces;
+};
+
+class Subdomain {
+public:
+  // Global indices of the cells, in ascending order. The position of a cell
+  // in this list is its local index.
+  std::vector<std::size_t> &cells() { return cells_; }
+
+  // Interfaces to the neighboring subdomains, sorted by neighbor, with the
+  // faces in ascending global order
+  std::vector<Interface> &interfaces() { return interfaces_; }
+
+  std::size_t nCells() const { return cells_.size(); }
+
+private:
+  std::vector<std::size_t> cells_;
+  std::vector<Interface> interfaces_;
+};
+
+// Split of the mesh cells into subdomains
+class Decomposition {
+public:
+  std::size_t nSubdomains() const { return subdomains_.size(); }
+  std::vector<Subdomain> &subdomains() { return subdomains_; }
+
+  // Subdomain and local index of each global cell
+  std::vector<std::size_t> &cellToSubdomain() { return cellToSubdomain_; }
+  std::vector<std::size_t> &localIndex() { return localIndex_; }
+
+  // Number of interior faces between different subdomains
+  std::size_t &edgeCut() { return edgeCut_; }
+
+  // Largest subdomain size relative to the mean size (1 is perfect balance)
+  double &imbalance() { return imbalance_; }
+
+private:
+  std::vector<Subdomain> subdomains_;
+  std::vector<std::size_t> cellToSubdomain_;
+  std::vector<std::size_t> localIndex_;
+  std::size_t edgeCut_ = 0;
+  double imbalance_ = 1.0;
+};
+
+#endif // DECOMPOSITION_HPP
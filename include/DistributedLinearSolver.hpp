@@ -0,0 +1,73 @@
+#ifndef DISTRIBUTED_LINEAR_SOLVER_HPP
+#define DISTRIBUTED_LINEAR_SOLVER_HPP
+
+#include <ginkgo/ginkgo.hpp> // Required for Ginkgo library
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if GINKGO_BUILD_MPI
+
+// CG on Ginkgo's distributed matrices with a Schwarz preconditioner that
+// applies block Jacobi to the diagonal block of each rank. Every rank passes
+// the rows of the cells it owns in global indices.
+class DistributedLinearSolver {
+public:
+  DistributedLinearSolver(gko::experimental::mpi::communicator comm)
+      : comm_(comm) {}
+
+  // Largest block size of the block Jacobi solver within each subdomain
+  std::uint32_t &maxBlockSize() { return maxBlockSize_; }
+
+  // Iterations of the last solve
+  std::size_t nIterations() const { return nIterations_; }
+
+  // cellToRank is the owning rank of every global cell. RHS and solVector
+  // hold the owned cells of this rank in ascending global order.
+  template <typename ValueType, typename GlobalIndexType>
+  void solve(const gko::matrix_data<ValueType, GlobalIndexType> &ownedRows,
+             const std::vector<std::size_t> &cellToRank,
+             std::vector<ValueType> &RHS, std::vector<ValueType> &solVector,
+             gko::remove_complex<ValueType> reductionFactor,
+             std::size_t maxNumIterations);
+
+  // The same when the owned cells of every rank are a contiguous range of
+  // global indices and the ranges follow the rank order, so that no rank
+  // needs the owner of every global cell
+  template <typename ValueType, typename GlobalIndexType>
+  void solve(const gko::matrix_data<ValueType, GlobalIndexType> &ownedRows,
+             std::vector<ValueType> &RHS, std::vector<ValueType> &solVector,
+             gko::remove_complex<ValueType> reductionFactor,
+             std::size_t maxNumIterations);
+
+private:
+  template <typename ValueType, typename GlobalIndexType>
+  void solveOnPartition(
+      std::shared_ptr<gko::experimental::distributed::Partition<
+          int, GlobalIndexType>>
+          partition,
+      const gko::matrix_data<ValueType, GlobalIndexType> &ownedRows,
+      std::vector<ValueType> &RHS, std::vector<ValueType> &solVector,
+      gko::remove_complex<ValueType> reductionFactor,
+      std::size_t maxNumIterations);
+
+  gko::experimental::mpi::communicator comm_;
+  std::uint32_t maxBlockSize_ = 8;
+  std::size_t nIterations_ = 0;
+};
+
+// Prevent implicit instantiation of the template function for these types
+extern template void DistributedLinearSolver::solve(
+    const gko::matrix_data<double, std::int64_t> &ownedRows,
+    const std::vector<std::size_t> &cellToRank, std::vector<double> &RHS,
+    std::vector<double> &solVector, gko::remove_complex<double> reductionFactor,
+    std::size_t maxNumIterations);
+extern template void DistributedLinearSolver::solve(
+    const gko::matrix_data<double, std::int64_t> &ownedRows,
+    std::vector<double> &RHS, std::vector<double> &solVector,
+    gko::remove_complex<double> reductionFactor, std::size_t maxNumIterations);
+
+#endif // GINKGO_BUILD_MPI
+
+#endif // DISTRIBUTED_LINEAR_SOLVER_HPP
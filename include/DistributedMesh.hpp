@@ -0,0 +1,132 @@
+#ifndef DISTRIBUTED_MESH_HPP
+#define DISTRIBUTED_MESH_HPP
+
+#include "Decomposition.hpp"
+#include "Mesh.hpp"
+#include "ProcessMesh.hpp"
+#include "ReadMesh.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Numbering of the local cells of a subdomain
+enum class LocalCellOrdering {
+  ascendingGlobal, // Ascending global index, owned and halo cells mixed
+  interiorFirst    // Owned cells without halo neighbors, then the owned cells
+                   // next to an interface, then the halo cells
+};
+
+// Cells exchanged with one neighboring subdomain, in ascending global order
+// so that the send list of one side matches the receive list of the other
+struct HaloExchange {
+  std::size_t neighbor = 0;
+  std::vector<std::size_t> sendCells;
+  std::vector<std::size_t> receiveCells;
+};
+
+// The cells next to the faces of a processor patch: their global indices and
+// centroids, in the face order of the patch. One side sends them and the
+// other side builds its halo cells from them.
+struct ProcessorPatchCells {
+  std::vector<std::size_t> globalCells;
+  std::vector<std::array<double, 3>> centroids;
+};
+
+// The part of a decomposed mesh held by one subdomain: its own cells plus one
+// layer of halo cells from the neighboring subdomains. Faces keep their global
+// orientation, so the geometry of the global mesh is reused without flipping
+// faces; with ascending global numbering owner < neighbor is preserved as
+// well. The local mesh contains the faces of the owned cells only, so the
+// rows of the halo cells are incomplete and are dropped after assembly.
+class DistributedMesh {
+public:
+  DistributedMesh(Mesh &globalMesh, Decomposition &decomposition,
+                  std::size_t iSubdomain,
+                  LocalCellOrdering ordering = LocalCellOrdering::ascendingGlobal);
+
+  // A processed local mesh that the subdomain built itself, e.g. generated
+  // slab by slab, without a global mesh on any rank. It holds the owned cells
+  // and one layer of halo cells; globalCells and cellSubdomains give the
+  // global index and the subdomain of each local cell. Faces between halo
+  // cells may be present, they only touch the dropped halo rows.
+  DistributedMesh(Mesh &&localMesh, std::vector<std::size_t> globalCells,
+                  const std::vector<std::size_t> &cellSubdomains,
+                  std::size_t iSubdomain, std::size_t nGlobalCells);
+
+  // A piece of a case stored decomposed, read from its own processor
+  // directory. Its cells are numbered firstGlobalCell onwards, and
+  // patchCells holds, for each processor patch, the cells that the
+  // neighboring processor sent for it (empty for the other patches). The
+  // processor patch faces become interior faces to the halo cells and the
+  // processor patches are removed.
+  DistributedMesh(Mesh &&piece, std::size_t firstGlobalCell,
+                  const std::vector<ProcessorPatchCells> &patchCells,
+                  std::size_t iSubdomain, std::size_t nGlobalCells);
+
+  // What a piece sends for one of its processor patches
+  static ProcessorPatchCells processorPatchCells(Mesh &piece,
+                                                 std::size_t iBoundary,
+                                                 std::size_t firstGlobalCell);
+
+  Mesh &localMesh() { return localMesh_; }
+
+  // Global index of each local cell
+  std::vector<std::size_t> &globalCells() { return globalCells_; }
+
+  // Local indices of the owned cells in ascending global order (the rest are
+  // halo cells)
+  std::vector<std::size_t> &ownedCells() { return ownedCells_; }
+
+  // Owned cells whose rows need no halo values. With interiorFirst they are
+  // the local cells [0, nInteriorCells) and the interface cells follow up to
+  // nOwnedCells, so a product can run on the interior rows while the halo
+  // exchange is in flight.
+  std::size_t nInteriorCells() const { return nInteriorCells_; }
+  std::size_t nOwnedCells() const { return ownedCells_.size(); }
+
+  // Local cells to send to and receive from each neighboring subdomain,
+  // sorted by neighbor
+  std::vector<HaloExchange> &haloExchanges() { return haloExchanges_; }
+
+  // Global index of each local face (empty when the subdomain built its
+  // local mesh itself)
+  std::vector<std::size_t> &globalFaces() { return globalFaces_; }
+
+  std::size_t nGlobalCells() const { return nGlobalCells_; }
+
+  // Rows of the owned cells of a locally assembled matrix in global indices
+  template <typename IndexType>
+  gko::matrix_data<double, IndexType>
+  ownedRows(const gko::matrix_data<double, int> &localMatrix) const;
+
+  // Values of the owned cells, in the order of ownedCells
+  std::vector<double> ownedValues(const std::vector<double> &localValues) const;
+
+private:
+  // Owned cells, interior cells and halo exchange lists of a local mesh with
+  // connectivity, given the subdomain of each local cell
+  void findOwnership(const std::vector<std::size_t> &cellSubdomains,
+                     std::size_t iSubdomain);
+
+  Mesh localMesh_;
+  std::vector<std::size_t> globalCells_;
+  std::vector<std::size_t> ownedCells_;
+  std::vector<std::size_t> globalFaces_;
+  std::vector<bool> isOwned_;
+  std::vector<HaloExchange> haloExchanges_;
+  std::size_t nInteriorCells_ = 0;
+  std::size_t nGlobalCells_ = 0;
+  ReadMesh MeshReader;
+  ProcessMesh MeshProcessor;
+};
+
+// Prevent implicit instantiation of the template function for these types
+extern template gko::matrix_data<double, int> DistributedMesh::ownedRows(
+    const gko::matrix_data<double, int> &localMatrix) const;
+extern template gko::matrix_data<double, std::int64_t>
+DistributedMesh::ownedRows(
+    const gko::matrix_data<double, int> &localMatrix) const;
+
+#endif // DISTRIBUTED_MESH_HPP
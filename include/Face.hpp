@@ -27,13 +27,16 @@ public:
   std::size_t &iNeighborOwnerCoef() { return iNeighborOwnerCoef_; }
   int &patchIndex() { return patchIndex_; }
 
+  // Volume swept by the face in the last mesh motion, positive along Sf
+  double &sweptVolume() { return sweptVolume_; }
+
 private:
   std::size_t nNodes_ = 0;
   std::vector<std::size_t> iNodes_;
   std::size_t index_ = 0;
   int iOwner_ = -1;
   int iNeighbor_ = -1;
-  double deltaVol = 0.0;
+  double sweptVolume_ = 0.0;
   std::array<double, 3> centroid_ = {0.0, 0.0, 0.0};
   std::array<double, 3> Sf_ = {0.0, 0.0, 0.0};
   double area_ = 0.0;
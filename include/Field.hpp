@@ -1,7 +1,9 @@
 #ifndef FIELD_HPP
 #define FIELD_HPP
 
+#include "BoundaryCondition.hpp"
 #include <array>
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -9,16 +11,52 @@ template <typename ValueType> class Field {
 
 public:
   Field() = default;
-  Field(std::size_t nElements) : values_(nElements) {}
+  Field(std::size_t nElements) : size_(nElements) {}
 
-  std::vector<ValueType> &values() { return values_; }
-  const std::size_t size() { return values_.size(); }
+  // A field is either uniform, storing a single value, or stores one value
+  // per element. A uniform field is expanded when values() is first used, so
+  // read-only kernels should use isUniform() and value() instead.
+  std::vector<ValueType> &values() {
+    expand();
+    return values_;
+  }
+  std::size_t size() const { return uniform_ ? size_ : values_.size(); }
+  void resize(std::size_t nElements) {
+    if (uniform_) {
+      size_ = nElements;
+    } else {
+      values_.resize(nElements);
+    }
+  }
 
-  // Set all the values of a field to a given value
-  void set(const ValueType &value) { values_.assign(values_.size(), value); }
+  // Set all the values of a field to a given value, which is stored once
+  void set(const ValueType &value) {
+    size_ = size();
+    uniform_ = true;
+    uniformValue_ = value;
+    std::vector<ValueType>().swap(values_);
+  }
+
+  bool isUniform() const { return uniform_; }
+  const ValueType &uniformValue() const { return uniformValue_; }
+
+  // Value of an element without expanding a uniform field
+  const ValueType &value(std::size_t i) const {
+    return uniform_ ? uniformValue_ : values_[i];
+  }
 
 protected:
+  void expand() {
+    if (uniform_) {
+      values_.assign(size_, uniformValue_);
+      uniform_ = false;
+    }
+  }
+
   std::vector<ValueType> values_;
+  std::size_t size_ = 0;
+  bool uniform_ = true;
+  ValueType uniformValue_{};
 };
 
 template <typename ValueType> class boundaryField : public Field<ValueType> {
@@ -26,10 +64,26 @@ public:
   boundaryField() = default;
   boundaryField(std::size_t nFaces) : Field<ValueType>(nFaces) {}
 
-  std::string &boundaryType() { return boundaryType_; }
+  // Set the type name of the file and resolve it to the condition type
+  void setBoundaryType(const std::string &boundaryType) {
+    conditionType_ = toBoundaryConditionType(boundaryType);
+    boundaryType_ = boundaryType;
+  }
+  const std::string &boundaryType() const { return boundaryType_; }
+  BoundaryConditionType conditionType() const { return conditionType_; }
+
+  // Normal gradient of a fixedGradient condition (refGradient of a mixed
+  // condition), per face; the values hold the value or refValue
+  std::vector<ValueType> &gradient() { return gradient_; }
+
+  // Weight of the value against the gradient of a mixed condition, per face
+  std::vector<double> &valueFraction() { return valueFraction_; }
 
 private:
   std::string boundaryType_{""};
+  BoundaryConditionType conditionType_ = BoundaryConditionType::empty;
+  std::vector<ValueType> gradient_;
+  std::vector<double> valueFraction_;
 };
 
 #endif // FIELD_HPP
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef FOAM_TOKENIZER_HPP
+#define FOAM_TOKENIZER_HPP
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// A token of an OpenFOAM file
+struct FoamToken {
+  enum class Kind { word, number, string, punctuation, end };
+
+  Kind kind = Kind::end;
+  std::string text;
+  double number = 0.0;
+
+  bool is(char c) const {
+    return kind == Kind::punctuation && text.front() == c;
+  }
+  bool is(const std::string &word) const {
+    return kind == Kind::word && text == word;
+  }
+};
+
+// Split an OpenFOAM file into a stream of tokens. The file is read with a
+// single read, decompressed if it is gzip compressed (<fileName>.gz), and
+// parsed once from memory; comments are skipped and #include directives are
+// followed relative to the including file. Lists of values are decoded
+// directly from the buffer, as text with std::from_chars or as binary data.
+class FoamTokenizer {
+public:
+  explicit FoamTokenizer(const std::string &fileName);
+  // Split text that was read from fileName, e.g. a part of it, with lists in
+  // binary format if given
+  FoamTokenizer(const std::string &fileName, std::string text,
+                bool binary = false);
+
+  FoamToken next();
+  const FoamToken &peek();
+  bool atEnd() { return peek().kind == FoamToken::Kind::end; }
+
+  // Take the next token, which has to be the given punctuation or a word
+  void expect(char c);
+  std::string word();
+
+  // Read the FoamFile header, if present, for the format of the file
+  void readHeader();
+  bool binary() const { return binary_; }
+
+  // Skip an entry up to its semicolon, or a dictionary up to its brace
+  void skipEntry();
+
+  // Read the entries up to the end of the file, flattened to "block.key" ->
+  // the texts of their tokens without the parentheses around lists
+  std::map<std::string, std::vector<std::string>> readDictionary();
+
+  // Read a scalar or a parenthesized vector or tensor
+  template <typename ValueType> ValueType readValue();
+
+  // Read a list "n(v0 v1 ...)" or "n{v}", e.g. after the "nonuniform
+  // List<scalar>" of a field entry
+  template <typename ValueType> void readList(std::vector<ValueType> &values);
+
+  // Offset in the file after the last token taken, for copying parts of the
+  // file. It is not available within an included file.
+  std::size_t position() const;
+
+  // Throw an error that points to the current line of the file
+  [[noreturn]] void fail(const std::string &message) const;
+
+private:
+  struct Source {
+    std::string fileName;
+    std::string buffer;
+    std::size_t pos = 0;
+  };
+
+  FoamToken lex();
+  void skipSpace();
+  void include(const std::string &fileName);
+
+  // The file and the files it includes, innermost last
+  std::vector<Source> sources_;
+  FoamToken peeked_;
+  bool hasPeeked_ = false;
+  bool binary_ = false;
+};
+
+// Prevent implicit instantiation of the template functions for these types
+extern template double FoamTokenizer::readValue();
+extern template std::array<double, 3> FoamTokenizer::readValue();
+extern template std::array<double, 9> FoamTokenizer::readValue();
+extern template void FoamTokenizer::readList(std::vector<double> &values);
+extern template void
+FoamTokenizer::readList(std::vector<std::array<double, 3>> &values);
+extern template void
+FoamTokenizer::readList(std::vector<std::array<double, 9>> &values);
+
+#endif // FOAM_TOKENIZER_HPP
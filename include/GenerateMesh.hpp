@@ -0,0 +1,34 @@
+#ifndef GENERATE_MESH_HPP
+#define GENERATE_MESH_HPP
+
+#include "Mesh.hpp"
+#include "ProcessMesh.hpp"
+#include "ReadMesh.hpp"
+#include <array>
+#include <cstddef>
+
+// Generate meshes in memory, e.g. large synthetic meshes for benchmarks
+class GenerateMesh {
+public:
+  // Box [0, lx] x [0, ly] x [0, lz] split into nx * ny * nz hexahedra,
+  // numbered with x fastest. Faces follow the OpenFOAM ordering, and the
+  // boundary patches are left, right, bottom, top, back and front (minimum
+  // and maximum x, y and z).
+  void cartesianBox(Mesh &fvMesh, const std::array<std::size_t, 3> &nCells,
+                    const std::array<double, 3> &lengths);
+
+  // Only the cell layers [kBegin, kEnd) in z of the same box, e.g. the slab
+  // of one rank plus its halo layers. Cells and nodes are numbered locally
+  // from the layer kBegin, so local cell c is global cell c + nx * ny * kBegin.
+  // The back and front patches close the slab at kBegin and kEnd.
+  void cartesianBoxLayers(Mesh &fvMesh,
+                          const std::array<std::size_t, 3> &nCells,
+                          const std::array<double, 3> &lengths,
+                          std::size_t kBegin, std::size_t kEnd);
+
+private:
+  ReadMesh MeshReader;
+  ProcessMesh MeshProcessor;
+};
+
+#endif // GENERATE_MESH_HPP
@@ -0,0 +1,36 @@
+#ifndef GRAPH_HPP
+#define GRAPH_HPP
+
+#include "CsrMatrix.hpp"
+#include "Mesh.hpp"
+#include <cstddef>
+#include <vector>
+
+// Undirected adjacency graph in compressed form without self loops. The cell
+// graph of a mesh and the sparsity graph of its FVM matrices coincide.
+class Graph
+{
+public:
+  Graph() = default;
+
+  // Cells are adjacent if they share an interior face
+  Graph(Mesh &fvMesh);
+
+  // Rows are adjacent if the matrix couples them
+  template <typename ValueType, typename IndexType>
+  Graph(const CsrMatrix<ValueType, IndexType> &matrix);
+
+  std::size_t nVertices() const { return adjPtrs_.size() - 1; }
+  std::size_t degree(std::size_t v) const { return adjPtrs_[v + 1] - adjPtrs_[v]; }
+  const std::vector<std::size_t> &adjPtrs() const { return adjPtrs_; }
+  const std::vector<std::size_t> &adjacency() const { return adjacency_; }
+
+private:
+  std::vector<std::size_t> adjPtrs_{0};
+  std::vector<std::size_t> adjacency_;
+};
+
+// Prevent implicit instantiation of the template function for these types
+extern template Graph::Graph(const CsrMatrix<double, int> &matrix);
+
+#endif // GRAPH_HPP
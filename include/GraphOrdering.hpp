@@ -0,0 +1,48 @@
+#ifndef GRAPH_ORDERING_HPP
+#define GRAPH_ORDERING_HPP
+
+#include "Graph.hpp"
+#include <cstddef>
+#include <vector>
+
+// Vertex orderings of a graph. An ordering is returned as a permutation
+// perm with perm[newIndex] = oldIndex.
+class GraphOrdering
+{
+public:
+  // Fill-reducing nested dissection ordering. Each subgraph is split by the
+  // middle level of a breadth-first level structure rooted at a
+  // pseudo-peripheral vertex, and separators are numbered after both halves.
+  // Subgraphs with at most leafSize vertices are kept in their input order.
+  static std::vector<std::size_t> nestedDissection(const Graph &graph,
+                                                   std::size_t leafSize = 64);
+
+  // Reverse Cuthill-McKee bandwidth-reducing ordering. Each connected
+  // component is traversed breadth-first from a pseudo-peripheral vertex,
+  // visiting neighbors by increasing degree, and the result is reversed.
+  static std::vector<std::size_t> reverseCuthillMcKee(const Graph &graph);
+
+  // Largest index distance |i - j| between adjacent vertices after applying
+  // perm (the input numbering if perm is empty)
+  static std::size_t bandwidth(const Graph &graph,
+                               const std::vector<std::size_t> &perm = {});
+
+  // Invert a permutation
+  static std::vector<std::size_t>
+  inverse(const std::vector<std::size_t> &perm);
+
+  // Breadth-first level structure of the vertices v with region[v] == id that
+  // are reachable from root. Returns the level pointers into vertices.
+  static std::vector<std::size_t>
+  levelStructure(const Graph &graph, std::size_t root,
+                 const std::vector<std::size_t> &region, std::size_t id,
+                 std::vector<std::size_t> &vertices);
+
+  // Vertex of (nearly) maximal eccentricity in the region of start
+  static std::size_t
+  pseudoPeripheralVertex(const Graph &graph, std::size_t start,
+                         const std::vector<std::size_t> &region,
+                         std::size_t id);
+};
+
+#endif // GRAPH_ORDERING_HPP
@@ -12,18 +12,22 @@ public:
 
   static void ifFileOpened(const std::ifstream &file,
                            const std::string &fileName);
-  static void discardLines(std::ifstream &file, std::size_t nLines = 1);
+  static void discardLines(std::istream &file, std::size_t nLines = 1);
   template <typename ValueType>
 
   // Print out the elements of a vector
   static void printVector(const std::vector<ValueType> &vec);
 
-  // Function to write the solution vector to a file in OpenFOAM format
+  // Function to write the solution vector to a file in OpenFOAM format.
+  // A renumbered solution is written in the numbering of the mesh files when
+  // the cellOrdering of the mesh is given. Time loops should keep a
+  // WriteField instead, which reads the settings and boundaryField once.
   template <typename ValueType>
   static void writeResultToFile(const std::vector<ValueType> &solution,
                                 const std::string &caseDirectory,
                                 const std::string &timePoint,
-                                const std::string &solutionFileName);
+                                const std::string &solutionFileName,
+                                const std::vector<std::size_t> &cellOrdering = {});
 
   // Function to create a .foam file for visualization of results in
   // ParaView
@@ -0,0 +1,46 @@
+#ifndef INCOMPLETE_FACTORIZATION_HPP
+#define INCOMPLETE_FACTORIZATION_HPP
+
+#include "CsrMatrix.hpp"
+#include "LevelSchedule.hpp"
+#include <memory>
+
+// Zero fill-in incomplete factorizations
+enum class FactorizationType
+{
+  ilu0, // A ~ L * U with unit lower triangular L
+  ic0   // A ~ L * L^T for symmetric positive definite A
+};
+
+// Incomplete factorization preconditioner whose factorization and triangular
+// solves are parallelized over the level sets of the matrix pattern
+template <typename ValueType, typename IndexType>
+class IncompleteFactorization
+{
+public:
+  IncompleteFactorization(const CsrMatrix<ValueType, IndexType> &matrix,
+                          std::shared_ptr<const LevelSchedule> schedule,
+                          FactorizationType type);
+
+  // Compute z = (L * U)^{-1} * r; z must not alias r
+  void apply(const ValueType *r, ValueType *z) const;
+
+  // Lower factor with the diagonal stored as the last entry of each row
+  const CsrMatrix<ValueType, IndexType> &lower() const { return lower_; }
+
+  // Upper factor with the diagonal stored as the first entry of each row
+  const CsrMatrix<ValueType, IndexType> &upper() const { return upper_; }
+
+private:
+  void factorizeIlu0(const CsrMatrix<ValueType, IndexType> &matrix);
+  void factorizeIc0(const CsrMatrix<ValueType, IndexType> &matrix);
+
+  std::shared_ptr<const LevelSchedule> schedule_;
+  CsrMatrix<ValueType, IndexType> lower_;
+  CsrMatrix<ValueType, IndexType> upper_;
+};
+
+// Prevent implicit instantiation of the template class for these types
+extern template class IncompleteFactorization<double, int>;
+
+#endif // INCOMPLETE_FACTORIZATION_HPP
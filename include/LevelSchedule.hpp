@@ -0,0 +1,47 @@
+#ifndef LEVEL_SCHEDULE_HPP
+#define LEVEL_SCHEDULE_HPP
+
+#include "CsrMatrix.hpp"
+#include <cstddef>
+#include <vector>
+
+// Level sets of the lower triangle of a sparsity pattern. All rows of one
+// level only depend on rows of earlier levels, so they can be processed
+// concurrently in a triangular solve or an incomplete factorization. For a
+// structurally symmetric pattern, traversing the levels in reverse order is a
+// valid schedule for the upper triangle as well.
+class LevelSchedule
+{
+public:
+  LevelSchedule() = default;
+
+  template <typename ValueType, typename IndexType>
+  LevelSchedule(const CsrMatrix<ValueType, IndexType> &matrix);
+
+  std::size_t nRows() const { return rows_.size(); }
+  std::size_t nLevels() const { return levelPtrs_.size() - 1; }
+
+  // Rows of level l are rows()[levelPtrs()[l]] ... rows()[levelPtrs()[l+1]-1]
+  const std::vector<std::size_t> &levelPtrs() const { return levelPtrs_; }
+  const std::vector<std::size_t> &rows() const { return rows_; }
+
+  // Check whether the schedule was built for the sparsity pattern of a matrix
+  template <typename ValueType, typename IndexType>
+  bool matches(const CsrMatrix<ValueType, IndexType> &matrix) const;
+
+private:
+  std::vector<std::size_t> levelPtrs_{0};
+  std::vector<std::size_t> rows_;
+
+  // Sparsity pattern the schedule was computed for
+  std::vector<std::size_t> patternRowPtrs_;
+  std::vector<std::size_t> patternColIdxs_;
+};
+
+// Prevent implicit instantiation of the template functions for these types
+extern template LevelSchedule::LevelSchedule(
+    const CsrMatrix<double, int> &matrix);
+extern template bool LevelSchedule::matches(
+    const CsrMatrix<double, int> &matrix) const;
+
+#endif // LEVEL_SCHEDULE_HPP
@@ -1,11 +1,49 @@
 #ifndef LINEAR_SOLVER_HPP
 #define LINEAR_SOLVER_HPP
 
+#include "ChebyshevPreconditioner.hpp"
+#include "CsrMatrix.hpp"
+#include "LevelSchedule.hpp"
+#include "RecycledCg.hpp"
+#include "SparseCholesky.hpp"
 #include <ginkgo/ginkgo.hpp> // Required for Ginkgo library
+#include <functional>
+#include <memory>
 #include <vector>
 
+// Solution methods
+enum class SolverType {
+  cg,      // Preconditioned conjugate gradients
+  cholesky // Sparse direct Cholesky for small and medium meshes
+};
+
+// Preconditioners available for the CG solver
+enum class PreconditionerType {
+  blockJacobi, // Ginkgo's block Jacobi preconditioner
+  ilu0,        // Level-scheduled ILU(0)
+  ic0,         // Level-scheduled IC(0)
+  chebyshev    // Chebyshev polynomial in the Jacobi scaled matrix
+};
+
 class LinearSolver {
 public:
+  LinearSolver() = default;
+  LinearSolver(PreconditionerType preconditioner)
+      : preconditioner_(preconditioner) {}
+
+  SolverType &solverType() { return solverType_; }
+  PreconditionerType &preconditioner() { return preconditioner_; }
+
+  // Number of terms of the Chebyshev polynomial (degree - 1 SpMVs per apply)
+  std::size_t &chebyshevDegree() { return chebyshevDegree_; }
+
+  // How the spectral interval of the Chebyshev polynomial is estimated
+  SpectralEstimate &spectralEstimate() { return spectralEstimate_; }
+
+  // Number of approximate low eigenvectors recycled between consecutive
+  // solves by a deflated CG. The default 0 uses Ginkgo's CG without recycling.
+  std::size_t &recycleDimension() { return recycleDimension_; }
+
   // Solve the linear system of equations
   template <typename ValueType, typename IndexType>
   void solve(gko::matrix_data<ValueType, IndexType> &coeffMatrix,
@@ -14,7 +52,26 @@ public:
              IndexType maxNumIterations);
 
 private:
-  // Add any private member variables or helper functions if needed
+  // Build the selected preconditioner as a plain function z = M^{-1} r
+  template <typename ValueType, typename IndexType>
+  std::function<void(const ValueType *, ValueType *)> makeNativePreconditioner(
+      std::shared_ptr<const CsrMatrix<ValueType, IndexType>> csrMatrix);
+
+  SolverType solverType_ = SolverType::cg;
+  PreconditionerType preconditioner_ = PreconditionerType::blockJacobi;
+  std::size_t chebyshevDegree_ = 3;
+  SpectralEstimate spectralEstimate_ = SpectralEstimate::lanczos;
+  std::size_t recycleDimension_ = 0;
+
+  // Level sets of the last factorized matrix. They only depend on the mesh
+  // connectivity and are reused as long as the sparsity pattern is unchanged.
+  std::shared_ptr<const LevelSchedule> levelSchedule_;
+
+  // Deflated CG holding the recycle space between solves
+  RecycledCg<double, int> recycledCg_;
+
+  // Direct solver keeping its symbolic analysis between solves
+  SparseCholesky<double, int> cholesky_;
 };
 
 // Prevent implicit instantiation of the template function for these types
@@ -24,4 +81,4 @@ LinearSolver::solve(gko::matrix_data<double, int> &coeffMatrix,
                     gko::remove_complex<double> reduction_factor,
                     int maxNumIterations);
 
-#endif // LINEAR_SOLVER_HPP
\ No newline at end of file
+#endif // LINEAR_SOLVER_HPP
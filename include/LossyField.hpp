@@ -0,0 +1,108 @@
+#ifndef LOSSY_FIELD_HPP
+#define LOSSY_FIELD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Lossy snapshots of the fields of a transient run, written to
+// <caseDirectory>/<timePoint>/<fieldName>.lossy. Every value is stored
+// within an absolute error bound: it is predicted, the residual is quantized
+// to a multiple of twice the bound, and the quantized residuals are entropy
+// coded with zlib. Keyframes predict each value from the previous cell, the
+// other snapshots from the previous snapshot and the previous cell together.
+// Predictions use the reconstructed values, as the decoder sees them, so the
+// errors do not add up over the snapshots. Values that cannot be quantized,
+// e.g. NaN, are stored exactly. A time written again is written as a
+// keyframe; the snapshots that referenced its old values no longer decode.
+class WriteLossyField {
+public:
+  // A keyframe is written every keyframeInterval snapshots of a field
+  WriteLossyField(const std::string &caseDirectory, double errorBound,
+                  std::size_t keyframeInterval = 20);
+
+  // Write a snapshot of a scalar or vector field. A renumbered field is
+  // written in the numbering of the mesh files when the cellOrdering of the
+  // mesh is given.
+  template <typename ValueType>
+  void write(const std::vector<ValueType> &values, const std::string &timePoint,
+             const std::string &fieldName,
+             const std::vector<std::size_t> &cellOrdering = {});
+
+  double errorBound() const { return errorBound_; }
+
+  // Size of the last written file, e.g. for compression ratios
+  std::size_t bytesWritten() const { return bytesWritten_; }
+
+private:
+  // The last snapshot of a field, as the decoder reconstructs it, and the
+  // times written so far
+  struct Reference {
+    std::string timePoint;
+    std::vector<double> values;
+    std::uint32_t checksum = 0;
+    std::size_t nSinceKeyframe = 0;
+    std::set<std::string> timePoints;
+  };
+
+  std::string caseDirectory_;
+  double errorBound_;
+  std::size_t keyframeInterval_;
+  std::size_t bytesWritten_ = 0;
+  std::map<std::string, Reference> references_;
+};
+
+// Reconstruct any snapshot written by WriteLossyField, from the keyframe
+// before it. The last reconstruction is kept, so reading the snapshots in
+// order decodes each file once. The values are in the numbering of the mesh
+// files.
+class ReadLossyField {
+public:
+  explicit ReadLossyField(const std::string &caseDirectory);
+
+  template <typename ValueType>
+  std::vector<ValueType> read(const std::string &timePoint,
+                              const std::string &fieldName);
+
+private:
+  // The last reconstructed snapshot of a field
+  struct Snapshot {
+    std::string timePoint;
+    std::size_t nComponents = 0;
+    std::vector<double> values;
+  };
+
+  // Decode a snapshot after its reference; chain holds the times being
+  // decoded, to detect references in a cycle
+  const std::vector<double> &decode(const std::string &timePoint,
+                                    const std::string &fieldName,
+                                    std::size_t nComponents,
+                                    std::vector<std::string> &chain);
+
+  std::string caseDirectory_;
+  std::map<std::string, Snapshot> last_;
+};
+
+// Prevent implicit instantiation of the template functions for these types
+extern template void
+WriteLossyField::write(const std::vector<double> &values,
+                       const std::string &timePoint,
+                       const std::string &fieldName,
+                       const std::vector<std::size_t> &cellOrdering);
+extern template void
+WriteLossyField::write(const std::vector<std::array<double, 3>> &values,
+                       const std::string &timePoint,
+                       const std::string &fieldName,
+                       const std::vector<std::size_t> &cellOrdering);
+extern template std::vector<double>
+ReadLossyField::read(const std::string &timePoint,
+                     const std::string &fieldName);
+extern template std::vector<std::array<double, 3>>
+ReadLossyField::read(const std::string &timePoint,
+                     const std::string &fieldName);
+
+#endif // LOSSY_FIELD_HPP
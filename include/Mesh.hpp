@@ -27,6 +27,16 @@ public:
   std::size_t &nBCells() { return nBCells_; }
   std::size_t &nBFaces() { return nBFaces_; }
 
+  // Original index of each cell, face and node after renumbering (empty if
+  // the numbering of the mesh files is kept)
+  std::vector<std::size_t> &cellOrdering() { return cellOrdering_; }
+  std::vector<std::size_t> &faceOrdering() { return faceOrdering_; }
+  std::vector<std::size_t> &nodeOrdering() { return nodeOrdering_; }
+
+  // Faces and cells whose geometry changed in the last mesh motion
+  std::vector<std::size_t> &movedFaces() { return movedFaces_; }
+  std::vector<std::size_t> &movedCells() { return movedCells_; }
+
 private:
   std::string caseDir_ = "";
   std::size_t nNodes_ = 0;
@@ -42,5 +52,10 @@ private:
   std::vector<Cell> cells_;
   std::size_t nBCells_ = 0;
   std::size_t nBFaces_ = 0;
+  std::vector<std::size_t> cellOrdering_;
+  std::vector<std::size_t> faceOrdering_;
+  std::vector<std::size_t> nodeOrdering_;
+  std::vector<std::size_t> movedFaces_;
+  std::vector<std::size_t> movedCells_;
 };
 #endif
\ No newline at end of file
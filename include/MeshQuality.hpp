@@ -0,0 +1,46 @@
+#ifndef MESH_QUALITY_HPP
+#define MESH_QUALITY_HPP
+
+#include "Mesh.hpp"
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Distribution of one quality measure over the faces or cells of a mesh. Bin
+// i counts the values in [binEdges[i], binEdges[i + 1]), and the last bin
+// is open-ended.
+struct QualityDistribution {
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  std::size_t iMax = 0; // Face or cell with the largest value
+  std::vector<double> binEdges;
+  std::vector<std::size_t> counts;
+};
+
+struct MeshQualityReport {
+  // Angle between Sf and CN in degrees, over the interior faces
+  QualityDistribution nonOrthogonality;
+  // Distance between the face centroid and the point where CN crosses the
+  // face, relative to |CN|, over the interior faces
+  QualityDistribution skewness;
+  // Ratio of the largest to the smallest distance from the cell centroid to
+  // the planes of its faces
+  QualityDistribution aspectRatio;
+  std::size_t nSevereNonOrthogonalFaces = 0;
+};
+
+// Quality of a processed mesh, computed from the geometry of ProcessMesh in
+// one thread-parallel pass over the faces and one over the cells
+class MeshQuality {
+public:
+  // Non-orthogonality above which a face counts as severe (as in checkMesh)
+  static constexpr double severeNonOrthogonality = 70.0;
+
+  MeshQualityReport check(Mesh &fvMesh) const;
+
+  // Write the minimum, mean, maximum and histogram of each measure
+  void writeSummary(const MeshQualityReport &report, std::ostream &os) const;
+};
+
+#endif // MESH_QUALITY_HPP
@@ -2,26 +2,56 @@
 #define PROCESS_MESH_HPP
 
 #include "Mesh.hpp"
-
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Geometry of a mesh from its nodes and connectivity. The work is done in
+// three thread-parallel sweeps: faces, cells and faces again, since the
+// secondary face geometry needs the cell centroids, which need the face
+// centroids. Each entity is computed exactly as in a serial sweep, so the
+// result does not depend on the number of threads.
 class ProcessMesh {
 public:
   void processOpenFoamMesh(Mesh &fvMesh);
 
+  // Gather the geometry of the boundary faces into the patch-local arrays of
+  // the boundaries; processOpenFoamMesh and moveNodes keep them up to date
+  void collectBoundaryGeometry(Mesh &fvMesh);
+
+  // Recompute the secondary geometry of the given faces from the current
+  // face and cell geometry, e.g. after boundary faces became interior faces
+  void updateSecondaryFaceGeometry(Mesh &fvMesh,
+                                   const std::vector<std::size_t> &faces);
+
+  // Move the given nodes by their displacements and update the geometry of
+  // the faces and cells around them only. Each moved face records its swept
+  // volume and each moved cell its previous volume in oldVolume, so that the
+  // swept volumes of the faces of a cell add up to its change in volume.
+  // A node listed more than once is rejected with std::invalid_argument,
+  // before the mesh is changed.
+  void moveNodes(Mesh &fvMesh, const std::vector<std::size_t> &movedNodes,
+                 const std::vector<std::array<double, 3>> &displacements);
+
+  // Move the nodes by a displacement field given for all nodes; nodes with
+  // zero displacement are not touched
+  void moveNodes(Mesh &fvMesh,
+                 const std::vector<std::array<double, 3>> &displacementField);
+
 private:
-  // Compute geometric center of each face
-  void processBasicFaceGeometry(Mesh &fvMesh);
+  // Compute geometric center, surface vector and area of a face with any
+  // number of nodes (triangles and quadrilaterals use block kernels)
+  void processBasicFaceGeometry(Mesh &fvMesh, std::size_t iFace);
 
-  // Compute volume and centroid of each element
-  void computeElementVolumeAndCentroid(Mesh &fvMesh);
+  // Compute volume and centroid of an element and number the matrix
+  // coefficients of its interior faces
+  void computeElementVolumeAndCentroid(Mesh &fvMesh, std::size_t iElement);
 
   // Process secondary face geometry
-  void processSecondaryFaceGeometry(Mesh &fvMesh);
-
-  // Create a flag to sort boundary nodes from interior nodes
-  void sortBoundaryNodesFromInteriorNodes(Mesh &fvMesh);
+  void processSecondaryFaceGeometry(Mesh &fvMesh, std::size_t iFace);
 
-  // Label boundary faces with the corresponding patch index
-  void labelBoundaryFaces(Mesh &fvMesh);
+  // Copy the geometry of a boundary face into the arrays of its patch
+  void storeBoundaryFaceGeometry(Mesh &fvMesh, std::size_t iFace);
 };
 
 #endif
\ No newline at end of file
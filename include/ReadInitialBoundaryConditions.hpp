@@ -3,26 +3,65 @@
 
 #include "Field.hpp"
 #include "Mesh.hpp"
+#include <array>
+#include <string>
 
+// Read the fields of a time directory, "0" for the initial conditions or a
+// written time to restart from. Values are uniform or nonuniform lists in
+// ASCII or binary format; nonuniform internal fields are brought into the
+// current cell numbering of the mesh.
 class ReadInitialBoundaryConditions {
 public:
+  // Read U, T and p concurrently, one task per file
   void readOpenFoamInitialBoundaryConditions(
       Mesh &fvMesh, Field<std::array<double, 3>> &internalVelocityField,
       std::vector<boundaryField<std::array<double, 3>>> &boundaryVelocityFields,
       Field<double> &internalTemperatureField,
-      std::vector<boundaryField<double>> &boundaryTemperatureFields);
+      std::vector<boundaryField<double>> &boundaryTemperatureFields,
+      Field<double> &internalPressureField,
+      std::vector<boundaryField<double>> &boundaryPressureFields,
+      const std::string &timeDirectory = "0");
+
+  // Read the field <timeDirectory>/<fieldName> of scalars, vectors or tensors
+  // (std::array<double, 9>). Patches are matched by name and every patch of
+  // the mesh needs an entry.
+  template <typename ValueType>
+  void readField(Mesh &fvMesh, const std::string &fieldName,
+                 Field<ValueType> &internalField,
+                 std::vector<boundaryField<ValueType>> &boundaryFields,
+                 const std::string &timeDirectory = "0");
 
   void readVelocityField(Mesh &fvMesh,
                          Field<std::array<double, 3>> &internalVelocityField,
                          std::vector<boundaryField<std::array<double, 3>>>
-                             &boundaryVelocityFields);
+                             &boundaryVelocityFields,
+                         const std::string &timeDirectory = "0");
 
   void readTemperatureField(
       Mesh &fvMesh, Field<double> &internalTemperatureField,
-      std::vector<boundaryField<double>> &boundaryTemperatureFields);
+      std::vector<boundaryField<double>> &boundaryTemperatureFields,
+      const std::string &timeDirectory = "0");
 
-  // TO DO:
-  // void readPressureField(Mesh &fvMesh);
+  void readPressureField(
+      Mesh &fvMesh, Field<double> &internalPressureField,
+      std::vector<boundaryField<double>> &boundaryPressureFields,
+      const std::string &timeDirectory = "0");
 };
 
-#endif // READ_INITIAL_BOUNDARY_CONDITIONS_HPP
\ No newline at end of file
+// Prevent implicit instantiation of the template function for these types
+extern template void ReadInitialBoundaryConditions::readField(
+    Mesh &fvMesh, const std::string &fieldName, Field<double> &internalField,
+    std::vector<boundaryField<double>> &boundaryFields,
+    const std::string &timeDirectory);
+extern template void ReadInitialBoundaryConditions::readField(
+    Mesh &fvMesh, const std::string &fieldName,
+    Field<std::array<double, 3>> &internalField,
+    std::vector<boundaryField<std::array<double, 3>>> &boundaryFields,
+    const std::string &timeDirectory);
+extern template void ReadInitialBoundaryConditions::readField(
+    Mesh &fvMesh, const std::string &fieldName,
+    Field<std::array<double, 9>> &internalField,
+    std::vector<boundaryField<std::array<double, 9>>> &boundaryFields,
+    const std::string &timeDirectory);
+
+#endif // READ_INITIAL_BOUNDARY_CONDITIONS_HPP
@@ -1,14 +1,28 @@
 #ifndef READ_MESH_HPP
 #define READ_MESH_HPP
 
+#include "DecomposedMesh.hpp"
 #include "Mesh.hpp"
 #include "ProcessMesh.hpp"
 #include <string>
+#include <vector>
 
 class ReadMesh {
 public:
   void readOpenFoamMesh(Mesh &fvMesh);
 
+  // Build the cell and node connectivities from the faces (owners,
+  // neighbors and node lists) of a mesh
+  void constructConnectivity(Mesh &fvMesh);
+
+  // Read the pieces processor0..N/constant/polyMesh of a decomposed case
+  // concurrently, each into its own processed mesh, together with their
+  // cell, face and point addressing
+  void readDecomposedOpenFoamMesh(DecomposedMesh &decomposedMesh);
+
+  // Stitch the pieces of a decomposed case into the undecomposed mesh
+  void mergeDecomposedMesh(DecomposedMesh &decomposedMesh, Mesh &fvMesh);
+
 private:
   ProcessMesh MeshProcessor;
   void readPointsFile(Mesh &fvMesh);
@@ -16,6 +30,7 @@ private:
   void readOwnersFile(Mesh &fvMesh);
   void readNeighborsFile(Mesh &fvMesh);
   void readBoundaryFile(Mesh &fvMesh);
+  std::vector<long> readAddressingFile(const std::string &addressingFileName);
   void constructCells(Mesh &fvMesh);
   void setupNodeConnectivities(Mesh &fvMesh);
 };
@@ -0,0 +1,53 @@
+#ifndef RECYCLED_CG_HPP
+#define RECYCLED_CG_HPP
+
+#include "CsrMatrix.hpp"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Deflated preconditioned CG that recycles a small subspace of approximate
+// eigenvectors belonging to the smallest eigenvalues from one solve to the
+// next. Consecutive solves with slowly changing matrices (e.g. time steps)
+// are deflated against that subspace, which removes the slowly converging
+// part of the spectrum from the Krylov iteration.
+template <typename ValueType, typename IndexType>
+class RecycledCg
+{
+public:
+  using preconditioner = std::function<void(const ValueType *, ValueType *)>;
+
+  RecycledCg(std::size_t recycleDimension = 8)
+      : recycleDimension_(recycleDimension) {}
+
+  // Number of recycled vectors kept between solves (0 disables deflation)
+  std::size_t &recycleDimension() { return recycleDimension_; }
+
+  // Number of vectors currently in the recycle space
+  std::size_t nRecycledVectors() const { return recycleSpace_.size(); }
+
+  // Drop the recycle space, e.g. when the mesh changes
+  void clear() { recycleSpace_.clear(); }
+
+  // Solve A * x = b using x as the initial guess and update the recycle space.
+  // Iterates until the residual norm is reduced by reductionFactor relative to
+  // the initial residual. Returns the number of iterations.
+  std::size_t solve(const CsrMatrix<ValueType, IndexType> &matrix,
+                    const std::vector<ValueType> &RHS,
+                    std::vector<ValueType> &solVector,
+                    const preconditioner &applyPreconditioner,
+                    ValueType reductionFactor,
+                    std::size_t maxNumIterations);
+
+private:
+  void updateRecycleSpace(const CsrMatrix<ValueType, IndexType> &matrix,
+                          std::vector<std::vector<ValueType>> &directions);
+
+  std::size_t recycleDimension_;
+  std::vector<std::vector<ValueType>> recycleSpace_;
+};
+
+// Prevent implicit instantiation of the template class for these types
+extern template class RecycledCg<double, int>;
+
+#endif // RECYCLED_CG_HPP
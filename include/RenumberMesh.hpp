@@ -0,0 +1,69 @@
+#ifndef RENUMBER_MESH_HPP
+#define RENUMBER_MESH_HPP
+
+#include "Mesh.hpp"
+#include "ProcessMesh.hpp"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Space-filling curves through the cell centroids
+enum class SpaceFillingCurve {
+  morton, // Z-order: bit interleaving of the quantized coordinates
+  hilbert // Hilbert curve: no jumps between distant octants
+};
+
+// Renumber the cells of a processed mesh. Interior faces are renumbered to
+// keep OpenFOAM's upper-triangular order (owner < neighbor, sorted by owner
+// and then by neighbor) and boundary faces keep their patch order. The
+// permutations relative to the mesh files are recorded in the mesh.
+class RenumberMesh {
+public:
+  // Renumber the cells with reverse Cuthill-McKee to reduce the bandwidth
+  void reverseCuthillMcKee(Mesh &fvMesh);
+
+  // Renumber the cells along a space-filling curve through their centroids,
+  // followed by the nodes in order of first use by the faces
+  void spaceFillingCurve(Mesh &fvMesh, SpaceFillingCurve curve);
+
+  // Renumber the cells with cellPerm[newIndex] = oldIndex
+  void renumberCells(Mesh &fvMesh, const std::vector<std::size_t> &cellPerm);
+
+  // Renumber the nodes in the order the faces first reference them
+  void renumberNodesByFirstUse(Mesh &fvMesh);
+
+  // Bring a cell field given in the numbering of the mesh files into the
+  // current numbering of the mesh
+  template <typename ValueType>
+  static void toCurrentNumbering(Mesh &fvMesh,
+                                 std::vector<ValueType> &cellValues);
+
+  // Bring a cell field back to the numbering of the mesh files
+  template <typename ValueType>
+  static std::vector<ValueType>
+  toOriginalNumbering(const std::vector<std::size_t> &cellOrdering,
+                      const std::vector<ValueType> &cellValues);
+
+private:
+  ProcessMesh MeshProcessor;
+};
+
+// Prevent implicit instantiation of the template function for these types
+extern template void
+RenumberMesh::toCurrentNumbering(Mesh &fvMesh,
+                                 std::vector<double> &cellValues);
+extern template void
+RenumberMesh::toCurrentNumbering(Mesh &fvMesh,
+                                 std::vector<std::array<double, 3>> &cellValues);
+extern template void
+RenumberMesh::toCurrentNumbering(Mesh &fvMesh,
+                                 std::vector<std::array<double, 9>> &cellValues);
+extern template std::vector<double>
+RenumberMesh::toOriginalNumbering(const std::vector<std::size_t> &cellOrdering,
+                                  const std::vector<double> &cellValues);
+extern template std::vector<std::array<double, 3>>
+RenumberMesh::toOriginalNumbering(
+    const std::vector<std::size_t> &cellOrdering,
+    const std::vector<std::array<double, 3>> &cellValues);
+
+#endif // RENUMBER_MESH_HPP
@@ -0,0 +1,61 @@
+#ifndef SPARSE_CHOLESKY_HPP
+#define SPARSE_CHOLESKY_HPP
+
+#include "CsrMatrix.hpp"
+#include <cstddef>
+#include <vector>
+
+// Simplicial sparse Cholesky factorization P * A * P^T = L * L^T of a
+// symmetric positive definite matrix. The symbolic analysis (fill-reducing
+// ordering, elimination tree and pattern of L) is kept, so that matrices with
+// the same sparsity pattern only need a numeric refactorization.
+template <typename ValueType, typename IndexType>
+class SparseCholesky
+{
+public:
+  SparseCholesky() = default;
+
+  // Symbolic analysis. Without an ordering (perm[newIndex] = oldIndex), a
+  // nested dissection ordering of the matrix graph is computed.
+  void analyze(const CsrMatrix<ValueType, IndexType> &matrix,
+               std::vector<std::size_t> ordering = {});
+
+  // Numeric factorization, analyzing the matrix first if its sparsity pattern
+  // differs from the analyzed one
+  void factorize(const CsrMatrix<ValueType, IndexType> &matrix);
+
+  // Solve A * x = b with the current factorization; x may alias b
+  void solve(const ValueType *b, ValueType *x) const;
+
+  bool isAnalyzed() const { return !colPtrs_.empty(); }
+  std::size_t nNonzerosFactor() const { return rowIdxs_.size(); }
+  const std::vector<std::size_t> &ordering() const { return perm_; }
+
+private:
+  // Pattern of the analyzed matrix
+  std::vector<IndexType> patternRowPtrs_;
+  std::vector<IndexType> patternColIdxs_;
+
+  // Fill-reducing permutation and its inverse
+  std::vector<std::size_t> perm_;
+  std::vector<std::size_t> inversePerm_;
+
+  // Upper triangle of P * A * P^T by columns, with the position of each entry
+  // in the values of A
+  std::vector<std::size_t> upperColPtrs_;
+  std::vector<std::size_t> upperRowIdxs_;
+  std::vector<std::size_t> upperValueMap_;
+
+  // Elimination tree
+  std::vector<std::ptrdiff_t> parent_;
+
+  // L by columns, diagonal entry first
+  std::vector<std::size_t> colPtrs_;
+  std::vector<std::size_t> rowIdxs_;
+  std::vector<ValueType> values_;
+};
+
+// Prevent implicit instantiation of the template class for these types
+extern template class SparseCholesky<double, int>;
+
+#endif // SPARSE_CHOLESKY_HPP
@@ -0,0 +1,76 @@
+#ifndef WRITE_FIELD_HPP
+#define WRITE_FIELD_HPP
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// Formats of the values of written fields, writeFormat of the controlDict
+enum class WriteFormat {
+  ascii, // Text, with writePrecision significant digits
+  binary // Raw little-endian doubles, as OpenFOAM writes binary lists
+};
+
+// Write the fields of a case in OpenFOAM format. The write settings of
+// system/controlDict are read once, and the dimensions and boundaryField
+// entries of each field are read once from the initial conditions and then
+// reused, so the writes of a time loop only format and write the values.
+class WriteField {
+public:
+  explicit WriteField(const std::string &caseDirectory);
+
+  // Write <caseDirectory>/<timePoint>/<fieldName>, or <fieldName>.gz with
+  // writeCompression, as a volScalarField or a volVectorField. A renumbered
+  // field is written in the numbering of the mesh files when the
+  // cellOrdering of the mesh is given.
+  template <typename ValueType>
+  void write(const std::vector<ValueType> &values, const std::string &timePoint,
+             const std::string &fieldName,
+             const std::vector<std::size_t> &cellOrdering = {});
+
+  // Significant digits of the values, writePrecision of the controlDict,
+  // which is limited to 17. 0 writes the shortest representation that reads
+  // back exactly.
+  int &writePrecision() { return writePrecision_; }
+
+  WriteFormat &writeFormat() { return writeFormat_; }
+
+  // Write <fieldName>.gz files, writeCompression of the controlDict
+  bool &writeCompression() { return writeCompression_; }
+
+  // Size of the last written file on disk, e.g. for throughput measurements
+  std::size_t bytesWritten() const { return bytesWritten_; }
+
+private:
+  // Entries of the initial conditions that are copied to every written time
+  struct SourceEntries {
+    std::string dimensions;
+    std::string boundaryField;
+    // Format of the lists of values in boundaryField
+    bool binary = false;
+    // boundaryField with its lists in the other format, once it is written
+    std::string convertedBoundaryField;
+  };
+  SourceEntries &sourceEntries(const std::string &fieldName);
+
+  std::string caseDirectory_;
+  int writePrecision_ = 0;
+  WriteFormat writeFormat_ = WriteFormat::ascii;
+  bool writeCompression_ = false;
+  std::size_t bytesWritten_ = 0;
+  std::map<std::string, SourceEntries> sourceEntries_;
+};
+
+// Prevent implicit instantiation of the template function for these types
+extern template void
+WriteField::write(const std::vector<double> &values,
+                  const std::string &timePoint, const std::string &fieldName,
+                  const std::vector<std::size_t> &cellOrdering);
+extern template void
+WriteField::write(const std::vector<std::array<double, 3>> &values,
+                  const std::string &timePoint, const std::string &fieldName,
+                  const std::vector<std::size_t> &cellOrdering);
+
+#endif // WRITE_FIELD_HPP
@@ -0,0 +1,65 @@
+#ifndef WRITE_VTU_HPP
+#define WRITE_VTU_HPP
+
+#include "Mesh.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Write the mesh and cell fields as a VTK unstructured grid (.vtu) that
+// ParaView reads directly. The cells are polyhedra built from the faces of
+// the mesh, and all arrays are raw little-endian binary in an appended
+// block, so reading a file is a few large reads without any parsing of
+// values. The cell connectivity is built once and reused for every write;
+// the node coordinates are taken at each write, so moved meshes are written
+// as they are.
+class WriteVtu {
+public:
+  explicit WriteVtu(Mesh &fvMesh);
+
+  // Add a cell field to the next write, in the current numbering of the
+  // mesh. The values are not copied and must stay valid until the write.
+  template <typename ValueType>
+  void addField(const std::string &fieldName,
+                const std::vector<ValueType> &values);
+
+  // Write the mesh and the added fields to fileName and clear the fields
+  void write(const std::string &fileName);
+
+  // Write the time step to <caseDir>/VTK/<caseName>_<iStep>.vtu and rewrite
+  // the series file <caseDir>/VTK/<caseName>.pvd, which lists all time
+  // steps written so far for ParaView to open as one time series
+  void writeTimeStep(double time);
+
+  // Size of the last written file, e.g. for throughput measurements
+  std::size_t bytesWritten() const { return bytesWritten_; }
+
+private:
+  struct CellField {
+    std::string name;
+    int nComponents;
+    const double *values;
+  };
+
+  Mesh &fvMesh_;
+  std::vector<std::int64_t> connectivity_;
+  std::vector<std::int64_t> offsets_;
+  std::vector<std::uint8_t> types_;
+  std::vector<std::int64_t> faces_;
+  std::vector<std::int64_t> faceOffsets_;
+  std::vector<CellField> fields_;
+  std::vector<std::pair<double, std::string>> timeSteps_;
+  std::size_t bytesWritten_ = 0;
+};
+
+// Prevent implicit instantiation of the template function for these types
+extern template void WriteVtu::addField(const std::string &fieldName,
+                                        const std::vector<double> &values);
+extern template void
+WriteVtu::addField(const std::string &fieldName,
+                   const std::vector<std::array<double, 3>> &values);
+
+#endif // WRITE_VTU_HPP
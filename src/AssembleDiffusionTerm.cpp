@@ -1,8 +1,116 @@
 #include "AssembleDiffusionTerm.hpp"
 
+#include "BoundaryCondition.hpp"
 #include "Field.hpp"
 
+#include <array>
 #include <cstddef>
+#include <stdexcept>
+
+namespace
+{
+
+// Component dim of a scalar or vector field value
+inline double component(const double &value, std::size_t) { return value; }
+inline double component(const std::array<double, 3> &value, std::size_t dim)
+{
+  return value[dim];
+}
+
+// Contributions of a boundary face to the diagonal entry and the right-hand
+// side of its owner cell, compiled for one condition type. FluxCb is the
+// diffusion coefficient times gDiff, which weights the boundary value, and
+// FluxGb the diffusion coefficient times the face area, which weights the
+// normal gradient. A mixed condition blends the two with valueFraction. The
+// value (refValue) is passed in so that uniform fields are broadcast.
+template <BoundaryConditionType Type, typename ValueType>
+struct BoundaryKernel {
+  static constexpr bool hasDiagonal = Type == BoundaryConditionType::fixedValue ||
+                                      Type == BoundaryConditionType::mixed;
+  static constexpr bool hasSource = hasDiagonal ||
+                                    Type == BoundaryConditionType::fixedGradient;
+
+  static double diagonal(boundaryField<ValueType> &field,
+                         std::size_t iPatchFace,
+                         double FluxCb)
+  {
+    if constexpr (Type == BoundaryConditionType::fixedValue) {
+      return FluxCb;
+    } else if constexpr (Type == BoundaryConditionType::mixed) {
+      return field.valueFraction()[iPatchFace] * FluxCb;
+    } else {
+      return 0.0;
+    }
+  }
+
+  static double source(boundaryField<ValueType> &field,
+                       std::size_t iPatchFace,
+                       const ValueType &value,
+                       std::size_t dim,
+                       double FluxCb,
+                       double FluxGb)
+  {
+    if constexpr (Type == BoundaryConditionType::fixedValue) {
+      return FluxCb * component(value, dim);
+    } else if constexpr (Type == BoundaryConditionType::fixedGradient) {
+      return FluxGb * component(field.gradient()[iPatchFace], dim);
+    } else if constexpr (Type == BoundaryConditionType::mixed) {
+      const double valueFraction = field.valueFraction()[iPatchFace];
+      return valueFraction * FluxCb * component(value, dim) +
+             (1.0 - valueFraction) * FluxGb *
+                 component(field.gradient()[iPatchFace], dim);
+    } else {
+      return 0.0;
+    }
+  }
+};
+
+// Check once per patch that a field holds the data its condition type needs
+template <typename ValueType>
+void checkBoundaryFields(Mesh &fvMesh,
+                         std::vector<boundaryField<ValueType>> &boundaryFields)
+{
+  if (boundaryFields.size() < fvMesh.nBoundaries()) {
+    throw std::invalid_argument("Error: Missing boundary fields");
+  }
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    boundaryField<ValueType> &field = boundaryFields[iBoundary];
+    const std::size_t nFaces = fvMesh.boundaries()[iBoundary].nFaces();
+    const BoundaryConditionType type = field.conditionType();
+    const bool needsValues = type == BoundaryConditionType::fixedValue ||
+                             type == BoundaryConditionType::mixed;
+    const bool needsGradient = type == BoundaryConditionType::fixedGradient ||
+                               type == BoundaryConditionType::mixed;
+    if ((needsValues && field.size() < nFaces) ||
+        (needsGradient && field.gradient().size() < nFaces) ||
+        (type == BoundaryConditionType::mixed &&
+         field.valueFraction().size() < nFaces)) {
+      throw std::invalid_argument(
+          "Error: Incomplete " + field.boundaryType() + " boundary field on patch " +
+          fvMesh.boundaries()[iBoundary].userName());
+    }
+  }
+}
+
+// Add a value to the diagonal entry of a row
+template <typename MatrixType>
+void addToDiagonal(MatrixType &coeffMatrix, int row, double value)
+{
+  if constexpr (std::is_same_v<MatrixType, Matrix<double>>) {
+    coeffMatrix(row, row) += value;
+  } else if constexpr (std::is_same_v<MatrixType,
+                                      gko::matrix_data<double, int>>) {
+    coeffMatrix.nonzeros.emplace_back(row, row, value);
+  } else {
+    static_assert(
+        std::is_same_v<MatrixType, Matrix<double>> ||
+            std::is_same_v<MatrixType, gko::matrix_data<double, int>>,
+        "Unsupported MatrixType. Must be either Matrix<double> or "
+        "gko::matrix_data<double, int>.");
+  }
+}
+
+} // namespace
 
 // The implementations of element-based assembly of the diffusion term
 void AssembleDiffusionTerm::cellBasedAssemble(
@@ -14,6 +122,7 @@ void AssembleDiffusionTerm::cellBasedAssemble(
     std::vector<std::array<double, 3>> &RHS)
 {
   const std::size_t nCells = fvMesh.nCells();
+  checkBoundaryFields(fvMesh, boundaryFields);
 
   for (size_t dim = 0; dim < 3; dim++) {
     coeffMatrix[dim].size = {nCells, nCells};
@@ -29,7 +138,7 @@ void AssembleDiffusionTerm::cellBasedAssemble(
     const std::size_t nFaces = theElement.iFaces().size();
 
     // Temporary storage of the diagonal entry of the coefficient matrix
-    auto diag = internalVelocity.values()[iElement];
+    auto diag = internalVelocity.value(iElement);
 
     for (std::size_t iFace = 0; iFace < nFaces; ++iFace) {
 
@@ -67,46 +176,31 @@ void AssembleDiffusionTerm::cellBasedAssemble(
           diag[dim] += FluxCn;
         }
       } else { // If it is a boundary face
-        // Get the boundary type
-
-        const std::size_t iBoundary = fvMesh.faces()[iFaceIndex].patchIndex();
-        const std::string &boundaryType =
-            boundaryFields[iBoundary].boundaryType();
-
-        double FluxCb = 0.0;
-        std::array<double, 3> FluxVb{0.0, 0.0, 0.0};
-
-        if (boundaryType == "fixedValue") { // Dirichlet BC
-
-          FluxCb = diffusionCoef * theFace.gDiff();
-
-          std::size_t relativeFaceIndex =
-              iFaceIndex - fvMesh.boundaries()[iBoundary].startFace();
-          // FluxVb = -FluxCb *
-          // boundaryFields[iBoundary].values()[relativeFaceIndex];
-
-          for (size_t dim = 0; dim < 3; dim++) {
-            diag[dim] += FluxCb;
+        const std::size_t iBoundary = theFace.patchIndex();
+        boundaryField<std::array<double, 3>> &field = boundaryFields[iBoundary];
+        const std::size_t relativeFaceIndex =
+            iFaceIndex - fvMesh.boundaries()[iBoundary].startFace();
+        const double FluxCb = diffusionCoef * theFace.gDiff();
+        const double FluxGb = diffusionCoef * theFace.area();
+
+        dispatchBoundaryCondition(field.conditionType(), [&](auto type) {
+          using Kernel =
+              BoundaryKernel<decltype(type)::value, std::array<double, 3>>;
+          if constexpr (Kernel::hasDiagonal) {
+            const double FluxCbC =
+                Kernel::diagonal(field, relativeFaceIndex, FluxCb);
+            for (size_t dim = 0; dim < 3; dim++) {
+              diag[dim] += FluxCbC;
+            }
           }
-          for (size_t dim = 0; dim < 3; dim++) {
-            RHS[iElement][dim] -=
-                -FluxCb *
-                boundaryFields[iBoundary].values()[relativeFaceIndex][dim];
+          if constexpr (Kernel::hasSource) {
+            for (size_t dim = 0; dim < 3; dim++) {
+              RHS[iElement][dim] += Kernel::source(
+                  field, relativeFaceIndex, field.value(relativeFaceIndex),
+                  dim, FluxCb, FluxGb);
+            }
           }
-        }
-
-        else if (boundaryType == "zeroGradient") { // zero Neumann BC
-                                                   // Do nothing because FluxCb
-                                                   // and FluxVb are already 0.0
-        }
-
-        else if (boundaryType == "empty") { // empty BC for 1D or 2D problems
-                                            // Do nothing because the face does
-                                            // not contribute
-        }
-
-        // else if () { // mixed BC
-        // }
+        });
       }
     }
 
@@ -157,6 +251,7 @@ void AssembleDiffusionTerm::faceBasedAssemble(
     MatrixType &coeffMatrix,
     std::vector<double> &RHS)
 {
+  checkBoundaryFields(fvMesh, boundaryFields);
   if constexpr (std::is_same_v<MatrixType, gko::matrix_data<double, int>>) {
     coeffMatrix.size = {fvMesh.nCells(), fvMesh.nCells()};
   }
@@ -216,53 +311,25 @@ void AssembleDiffusionTerm::faceBasedAssemble(
     }
 
     else { // If it is a boundary face
-      // Get the boundary type
-      const std::size_t iBoundary = fvMesh.faces()[iFace].patchIndex();
-      const std::string &boundaryType =
-          boundaryFields[iBoundary].boundaryType();
-
-      double FluxCb = 0.0;
-      double FluxVb = 0.0;
-
-      if (boundaryType == "fixedValue") { // Dirichlet BC
-        FluxCb = diffusionCoef[iFace] * theFace.gDiff();
-
-        std::size_t relativeFaceIndex =
-            iFace - fvMesh.boundaries()[iBoundary].startFace();
-        FluxVb =
-            -FluxCb * boundaryFields[iBoundary].values()[relativeFaceIndex];
-
-        if constexpr (std::is_same_v<MatrixType, Matrix<double>>) {
-          coeffMatrix(theFace.iOwner(), theFace.iOwner()) += FluxCb;
-        } else if constexpr (std::is_same_v<
-                                 MatrixType,
-                                 gko::matrix_data<double, int>>) {
-          coeffMatrix.nonzeros.emplace_back(
-              theFace.iOwner(),
-              theFace.iOwner(),
-              FluxCb);
-        } else {
-          static_assert(
-              std::is_same_v<MatrixType, Matrix<double>> ||
-                  std::is_same_v<MatrixType, gko::matrix_data<double, int>>,
-              "Unsupported MatrixType. Must be either Matrix<double> or "
-              "gko::matrix_data<double, int>.");
+      const std::size_t iBoundary = theFace.patchIndex();
+      boundaryField<double> &field = boundaryFields[iBoundary];
+      const std::size_t relativeFaceIndex =
+          iFace - fvMesh.boundaries()[iBoundary].startFace();
+      const double FluxCb = diffusionCoef[iFace] * theFace.gDiff();
+      const double FluxGb = diffusionCoef[iFace] * theFace.area();
+
+      dispatchBoundaryCondition(field.conditionType(), [&](auto type) {
+        using Kernel = BoundaryKernel<decltype(type)::value, double>;
+        if constexpr (Kernel::hasDiagonal) {
+          addToDiagonal(coeffMatrix, theFace.iOwner(),
+                        Kernel::diagonal(field, relativeFaceIndex, FluxCb));
         }
-        RHS[theFace.iOwner()] -= FluxVb;
-      }
-
-      else if (boundaryType == "zeroGradient") { // zero Neumann BC
-                                                 // Do nothing because FluxCb
-                                                 // and FluxVb are already 0.0
-      }
-
-      else if (boundaryType == "empty") { // empty BC for 1D or 2D problems
-                                          // Do nothing because the face does
-                                          // not contribute
-      }
-
-      // else if () { // mixed BC
-      // }
+        if constexpr (Kernel::hasSource) {
+          RHS[theFace.iOwner()] += Kernel::source(
+              field, relativeFaceIndex, field.value(relativeFaceIndex), 0,
+              FluxCb, FluxGb);
+        }
+      });
     }
   }
   if constexpr (std::is_same_v<MatrixType, gko::matrix_data<double, int>>) {
@@ -297,6 +364,7 @@ void AssembleDiffusionTerm::batchedFaceBasedAssemble(
     MatrixType &coeffMatrix,
     std::vector<double> &RHS)
 {
+  checkBoundaryFields(fvMesh, boundaryFields);
   if constexpr (std::is_same_v<MatrixType, gko::matrix_data<double, int>>) {
     coeffMatrix.size = {fvMesh.nCells(), fvMesh.nCells()};
   }
@@ -363,54 +431,45 @@ void AssembleDiffusionTerm::batchedFaceBasedAssemble(
     const std::size_t startFace = theBoundary.startFace();
     const std::size_t endFace = startFace + theBoundary.nFaces();
 
-    // Get the boundary type
-    const std::string &boundaryType = boundaryFields[iBoundary].boundaryType();
-
-    if (boundaryType == "fixedValue") { // Dirichlet BC
-
-      // Loop over all the faces of the boundary
-      for (std::size_t iFace = startFace; iFace < endFace; ++iFace) {
-        // Get the face
-        Face &theFace = fvMesh.faces()[iFace];
-
-        double FluxCb = 0.0;
-        double FluxVb = 0.0;
-
-        FluxCb = diffusionCoef[iFace] * theFace.gDiff();
-
-        std::size_t relativeFaceIndex =
-            iFace - fvMesh.boundaries()[iBoundary].startFace();
-        FluxVb =
-            -FluxCb * boundaryFields[iBoundary].values()[relativeFaceIndex];
-
-        RHS[theFace.iOwner()] -= FluxVb;
-
-        if constexpr (std::is_same_v<MatrixType, Matrix<double>>) {
-          coeffMatrix(theFace.iOwner(), theFace.iOwner()) += FluxCb;
-        } else if constexpr (std::is_same_v<
-                                 MatrixType,
-                                 gko::matrix_data<double, int>>) {
-          coeffMatrix.nonzeros.emplace_back(
-              theFace.iOwner(),
-              theFace.iOwner(),
-              FluxCb);
-        } else {
-          static_assert(
-              std::is_same_v<MatrixType, Matrix<double>> ||
-                  std::is_same_v<MatrixType, gko::matrix_data<double, int>>,
-              "Unsupported MatrixType. Must be either Matrix<double> or "
-              "gko::matrix_data<double, int>.");
-        }
-      }
-    } else if (boundaryType == "zeroGradient") { // zero Neumann BC
-                                                 // Do nothing because FluxCb
-                                                 // and FluxVb are already 0.0
+    // The face loop streams through the patch-local geometry arrays
+    const std::vector<std::size_t> &faceOwners = theBoundary.faceOwners();
+    const std::vector<double> &gDiff = theBoundary.gDiff();
+    const std::vector<double> &area = theBoundary.area();
+    if (faceOwners.size() != theBoundary.nFaces()) {
+      throw std::runtime_error(
+          "Error: Boundary geometry not collected for patch " +
+          theBoundary.userName());
     }
 
-    else if (boundaryType == "empty") { // empty BC for 1D or 2D problems
-                                        // Do nothing because the face does not
-                                        // contribute
-    }
+    // The condition type is resolved once per patch, and the face loop is
+    // compiled for it
+    boundaryField<double> &field = boundaryFields[iBoundary];
+    dispatchBoundaryCondition(field.conditionType(), [&](auto type) {
+      using Kernel = BoundaryKernel<decltype(type)::value, double>;
+      if constexpr (Kernel::hasDiagonal || Kernel::hasSource) {
+        // A uniform value is broadcast with a zero stride
+        const bool uniform = field.isUniform();
+        const double *values =
+            uniform ? &field.uniformValue() : field.values().data();
+        const std::size_t stride = uniform ? 0 : 1;
+
+        for (std::size_t iPatchFace = 0; iPatchFace < endFace - startFace;
+             ++iPatchFace) {
+          const double coef = diffusionCoef[startFace + iPatchFace];
+          const double FluxCb = coef * gDiff[iPatchFace];
+          const double FluxGb = coef * area[iPatchFace];
+          const auto iOwner = static_cast<int>(faceOwners[iPatchFace]);
+
+          RHS[iOwner] += Kernel::source(field, iPatchFace,
+                                        values[iPatchFace * stride], 0,
+                                        FluxCb, FluxGb);
+          if constexpr (Kernel::hasDiagonal) {
+            addToDiagonal(coeffMatrix, iOwner,
+                          Kernel::diagonal(field, iPatchFace, FluxCb));
+          }
+        }
+      }
+    });
   }
 
   if constexpr (std::is_same_v<MatrixType, gko::matrix_data<double, int>>) {
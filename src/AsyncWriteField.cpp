@@ -0,0 +1,112 @@
+#include "AsyncWriteField.hpp"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+AsyncWriteField::AsyncWriteField(const std::string &caseDirectory,
+                                 std::size_t maxQueueDepth)
+    : fieldWriter_(caseDirectory),
+      maxQueueDepth_(std::max<std::size_t>(maxQueueDepth, 1)),
+      worker_(&AsyncWriteField::run, this) {}
+
+AsyncWriteField::~AsyncWriteField() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  // The worker finishes the queued writes before it stops
+  workAvailable_.notify_one();
+  worker_.join();
+  if (error_) {
+    try {
+      std::rethrow_exception(error_);
+    } catch (const std::exception &e) {
+      std::cerr << "Error: A background write failed: " << e.what()
+                << std::endl;
+    }
+  }
+}
+
+template <typename ValueType>
+void AsyncWriteField::write(std::vector<ValueType> values,
+                            const std::string &timePoint,
+                            const std::string &fieldName,
+                            std::vector<std::size_t> cellOrdering) {
+  enqueue([this, values = std::move(values), timePoint, fieldName,
+           cellOrdering = std::move(cellOrdering)]() {
+    fieldWriter_.write(values, timePoint, fieldName, cellOrdering);
+  });
+}
+
+// Explicit template instantiation for scalar and vector fields
+template void AsyncWriteField::write(std::vector<double> values,
+                                     const std::string &timePoint,
+                                     const std::string &fieldName,
+                                     std::vector<std::size_t> cellOrdering);
+template void AsyncWriteField::write(std::vector<std::array<double, 3>> values,
+                                     const std::string &timePoint,
+                                     const std::string &fieldName,
+                                     std::vector<std::size_t> cellOrdering);
+
+void AsyncWriteField::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  progress_.wait(lock, [this]() { return queue_.empty() && !busy_; });
+  lock.unlock();
+  rethrowError();
+}
+
+void AsyncWriteField::enqueue(std::function<void()> task) {
+  rethrowError();
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Back-pressure: wait for the worker to take a queued write
+  progress_.wait(lock,
+                 [this]() { return queue_.size() < maxQueueDepth_; });
+  queue_.push_back(std::move(task));
+  lock.unlock();
+  workAvailable_.notify_one();
+}
+
+void AsyncWriteField::rethrowError() {
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(error, error_);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void AsyncWriteField::run() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      workAvailable_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+      busy_ = true;
+    }
+    progress_.notify_all();
+
+    std::exception_ptr error;
+    try {
+      task();
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_ = false;
+      // Keep the first error until it is thrown
+      if (error && !error_) {
+        error_ = error;
+      }
+    }
+    progress_.notify_all();
+  }
+}
@@ -0,0 +1,237 @@
+#include "ChebyshevPreconditioner.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+// Number of eigenvalues of the symmetric tridiagonal matrix (alpha, beta)
+// that are smaller than x (Sturm sequence count)
+template <typename ValueType>
+std::size_t countEigenvaluesBelow(const std::vector<ValueType> &alpha,
+                                  const std::vector<ValueType> &beta,
+                                  const ValueType x)
+{
+  std::size_t count = 0;
+  ValueType q = 1.0;
+  for (std::size_t i = 0; i < alpha.size(); ++i) {
+    const ValueType offDiagonal = i > 0 ? beta[i - 1] : 0.0;
+    q = alpha[i] - x - (i > 0 ? offDiagonal * offDiagonal / q : 0.0);
+    if (q == 0.0) {
+      q = -1.0e-300;
+    }
+    if (q < 0.0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// k-th smallest eigenvalue (k = 1, ..., n) of a symmetric tridiagonal matrix
+// by bisection on its Gershgorin interval
+template <typename ValueType>
+ValueType tridiagonalEigenvalue(const std::vector<ValueType> &alpha,
+                                const std::vector<ValueType> &beta,
+                                const std::size_t k)
+{
+  ValueType lower = alpha[0];
+  ValueType upper = alpha[0];
+  for (std::size_t i = 0; i < alpha.size(); ++i) {
+    const ValueType radius = (i > 0 ? std::abs(beta[i - 1]) : 0.0) +
+                             (i + 1 < alpha.size() ? std::abs(beta[i]) : 0.0);
+    lower = std::min(lower, alpha[i] - radius);
+    upper = std::max(upper, alpha[i] + radius);
+  }
+
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    const ValueType middle = 0.5 * (lower + upper);
+    if (countEigenvaluesBelow(alpha, beta, middle) >= k) {
+      upper = middle;
+    } else {
+      lower = middle;
+    }
+  }
+  return 0.5 * (lower + upper);
+}
+} // namespace
+
+template <typename ValueType, typename IndexType>
+ChebyshevPreconditioner<ValueType, IndexType>::ChebyshevPreconditioner(
+    std::shared_ptr<const CsrMatrix<ValueType, IndexType>> matrix,
+    std::size_t degree,
+    SpectralEstimate estimate,
+    std::size_t nLanczosSteps,
+    ValueType eigenvalueRatio)
+    : matrix_(std::move(matrix)), degree_(degree),
+      eigenvalueRatio_(eigenvalueRatio), direction_(matrix_->nRows())
+{
+  if (degree_ == 0) {
+    throw std::invalid_argument("Chebyshev degree must be at least 1");
+  }
+
+  invDiag_ = matrix_->diagonal();
+  for (auto &diag : invDiag_) {
+    if (diag <= 0.0) {
+      throw std::invalid_argument(
+          "Chebyshev preconditioner requires a positive diagonal");
+    }
+    diag = 1.0 / diag;
+  }
+
+  estimateGershgorin();
+  if (estimate == SpectralEstimate::lanczos && nLanczosSteps > 0) {
+    estimateLanczos(nLanczosSteps);
+  }
+}
+
+template <typename ValueType, typename IndexType>
+void ChebyshevPreconditioner<ValueType, IndexType>::estimateGershgorin()
+{
+  const auto &rowPtrs = matrix_->rowPtrs();
+  const auto &colIdxs = matrix_->colIdxs();
+  const auto &values = matrix_->values();
+
+  // Every eigenvalue of D^{-1} * A lies in a disc around 1 whose radius is the
+  // scaled off-diagonal row sum
+  ValueType maxEigenvalue = 0.0;
+  for (std::size_t iRow = 0; iRow < matrix_->nRows(); ++iRow) {
+    ValueType radius = 0.0;
+    for (IndexType k = rowPtrs[iRow]; k < rowPtrs[iRow + 1]; ++k) {
+      if (static_cast<std::size_t>(colIdxs[k]) != iRow) {
+        radius += std::abs(values[k]);
+      }
+    }
+    maxEigenvalue = std::max(maxEigenvalue, 1.0 + radius * invDiag_[iRow]);
+  }
+
+  // The lower Gershgorin bound is usually not positive, so target the upper
+  // part of the spectrum as a smoother would
+  maxEigenvalue_ = maxEigenvalue;
+  minEigenvalue_ = maxEigenvalue / eigenvalueRatio_;
+}
+
+template <typename ValueType, typename IndexType>
+void ChebyshevPreconditioner<ValueType, IndexType>::estimateLanczos(
+    std::size_t nSteps)
+{
+  const std::size_t nRows = matrix_->nRows();
+  const auto n = static_cast<std::ptrdiff_t>(nRows);
+
+  // Lanczos on the symmetric matrix D^{-1/2} * A * D^{-1/2}, which has the
+  // same spectrum as D^{-1} * A
+  std::vector<ValueType> scale(nRows);
+  for (std::size_t i = 0; i < nRows; ++i) {
+    scale[i] = std::sqrt(invDiag_[i]);
+  }
+
+  // Deterministic pseudo-random start vector
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<ValueType> distribution(-1.0, 1.0);
+  std::vector<ValueType> v(nRows);
+  for (auto &value : v) {
+    value = distribution(generator);
+  }
+
+  std::vector<ValueType> vPrevious(nRows, 0.0);
+  std::vector<ValueType> w(nRows);
+  std::vector<ValueType> scaled(nRows);
+  std::vector<ValueType> alpha;
+  std::vector<ValueType> beta;
+
+  ValueType norm = 0.0;
+#pragma omp parallel for reduction(+ : norm)
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    norm += v[i] * v[i];
+  }
+  norm = std::sqrt(norm);
+
+  ValueType betaPrevious = 0.0;
+  for (std::size_t step = 0; step < std::min(nSteps, nRows); ++step) {
+#pragma omp parallel for
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      v[i] /= norm;
+      scaled[i] = scale[i] * v[i];
+    }
+    matrix_->apply(scaled.data(), w.data());
+
+    ValueType alphaStep = 0.0;
+#pragma omp parallel for reduction(+ : alphaStep)
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      w[i] *= scale[i];
+      alphaStep += w[i] * v[i];
+    }
+
+    norm = 0.0;
+#pragma omp parallel for reduction(+ : norm)
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      w[i] -= alphaStep * v[i] + betaPrevious * vPrevious[i];
+      norm += w[i] * w[i];
+    }
+    norm = std::sqrt(norm);
+    alpha.push_back(alphaStep);
+
+    // Stop on an invariant subspace
+    if (norm <= 1.0e-12 * std::abs(alphaStep)) {
+      break;
+    }
+    beta.push_back(norm);
+    betaPrevious = norm;
+    std::swap(vPrevious, v);
+    std::swap(v, w);
+  }
+
+  // Ritz values bound the spectrum from the inside, so enlarge the upper end
+  // by a safety margin while keeping it below the Gershgorin bound
+  const ValueType ritzMin = tridiagonalEigenvalue(alpha, beta, 1);
+  const ValueType ritzMax = tridiagonalEigenvalue(alpha, beta, alpha.size());
+  maxEigenvalue_ = std::min(1.1 * ritzMax, maxEigenvalue_);
+  minEigenvalue_ = std::max(ritzMin, maxEigenvalue_ / eigenvalueRatio_);
+}
+
+template <typename ValueType, typename IndexType>
+void ChebyshevPreconditioner<ValueType, IndexType>::apply(const ValueType *r,
+                                                          ValueType *z) const
+{
+  const auto &rowPtrs = matrix_->rowPtrs();
+  const auto &colIdxs = matrix_->colIdxs();
+  const auto &values = matrix_->values();
+  const auto n = static_cast<std::ptrdiff_t>(matrix_->nRows());
+  ValueType *d = direction_.data();
+
+  // Chebyshev iteration on D^{-1} * A starting from z = 0 (Saad, Alg. 12.1)
+  const ValueType theta = 0.5 * (maxEigenvalue_ + minEigenvalue_);
+  const ValueType delta = 0.5 * (maxEigenvalue_ - minEigenvalue_);
+  const ValueType sigma = theta / delta;
+  ValueType rho = 1.0 / sigma;
+
+#pragma omp parallel for simd
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    d[i] = invDiag_[i] * r[i] / theta;
+    z[i] = d[i];
+  }
+
+  for (std::size_t iTerm = 1; iTerm < degree_; ++iTerm) {
+    const ValueType rhoNew = 1.0 / (2.0 * sigma - rho);
+    const ValueType directionCoef = rhoNew * rho;
+    const ValueType residualCoef = 2.0 * rhoNew / delta;
+
+    // Fuse the residual r - A * z with the update of the search direction
+#pragma omp parallel for
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      ValueType residual = r[i];
+      for (IndexType k = rowPtrs[i]; k < rowPtrs[i + 1]; ++k) {
+        residual -= values[k] * z[colIdxs[k]];
+      }
+      d[i] = directionCoef * d[i] + residualCoef * invDiag_[i] * residual;
+    }
+
+#pragma omp parallel for simd
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      z[i] += d[i];
+    }
+    rho = rhoNew;
+  }
+}
+
+// Explicit template instantiation for commonly used types
+template class ChebyshevPreconditioner<double, int>;
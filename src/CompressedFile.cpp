@@ -0,0 +1,199 @@
+#include "CompressedFile.hpp"
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <zlib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Window bits that select the gzip wrapper in zlib
+constexpr int gzipWindowBits = 15 + 16;
+
+bool isGzip(const std::string &data) {
+  return data.size() >= 2 && static_cast<unsigned char>(data[0]) == 0x1f &&
+         static_cast<unsigned char>(data[1]) == 0x8b;
+}
+
+std::string readRaw(const std::string &fileName) {
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Error: Cannot open file: " + fileName);
+  }
+  file.seekg(0, std::ios::end);
+  std::string buffer(static_cast<std::size_t>(file.tellg()), '\0');
+  file.seekg(0);
+  file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  return buffer;
+}
+
+// Decompress all gzip members of the data
+std::string inflateMembers(const std::string &data,
+                           const std::string &fileName) {
+  z_stream stream{};
+  if (inflateInit2(&stream, gzipWindowBits) != Z_OK) {
+    throw std::runtime_error("Error: Cannot initialize decompression of " +
+                             fileName);
+  }
+
+  std::string text(std::max<std::size_t>(4 * data.size(), 1 << 16), '\0');
+  std::size_t nIn = 0;
+  std::size_t nOut = 0;
+  for (;;) {
+    if (nOut == text.size()) {
+      text.resize(2 * text.size());
+    }
+    stream.next_in =
+        reinterpret_cast<Bytef *>(const_cast<char *>(data.data() + nIn));
+    stream.avail_in =
+        static_cast<uInt>(std::min<std::size_t>(data.size() - nIn, UINT_MAX));
+    stream.next_out = reinterpret_cast<Bytef *>(text.data() + nOut);
+    stream.avail_out =
+        static_cast<uInt>(std::min<std::size_t>(text.size() - nOut, UINT_MAX));
+    const uInt availIn = stream.avail_in;
+    const uInt availOut = stream.avail_out;
+    const int result = inflate(&stream, Z_NO_FLUSH);
+    nIn += availIn - stream.avail_in;
+    nOut += availOut - stream.avail_out;
+
+    if (result == Z_STREAM_END) {
+      // The next member, if any
+      if (nIn == data.size()) {
+        break;
+      }
+      inflateReset(&stream);
+    } else if (result != Z_OK &&
+               !(result == Z_BUF_ERROR && nIn < data.size())) {
+      inflateEnd(&stream);
+      throw std::runtime_error("Error: Corrupt or truncated gzip file: " +
+                               fileName);
+    }
+  }
+  inflateEnd(&stream);
+  text.resize(nOut);
+  return text;
+}
+
+// Compress a block into a complete gzip member
+bool deflateMember(const std::string &block, int level,
+                   std::string &member) {
+  z_stream stream{};
+  if (deflateInit2(&stream, level, Z_DEFLATED, gzipWindowBits, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+  member.resize(deflateBound(&stream, static_cast<uLong>(block.size())));
+  stream.next_in =
+      reinterpret_cast<Bytef *>(const_cast<char *>(block.data()));
+  stream.avail_in = static_cast<uInt>(block.size());
+  stream.next_out = reinterpret_cast<Bytef *>(member.data());
+  stream.avail_out = static_cast<uInt>(member.size());
+  const int result = deflate(&stream, Z_FINISH);
+  member.resize(stream.total_out);
+  deflateEnd(&stream);
+  return result == Z_STREAM_END;
+}
+
+} // namespace
+
+std::string CompressedFile::resolve(const std::string &fileName) {
+  if (std::filesystem::is_regular_file(fileName)) {
+    return fileName;
+  }
+  if (std::filesystem::is_regular_file(fileName + ".gz")) {
+    return fileName + ".gz";
+  }
+  return "";
+}
+
+std::string CompressedFile::read(const std::string &fileName) {
+  const std::string diskFileName = resolve(fileName);
+  if (diskFileName.empty()) {
+    throw std::runtime_error("Error: Cannot open file: " + fileName);
+  }
+  std::string data = readRaw(diskFileName);
+  return isGzip(data) ? inflateMembers(data, diskFileName) : data;
+}
+
+std::unique_ptr<std::istream> CompressedFile::open(const std::string &fileName) {
+  const std::string diskFileName = resolve(fileName);
+  if (diskFileName.empty()) {
+    throw std::runtime_error("Error: Cannot open file: " + fileName);
+  }
+
+  auto file = std::make_unique<std::ifstream>(diskFileName, std::ios::binary);
+  if (!file->is_open()) {
+    throw std::runtime_error("Error: Cannot open file: " + diskFileName);
+  }
+  char magic[2] = {0, 0};
+  file->read(magic, 2);
+  if (file->gcount() == 2 && static_cast<unsigned char>(magic[0]) == 0x1f &&
+      static_cast<unsigned char>(magic[1]) == 0x8b) {
+    return std::make_unique<std::istringstream>(
+        inflateMembers(readRaw(diskFileName), diskFileName));
+  }
+  file->clear();
+  file->seekg(0);
+  return file;
+}
+
+GzipWriter::GzipWriter(std::ostream &out, int level, std::size_t blockSize)
+    : out_(out), level_(level), blockSize_(std::max<std::size_t>(blockSize, 1)),
+      maxBlocks_(1) {
+#ifdef _OPENMP
+  maxBlocks_ = static_cast<std::size_t>(omp_get_max_threads());
+#endif
+  blocks_.reserve(maxBlocks_);
+}
+
+void GzipWriter::write(std::string_view data) {
+  nBytesIn_ += data.size();
+  while (!data.empty()) {
+    if (blocks_.empty() || blocks_.back().size() == blockSize_) {
+      if (blocks_.size() == maxBlocks_) {
+        compressBlocks();
+      }
+      blocks_.emplace_back();
+      blocks_.back().reserve(blockSize_);
+    }
+    const std::size_t nBytes =
+        std::min(data.size(), blockSize_ - blocks_.back().size());
+    blocks_.back().append(data.substr(0, nBytes));
+    data.remove_prefix(nBytes);
+  }
+}
+
+void GzipWriter::finish() {
+  // An empty file still needs one member
+  if (blocks_.empty() && !wroteMember_) {
+    blocks_.emplace_back();
+  }
+  compressBlocks();
+  out_.flush();
+}
+
+void GzipWriter::compressBlocks() {
+  // Errors are collected and thrown outside of the parallel region
+  std::vector<std::string> members(blocks_.size());
+  std::vector<char> compressed(blocks_.size(), 0);
+  const auto nBlocks = static_cast<std::ptrdiff_t>(blocks_.size());
+#pragma omp parallel for schedule(dynamic)
+  for (std::ptrdiff_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+    compressed[iBlock] = deflateMember(blocks_[iBlock], level_, members[iBlock]);
+  }
+  if (std::count(compressed.begin(), compressed.end(), 0) > 0) {
+    throw std::runtime_error("Error: gzip compression failed");
+  }
+
+  for (const std::string &member : members) {
+    out_.write(member.data(), static_cast<std::streamsize>(member.size()));
+    nBytesOut_ += member.size();
+  }
+  wroteMember_ = wroteMember_ || !members.empty();
+  blocks_.clear();
+}
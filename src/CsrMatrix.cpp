@@ -0,0 +1,116 @@
+#include "CsrMatrix.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+template <typename ValueType, typename IndexType>
+CsrMatrix<ValueType, IndexType>::CsrMatrix(
+    const gko::matrix_data<ValueType, IndexType> &data)
+    : nRows_(data.size[0])
+{
+  if (data.size[0] != data.size[1]) {
+    throw std::invalid_argument("CsrMatrix requires a square matrix");
+  }
+
+  // Count the entries of each row
+  rowPtrs_.assign(nRows_ + 1, 0);
+  for (const auto &nonzero : data.nonzeros) {
+    rowPtrs_[nonzero.row + 1]++;
+  }
+  std::partial_sum(rowPtrs_.begin(), rowPtrs_.end(), rowPtrs_.begin());
+
+  // Scatter the entries into their rows
+  std::vector<IndexType> next(rowPtrs_.begin(), rowPtrs_.end() - 1);
+  std::vector<std::pair<IndexType, ValueType>> entries(data.nonzeros.size());
+  for (const auto &nonzero : data.nonzeros) {
+    entries[next[nonzero.row]++] = {nonzero.column, nonzero.value};
+  }
+
+  // Sort each row by column and sum duplicated entries
+  colIdxs_.reserve(entries.size());
+  values_.reserve(entries.size());
+  std::vector<IndexType> compressedRowPtrs(nRows_ + 1, 0);
+  for (std::size_t iRow = 0; iRow < nRows_; ++iRow) {
+    auto rowBegin = entries.begin() + rowPtrs_[iRow];
+    auto rowEnd = entries.begin() + rowPtrs_[iRow + 1];
+    std::sort(rowBegin, rowEnd, [](const auto &a, const auto &b) {
+      return a.first < b.first;
+    });
+    for (auto entry = rowBegin; entry != rowEnd; ++entry) {
+      if (static_cast<IndexType>(colIdxs_.size()) >
+              compressedRowPtrs[iRow] &&
+          colIdxs_.back() == entry->first) {
+        values_.back() += entry->second;
+      } else {
+        colIdxs_.push_back(entry->first);
+        values_.push_back(entry->second);
+      }
+    }
+    compressedRowPtrs[iRow + 1] = static_cast<IndexType>(colIdxs_.size());
+  }
+  rowPtrs_ = std::move(compressedRowPtrs);
+}
+
+template <typename ValueType, typename IndexType>
+CsrMatrix<ValueType, IndexType>::CsrMatrix(std::vector<IndexType> rowPtrs,
+                                           std::vector<IndexType> colIdxs,
+                                           std::vector<ValueType> values)
+    : nRows_(rowPtrs.size() - 1), rowPtrs_(std::move(rowPtrs)),
+      colIdxs_(std::move(colIdxs)), values_(std::move(values))
+{
+  if (colIdxs_.size() != values_.size() ||
+      static_cast<std::size_t>(rowPtrs_.back()) != colIdxs_.size()) {
+    throw std::invalid_argument("Inconsistent CSR arrays");
+  }
+}
+
+template <typename ValueType, typename IndexType>
+void CsrMatrix<ValueType, IndexType>::apply(const ValueType *x,
+                                            ValueType *y) const
+{
+  apply(x, y, 0, nRows_);
+}
+
+template <typename ValueType, typename IndexType>
+void CsrMatrix<ValueType, IndexType>::apply(const ValueType *x, ValueType *y,
+                                            std::size_t rowBegin,
+                                            std::size_t rowEnd) const
+{
+  const auto begin = static_cast<std::ptrdiff_t>(rowBegin);
+  const auto end = static_cast<std::ptrdiff_t>(rowEnd);
+#pragma omp parallel for schedule(static)
+  for (std::ptrdiff_t iRow = begin; iRow < end; ++iRow) {
+    ValueType sum = 0.0;
+    for (IndexType k = rowPtrs_[iRow]; k < rowPtrs_[iRow + 1]; ++k) {
+      sum += values_[k] * x[colIdxs_[k]];
+    }
+    y[iRow] = sum;
+  }
+}
+
+template <typename ValueType, typename IndexType>
+std::vector<ValueType> CsrMatrix<ValueType, IndexType>::diagonal() const
+{
+  std::vector<ValueType> diag(nRows_, 0.0);
+  for (std::size_t iRow = 0; iRow < nRows_; ++iRow) {
+    for (IndexType k = rowPtrs_[iRow]; k < rowPtrs_[iRow + 1]; ++k) {
+      if (static_cast<std::size_t>(colIdxs_[k]) == iRow) {
+        diag[iRow] = values_[k];
+      }
+    }
+  }
+  return diag;
+}
+
+template <typename ValueType, typename IndexType>
+bool CsrMatrix<ValueType, IndexType>::samePattern(
+    const CsrMatrix &other) const
+{
+  return nRows_ == other.nRows_ && rowPtrs_ == other.rowPtrs_ &&
+         colIdxs_ == other.colIdxs_;
+}
+
+// Explicit template instantiation for commonly used types
+template class CsrMatrix<double, int>;
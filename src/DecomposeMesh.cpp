@@ -0,0 +1,656 @@
+#include "DecomposeMesh.hpp"
+#include "CompressedFile.hpp"
+#include "FoamTokenizer.hpp"
+#include "Graph.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+using namespace std::string_literals;
+
+namespace {
+
+// ****** Geometric splitting ******
+// Split sorted cells into nParts contiguous groups of (nearly) equal size
+std::size_t equalCountGroup(std::size_t rank, std::size_t nItems,
+                            std::size_t nParts)
+{
+  return rank * nParts / nItems;
+}
+
+// ****** Multilevel graph bisection ******
+struct WeightedGraph
+{
+  std::vector<std::size_t> adjPtrs{0};
+  std::vector<std::size_t> adjacency;
+  std::vector<std::size_t> edgeWeights;
+  std::vector<std::size_t> vertexWeights;
+
+  std::size_t nVertices() const { return vertexWeights.size(); }
+};
+
+// Subgraph induced by the given vertices with unit weights
+WeightedGraph inducedSubgraph(const Graph &graph,
+                              const std::vector<std::size_t> &vertices,
+                              std::vector<std::size_t> &position)
+{
+  constexpr std::size_t outside = std::numeric_limits<std::size_t>::max();
+  for (std::size_t i = 0; i < vertices.size(); ++i) {
+    position[vertices[i]] = i;
+  }
+
+  WeightedGraph subgraph;
+  subgraph.vertexWeights.assign(vertices.size(), 1);
+  for (const std::size_t v : vertices) {
+    for (std::size_t k = graph.adjPtrs()[v]; k < graph.adjPtrs()[v + 1]; ++k) {
+      const std::size_t w = graph.adjacency()[k];
+      if (position[w] != outside) {
+        subgraph.adjacency.push_back(position[w]);
+        subgraph.edgeWeights.push_back(1);
+      }
+    }
+    subgraph.adjPtrs.push_back(subgraph.adjacency.size());
+  }
+
+  for (const std::size_t v : vertices) {
+    position[v] = outside;
+  }
+  return subgraph;
+}
+
+// Contract a heavy-edge matching. coarseMap maps fine to coarse vertices.
+WeightedGraph coarsen(const WeightedGraph &graph, std::mt19937 &generator,
+                      std::vector<std::size_t> &coarseMap)
+{
+  constexpr std::size_t unmatched = std::numeric_limits<std::size_t>::max();
+  const std::size_t nVertices = graph.nVertices();
+
+  std::vector<std::size_t> visitOrder(nVertices);
+  std::iota(visitOrder.begin(), visitOrder.end(), 0);
+  std::shuffle(visitOrder.begin(), visitOrder.end(), generator);
+
+  std::vector<std::size_t> match(nVertices, unmatched);
+  for (const std::size_t v : visitOrder) {
+    if (match[v] != unmatched) {
+      continue;
+    }
+    std::size_t partner = v;
+    std::size_t heaviest = 0;
+    for (std::size_t k = graph.adjPtrs[v]; k < graph.adjPtrs[v + 1]; ++k) {
+      const std::size_t w = graph.adjacency[k];
+      if (match[w] == unmatched && w != v && graph.edgeWeights[k] > heaviest) {
+        heaviest = graph.edgeWeights[k];
+        partner = w;
+      }
+    }
+    match[v] = partner;
+    match[partner] = v;
+  }
+
+  coarseMap.assign(nVertices, unmatched);
+  std::vector<std::size_t> representatives;
+  for (std::size_t v = 0; v < nVertices; ++v) {
+    if (coarseMap[v] == unmatched) {
+      coarseMap[v] = representatives.size();
+      coarseMap[match[v]] = representatives.size();
+      representatives.push_back(v);
+    }
+  }
+
+  // Merge the edges of both matched vertices
+  WeightedGraph coarse;
+  const std::size_t nCoarse = representatives.size();
+  coarse.vertexWeights.resize(nCoarse);
+  std::vector<std::size_t> edgePosition(nCoarse, unmatched);
+  for (std::size_t c = 0; c < nCoarse; ++c) {
+    const std::size_t rowBegin = coarse.adjacency.size();
+    const std::size_t v = representatives[c];
+    const std::size_t members[2] = {v, match[v]};
+    const std::size_t nMembers = match[v] == v ? 1 : 2;
+    coarse.vertexWeights[c] = 0;
+    for (std::size_t iMember = 0; iMember < nMembers; ++iMember) {
+      const std::size_t u = members[iMember];
+      coarse.vertexWeights[c] += graph.vertexWeights[u];
+      for (std::size_t k = graph.adjPtrs[u]; k < graph.adjPtrs[u + 1]; ++k) {
+        const std::size_t d = coarseMap[graph.adjacency[k]];
+        if (d == c) {
+          continue;
+        }
+        if (edgePosition[d] == unmatched) {
+          edgePosition[d] = coarse.adjacency.size();
+          coarse.adjacency.push_back(d);
+          coarse.edgeWeights.push_back(0);
+        }
+        coarse.edgeWeights[edgePosition[d]] += graph.edgeWeights[k];
+      }
+    }
+    for (std::size_t k = rowBegin; k < coarse.adjacency.size(); ++k) {
+      edgePosition[coarse.adjacency[k]] = unmatched;
+    }
+    coarse.adjPtrs.push_back(coarse.adjacency.size());
+  }
+  return coarse;
+}
+
+// Reduction of the cut weight when v moves to the other side
+long long moveGain(const WeightedGraph &graph, const std::vector<int> &side,
+                   std::size_t v)
+{
+  long long gain = 0;
+  for (std::size_t k = graph.adjPtrs[v]; k < graph.adjPtrs[v + 1]; ++k) {
+    const auto weight = static_cast<long long>(graph.edgeWeights[k]);
+    gain += side[graph.adjacency[k]] != side[v] ? weight : -weight;
+  }
+  return gain;
+}
+
+std::size_t cutWeight(const WeightedGraph &graph, const std::vector<int> &side)
+{
+  std::size_t cut = 0;
+  for (std::size_t v = 0; v < graph.nVertices(); ++v) {
+    for (std::size_t k = graph.adjPtrs[v]; k < graph.adjPtrs[v + 1]; ++k) {
+      if (side[graph.adjacency[k]] != side[v]) {
+        cut += graph.edgeWeights[k];
+      }
+    }
+  }
+  return cut / 2;
+}
+
+// Greedy boundary refinement: first restore the balance with the best moves
+// out of the heavier side, then move vertices with positive gain as long as
+// the balance stays within the tolerance
+void refineBisection(const WeightedGraph &graph, std::vector<int> &side,
+                     const double targetWeight, const double tolerance)
+{
+  const std::size_t nVertices = graph.nVertices();
+  double weight0 = 0.0;
+  for (std::size_t v = 0; v < nVertices; ++v) {
+    if (side[v] == 0) {
+      weight0 += graph.vertexWeights[v];
+    }
+  }
+
+  for (std::size_t iMove = 0;
+       iMove < nVertices && std::abs(weight0 - targetWeight) > tolerance;
+       ++iMove) {
+    const int heavySide = weight0 > targetWeight ? 0 : 1;
+    std::size_t best = nVertices;
+    long long bestGain = std::numeric_limits<long long>::min();
+    for (std::size_t v = 0; v < nVertices; ++v) {
+      if (side[v] == heavySide) {
+        const long long gain = moveGain(graph, side, v);
+        if (gain > bestGain) {
+          bestGain = gain;
+          best = v;
+        }
+      }
+    }
+    if (best == nVertices) {
+      break;
+    }
+    const double moved = graph.vertexWeights[best];
+    const double newWeight0 = heavySide == 0 ? weight0 - moved : weight0 + moved;
+    if (std::abs(newWeight0 - targetWeight) >= std::abs(weight0 - targetWeight)) {
+      break;
+    }
+    side[best] = 1 - heavySide;
+    weight0 = newWeight0;
+  }
+
+  const std::size_t maxPasses = 8;
+  for (std::size_t iPass = 0; iPass < maxPasses; ++iPass) {
+    bool moved = false;
+    for (std::size_t v = 0; v < nVertices; ++v) {
+      const long long gain = moveGain(graph, side, v);
+      if (gain <= 0) {
+        continue;
+      }
+      const double vertexWeight = graph.vertexWeights[v];
+      const double newWeight0 =
+          side[v] == 0 ? weight0 - vertexWeight : weight0 + vertexWeight;
+      if (std::abs(newWeight0 - targetWeight) <= tolerance) {
+        side[v] = 1 - side[v];
+        weight0 = newWeight0;
+        moved = true;
+      }
+    }
+    if (!moved) {
+      break;
+    }
+  }
+}
+
+// Initial bisection of the coarsest graph: grow side 0 breadth-first from a
+// few seeds and keep the refined split with the smallest cut
+std::vector<int> initialBisection(const WeightedGraph &graph,
+                                  const double targetWeight,
+                                  const double tolerance,
+                                  std::mt19937 &generator)
+{
+  const std::size_t nVertices = graph.nVertices();
+  const std::size_t nTrials = std::min<std::size_t>(4, nVertices);
+  std::uniform_int_distribution<std::size_t> randomVertex(0, nVertices - 1);
+
+  std::vector<int> bestSide(nVertices, 1);
+  std::size_t bestCut = std::numeric_limits<std::size_t>::max();
+  for (std::size_t iTrial = 0; iTrial < nTrials; ++iTrial) {
+    std::vector<int> side(nVertices, 1);
+    std::vector<bool> queued(nVertices, false);
+    std::vector<std::size_t> queue;
+    double weight0 = 0.0;
+    std::size_t head = 0;
+    std::size_t nextSeed = randomVertex(generator);
+    while (weight0 < targetWeight) {
+      if (head == queue.size()) {
+        // Continue in another component
+        while (queued[nextSeed]) {
+          nextSeed = (nextSeed + 1) % nVertices;
+        }
+        queue.push_back(nextSeed);
+        queued[nextSeed] = true;
+      }
+      const std::size_t v = queue[head++];
+      side[v] = 0;
+      weight0 += graph.vertexWeights[v];
+      for (std::size_t k = graph.adjPtrs[v]; k < graph.adjPtrs[v + 1]; ++k) {
+        const std::size_t w = graph.adjacency[k];
+        if (!queued[w]) {
+          queued[w] = true;
+          queue.push_back(w);
+        }
+      }
+    }
+
+    refineBisection(graph, side, targetWeight, tolerance);
+    const std::size_t cut = cutWeight(graph, side);
+    if (cut < bestCut) {
+      bestCut = cut;
+      bestSide = std::move(side);
+    }
+  }
+  return bestSide;
+}
+
+// Split a graph into two sides with the fraction of the vertex weight on
+// side 0
+std::vector<int> multilevelBisection(const WeightedGraph &graph,
+                                     const double fraction,
+                                     std::mt19937 &generator)
+{
+  const std::size_t coarsestSize = 64;
+
+  std::vector<WeightedGraph> levels{graph};
+  std::vector<std::vector<std::size_t>> coarseMaps;
+  while (levels.back().nVertices() > coarsestSize) {
+    std::vector<std::size_t> coarseMap;
+    WeightedGraph coarse = coarsen(levels.back(), generator, coarseMap);
+    if (coarse.nVertices() > 0.95 * levels.back().nVertices()) {
+      break;
+    }
+    coarseMaps.push_back(std::move(coarseMap));
+    levels.push_back(std::move(coarse));
+  }
+
+  const double totalWeight = std::accumulate(
+      graph.vertexWeights.begin(), graph.vertexWeights.end(), 0.0);
+  const double targetWeight = fraction * totalWeight;
+
+  // Allow 1% imbalance per bisection, but at least one coarse vertex
+  auto tolerance = [totalWeight](const WeightedGraph &level) {
+    const std::size_t heaviest = *std::max_element(
+        level.vertexWeights.begin(), level.vertexWeights.end());
+    return std::max(0.01 * totalWeight, static_cast<double>(heaviest));
+  };
+
+  std::vector<int> side = initialBisection(levels.back(), targetWeight,
+                                           tolerance(levels.back()), generator);
+  for (std::size_t iLevel = coarseMaps.size(); iLevel-- > 0;) {
+    const auto &coarseMap = coarseMaps[iLevel];
+    std::vector<int> fineSide(coarseMap.size());
+    for (std::size_t v = 0; v < coarseMap.size(); ++v) {
+      fineSide[v] = side[coarseMap[v]];
+    }
+    side = std::move(fineSide);
+    refineBisection(levels[iLevel], side, targetWeight,
+                    tolerance(levels[iLevel]));
+  }
+  return side;
+}
+
+// Recursive bisection into nParts parts numbered from firstPart
+void partitionRecursively(const Graph &graph, std::vector<std::size_t> vertices,
+                          const std::size_t nParts, const std::size_t firstPart,
+                          std::vector<std::size_t> &position,
+                          std::mt19937 &generator,
+                          std::vector<std::size_t> &cellToSubdomain)
+{
+  if (nParts == 1 || vertices.size() <= 1) {
+    for (const std::size_t v : vertices) {
+      cellToSubdomain[v] = firstPart;
+    }
+    return;
+  }
+
+  const std::size_t nFirst = nParts / 2;
+  const WeightedGraph subgraph = inducedSubgraph(graph, vertices, position);
+  const std::vector<int> side = multilevelBisection(
+      subgraph, static_cast<double>(nFirst) / nParts, generator);
+
+  std::vector<std::size_t> first;
+  std::vector<std::size_t> second;
+  for (std::size_t i = 0; i < vertices.size(); ++i) {
+    (side[i] == 0 ? first : second).push_back(vertices[i]);
+  }
+  vertices.clear();
+  vertices.shrink_to_fit();
+  partitionRecursively(graph, std::move(first), nFirst, firstPart, position,
+                       generator, cellToSubdomain);
+  partitionRecursively(graph, std::move(second), nParts - nFirst,
+                       firstPart + nFirst, position, generator,
+                       cellToSubdomain);
+}
+
+} // namespace
+
+void DecomposeMesh::readDecomposeParDict(Mesh &fvMesh)
+{
+  std::string dictFileName = fvMesh.caseDir() + "/system/decomposeParDict"s;
+
+  if (!CompressedFile::exists(dictFileName)) {
+    throw std::runtime_error("Error: decomposeParDict file '" + dictFileName + "' does not exist.");
+  }
+
+  FoamTokenizer tokens(dictFileName);
+  tokens.readHeader();
+  const auto entries = tokens.readDictionary();
+
+  auto entry = [&entries, &dictFileName](const std::string &key) {
+    const auto found = entries.find(key);
+    if (found == entries.end() || found->second.empty()) {
+      throw std::runtime_error("Error: entry '" + key + "' not found in '" + dictFileName + "'.");
+    }
+    return found->second;
+  };
+
+  nSubdomains_ = std::stoul(entry("numberOfSubdomains")[0]);
+  if (nSubdomains_ == 0) {
+    throw std::runtime_error("Error: numberOfSubdomains must be positive.");
+  }
+
+  const std::string methodName = entry("method")[0];
+  if (methodName == "simple") {
+    method_ = DecompositionMethod::simple;
+  } else if (methodName == "hierarchical") {
+    method_ = DecompositionMethod::hierarchical;
+  } else if (methodName == "rcb" || methodName == "recursiveBisection") {
+    method_ = DecompositionMethod::recursiveBisection;
+  } else if (methodName == "multiLevel" || methodName == "scotch" ||
+             methodName == "metis" || methodName == "kahip") {
+    method_ = DecompositionMethod::multilevel;
+  } else {
+    throw std::runtime_error("Error: decomposition method '" + methodName + "' is not supported.");
+  }
+
+  // Coefficients are either in "coeffs" or in "<method>Coeffs"
+  if (method_ == DecompositionMethod::simple ||
+      method_ == DecompositionMethod::hierarchical) {
+    std::string coeffs = "coeffs";
+    if (entries.count(coeffs + ".n") == 0) {
+      coeffs = methodName + "Coeffs";
+    }
+    const auto n = entry(coeffs + ".n");
+    if (n.size() != 3) {
+      throw std::runtime_error("Error: '" + coeffs + ".n' must have three entries.");
+    }
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      n_[iCoordinate] = std::stoul(n[iCoordinate]);
+    }
+    if (entries.count(coeffs + ".order") > 0) {
+      order_ = entry(coeffs + ".order")[0];
+    }
+  }
+}
+
+Decomposition DecomposeMesh::decompose(Mesh &fvMesh)
+{
+  std::vector<std::size_t> cellToSubdomain;
+  switch (method_) {
+  case DecompositionMethod::simple:
+    cellToSubdomain = simpleSplit(fvMesh);
+    break;
+  case DecompositionMethod::hierarchical:
+    cellToSubdomain = hierarchicalSplit(fvMesh);
+    break;
+  case DecompositionMethod::recursiveBisection:
+    cellToSubdomain = recursiveBisection(fvMesh);
+    break;
+  case DecompositionMethod::multilevel:
+    cellToSubdomain = multilevelPartition(fvMesh);
+    break;
+  }
+  return decompose(fvMesh, std::move(cellToSubdomain));
+}
+
+Decomposition DecomposeMesh::decompose(Mesh &fvMesh,
+                                       std::vector<std::size_t> cellToSubdomain)
+{
+  if (cellToSubdomain.size() != fvMesh.nCells()) {
+    throw std::invalid_argument("Subdomain map does not match the mesh cells");
+  }
+  for (std::size_t iSubdomain : cellToSubdomain) {
+    if (iSubdomain >= nSubdomains_) {
+      throw std::invalid_argument("Subdomain index out of range");
+    }
+  }
+
+  Decomposition decomposition;
+  decomposition.subdomains().resize(nSubdomains_);
+  decomposition.localIndex().resize(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    auto &cells = decomposition.subdomains()[cellToSubdomain[iElement]].cells();
+    decomposition.localIndex()[iElement] = cells.size();
+    cells.push_back(iElement);
+  }
+
+  // Interfaces grouped by neighbor; faces are visited in ascending order so
+  // both sides list them identically
+  std::vector<std::map<std::size_t, std::vector<std::size_t>>> interfaceFaces(
+      nSubdomains_);
+  for (std::size_t iFace = 0; iFace < fvMesh.nInteriorFaces(); ++iFace) {
+    const std::size_t ownerSubdomain =
+        cellToSubdomain[fvMesh.faces()[iFace].iOwner()];
+    const std::size_t neighborSubdomain =
+        cellToSubdomain[fvMesh.faces()[iFace].iNeighbor()];
+    if (ownerSubdomain != neighborSubdomain) {
+      decomposition.edgeCut()++;
+      interfaceFaces[ownerSubdomain][neighborSubdomain].push_back(iFace);
+      interfaceFaces[neighborSubdomain][ownerSubdomain].push_back(iFace);
+    }
+  }
+  for (std::size_t iSubdomain = 0; iSubdomain < nSubdomains_; ++iSubdomain) {
+    for (auto &[neighbor, faces] : interfaceFaces[iSubdomain]) {
+      decomposition.subdomains()[iSubdomain].interfaces().push_back(
+          {neighbor, std::move(faces)});
+    }
+  }
+
+  std::size_t maxCells = 0;
+  for (auto &subdomain : decomposition.subdomains()) {
+    maxCells = std::max(maxCells, subdomain.nCells());
+  }
+  decomposition.imbalance() = static_cast<double>(maxCells) * nSubdomains_ /
+                              static_cast<double>(fvMesh.nCells());
+  decomposition.cellToSubdomain() = std::move(cellToSubdomain);
+  return decomposition;
+}
+
+std::vector<std::size_t> DecomposeMesh::simpleSplit(Mesh &fvMesh)
+{
+  if (n_[0] * n_[1] * n_[2] != nSubdomains_) {
+    throw std::runtime_error("Error: n does not multiply to numberOfSubdomains.");
+  }
+
+  // Rank the cells in each direction independently
+  const std::size_t nCells = fvMesh.nCells();
+  std::array<std::vector<std::size_t>, 3> slab;
+  for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+    std::vector<std::size_t> sorted(nCells);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [&fvMesh, iCoordinate](std::size_t a, std::size_t b) {
+                       return fvMesh.cells()[a].centroid()[iCoordinate] <
+                              fvMesh.cells()[b].centroid()[iCoordinate];
+                     });
+    slab[iCoordinate].resize(nCells);
+    for (std::size_t rank = 0; rank < nCells; ++rank) {
+      slab[iCoordinate][sorted[rank]] =
+          equalCountGroup(rank, nCells, n_[iCoordinate]);
+    }
+  }
+
+  std::vector<std::size_t> cellToSubdomain(nCells);
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    cellToSubdomain[iElement] =
+        slab[0][iElement] +
+        n_[0] * (slab[1][iElement] + n_[1] * slab[2][iElement]);
+  }
+  return cellToSubdomain;
+}
+
+std::vector<std::size_t> DecomposeMesh::hierarchicalSplit(Mesh &fvMesh)
+{
+  if (n_[0] * n_[1] * n_[2] != nSubdomains_) {
+    throw std::runtime_error("Error: n does not multiply to numberOfSubdomains.");
+  }
+  if (order_.size() != 3 || !std::is_permutation(order_.begin(), order_.end(),
+                                                 std::string("xyz").begin())) {
+    throw std::runtime_error("Error: order must be a permutation of xyz.");
+  }
+
+  // Split into slabs along the first direction, then each slab along the
+  // second and each of those along the third
+  const std::size_t nCells = fvMesh.nCells();
+  std::array<std::vector<std::size_t>, 3> slab;
+  for (auto &indices : slab) {
+    indices.assign(nCells, 0);
+  }
+  std::vector<std::vector<std::size_t>> groups(1);
+  groups[0].resize(nCells);
+  std::iota(groups[0].begin(), groups[0].end(), 0);
+  for (const char direction : order_) {
+    const std::size_t iCoordinate = direction - 'x';
+    std::vector<std::vector<std::size_t>> subgroups;
+    for (auto &group : groups) {
+      std::stable_sort(group.begin(), group.end(),
+                       [&fvMesh, iCoordinate](std::size_t a, std::size_t b) {
+                         return fvMesh.cells()[a].centroid()[iCoordinate] <
+                                fvMesh.cells()[b].centroid()[iCoordinate];
+                       });
+      std::vector<std::vector<std::size_t>> split(n_[iCoordinate]);
+      for (std::size_t rank = 0; rank < group.size(); ++rank) {
+        const std::size_t iSlab =
+            equalCountGroup(rank, group.size(), n_[iCoordinate]);
+        slab[iCoordinate][group[rank]] = iSlab;
+        split[iSlab].push_back(group[rank]);
+      }
+      for (auto &part : split) {
+        subgroups.push_back(std::move(part));
+      }
+    }
+    groups = std::move(subgroups);
+  }
+
+  std::vector<std::size_t> cellToSubdomain(nCells);
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    cellToSubdomain[iElement] =
+        slab[0][iElement] +
+        n_[0] * (slab[1][iElement] + n_[1] * slab[2][iElement]);
+  }
+  return cellToSubdomain;
+}
+
+std::vector<std::size_t> DecomposeMesh::recursiveBisection(Mesh &fvMesh)
+{
+  std::vector<std::size_t> cellToSubdomain(fvMesh.nCells(), 0);
+
+  struct Task
+  {
+    std::vector<std::size_t> cells;
+    std::size_t nParts;
+    std::size_t firstPart;
+  };
+  std::vector<Task> tasks;
+  std::vector<std::size_t> all(fvMesh.nCells());
+  std::iota(all.begin(), all.end(), 0);
+  tasks.push_back({std::move(all), nSubdomains_, 0});
+
+  while (!tasks.empty()) {
+    Task task = std::move(tasks.back());
+    tasks.pop_back();
+    if (task.nParts == 1 || task.cells.size() <= 1) {
+      for (const std::size_t iElement : task.cells) {
+        cellToSubdomain[iElement] = task.firstPart;
+      }
+      continue;
+    }
+
+    // Cut across the longest extent of the centroids
+    std::array<double, 3> lower;
+    std::array<double, 3> upper;
+    lower.fill(std::numeric_limits<double>::max());
+    upper.fill(std::numeric_limits<double>::lowest());
+    for (const std::size_t iElement : task.cells) {
+      const auto &centroid = fvMesh.cells()[iElement].centroid();
+      for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+        lower[iCoordinate] = std::min(lower[iCoordinate], centroid[iCoordinate]);
+        upper[iCoordinate] = std::max(upper[iCoordinate], centroid[iCoordinate]);
+      }
+    }
+    std::size_t axis = 0;
+    for (std::size_t iCoordinate = 1; iCoordinate < 3; ++iCoordinate) {
+      if (upper[iCoordinate] - lower[iCoordinate] >
+          upper[axis] - lower[axis]) {
+        axis = iCoordinate;
+      }
+    }
+
+    const std::size_t nFirst = task.nParts / 2;
+    const std::size_t nFirstCells = task.cells.size() * nFirst / task.nParts;
+    std::nth_element(task.cells.begin(), task.cells.begin() + nFirstCells,
+                     task.cells.end(),
+                     [&fvMesh, axis](std::size_t a, std::size_t b) {
+                       return fvMesh.cells()[a].centroid()[axis] <
+                              fvMesh.cells()[b].centroid()[axis];
+                     });
+    std::vector<std::size_t> first(task.cells.begin(),
+                                   task.cells.begin() + nFirstCells);
+    std::vector<std::size_t> second(task.cells.begin() + nFirstCells,
+                                    task.cells.end());
+    tasks.push_back({std::move(second), task.nParts - nFirst,
+                     task.firstPart + nFirst});
+    tasks.push_back({std::move(first), nFirst, task.firstPart});
+  }
+  return cellToSubdomain;
+}
+
+std::vector<std::size_t> DecomposeMesh::multilevelPartition(Mesh &fvMesh)
+{
+  const Graph cellGraph(fvMesh);
+  std::vector<std::size_t> cellToSubdomain(fvMesh.nCells(), 0);
+  std::vector<std::size_t> position(fvMesh.nCells(),
+                                    std::numeric_limits<std::size_t>::max());
+  std::vector<std::size_t> all(fvMesh.nCells());
+  std::iota(all.begin(), all.end(), 0);
+
+  // Fixed seed so that the decomposition is reproducible
+  std::mt19937 generator(5489u);
+  partitionRecursively(cellGraph, std::move(all), nSubdomains_, 0, position,
+                       generator, cellToSubdomain);
+  return cellToSubdomain;
+}
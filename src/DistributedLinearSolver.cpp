@@ -0,0 +1,121 @@
+#include "DistributedLinearSolver.hpp"
+
+#if GINKGO_BUILD_MPI
+
+#include <algorithm>
+
+template <typename ValueType, typename GlobalIndexType>
+void DistributedLinearSolver::solve(
+    const gko::matrix_data<ValueType, GlobalIndexType> &ownedRows,
+    const std::vector<std::size_t> &cellToRank, std::vector<ValueType> &RHS,
+    std::vector<ValueType> &solVector,
+    gko::remove_complex<ValueType> reductionFactor,
+    std::size_t maxNumIterations) {
+  using part_type =
+      gko::experimental::distributed::Partition<int, GlobalIndexType>;
+  auto exec = gko::ReferenceExecutor::create();
+
+  // --- Row partition given by the mesh decomposition ---
+  const auto nGlobalRows = static_cast<gko::size_type>(cellToRank.size());
+  gko::array<gko::experimental::distributed::comm_index_type> mapping(
+      exec, nGlobalRows);
+  for (gko::size_type iRow = 0; iRow < nGlobalRows; ++iRow) {
+    mapping.get_data()[iRow] =
+        static_cast<gko::experimental::distributed::comm_index_type>(
+            cellToRank[iRow]);
+  }
+  solveOnPartition(
+      gko::share(part_type::build_from_mapping(exec, mapping, comm_.size())),
+      ownedRows, RHS, solVector, reductionFactor, maxNumIterations);
+}
+
+template <typename ValueType, typename GlobalIndexType>
+void DistributedLinearSolver::solve(
+    const gko::matrix_data<ValueType, GlobalIndexType> &ownedRows,
+    std::vector<ValueType> &RHS, std::vector<ValueType> &solVector,
+    gko::remove_complex<ValueType> reductionFactor,
+    std::size_t maxNumIterations) {
+  using part_type =
+      gko::experimental::distributed::Partition<int, GlobalIndexType>;
+  auto exec = gko::ReferenceExecutor::create();
+
+  // --- Row partition from the number of owned rows of every rank ---
+  const auto nRanks = static_cast<gko::size_type>(comm_.size());
+  const auto nLocalRows = static_cast<GlobalIndexType>(RHS.size());
+  std::vector<GlobalIndexType> rankRows(nRanks);
+  comm_.all_gather(exec, &nLocalRows, 1, rankRows.data(), 1);
+  gko::array<GlobalIndexType> ranges(exec, nRanks + 1);
+  ranges.get_data()[0] = 0;
+  for (gko::size_type iRank = 0; iRank < nRanks; ++iRank) {
+    ranges.get_data()[iRank + 1] = ranges.get_data()[iRank] + rankRows[iRank];
+  }
+  solveOnPartition(
+      gko::share(part_type::build_from_contiguous(exec, ranges)), ownedRows,
+      RHS, solVector, reductionFactor, maxNumIterations);
+}
+
+template <typename ValueType, typename GlobalIndexType>
+void DistributedLinearSolver::solveOnPartition(
+    std::shared_ptr<
+        gko::experimental::distributed::Partition<int, GlobalIndexType>>
+        partition,
+    const gko::matrix_data<ValueType, GlobalIndexType> &ownedRows,
+    std::vector<ValueType> &RHS, std::vector<ValueType> &solVector,
+    gko::remove_complex<ValueType> reductionFactor,
+    std::size_t maxNumIterations) {
+  using LocalIndexType = int;
+  using dist_mtx =
+      gko::experimental::distributed::Matrix<ValueType, LocalIndexType,
+                                             GlobalIndexType>;
+  using dist_vec = gko::experimental::distributed::Vector<ValueType>;
+  using schwarz = gko::experimental::distributed::preconditioner::Schwarz<
+      ValueType, LocalIndexType, GlobalIndexType>;
+  using bj = gko::preconditioner::Jacobi<ValueType, LocalIndexType>;
+  using cg = gko::solver::Cg<ValueType>;
+
+  auto exec = gko::ReferenceExecutor::create();
+
+  // --- Distributed matrix and vectors ---
+  const auto nGlobalRows =
+      static_cast<gko::size_type>(partition->get_size());
+  auto gko_coeffMatrix = gko::share(dist_mtx::create(exec, comm_));
+  gko_coeffMatrix->read_distributed(ownedRows, partition);
+
+  const auto nLocalRows = static_cast<gko::size_type>(RHS.size());
+  auto gko_RHS = dist_vec::create(exec, comm_, gko::dim<2>(nGlobalRows, 1),
+                                  gko::dim<2>(nLocalRows, 1));
+  auto gko_x = dist_vec::create(exec, comm_, gko::dim<2>(nGlobalRows, 1),
+                                gko::dim<2>(nLocalRows, 1));
+  std::copy(RHS.begin(), RHS.end(), gko_RHS->get_local_values());
+  std::copy(solVector.begin(), solVector.end(), gko_x->get_local_values());
+
+  // --- Generate and apply the solver ---
+  auto logger = gko::share(gko::log::Convergence<ValueType>::create());
+  auto solver =
+      cg::build()
+          .with_preconditioner(schwarz::build().with_local_solver(
+              bj::build().with_max_block_size(maxBlockSize_)))
+          .with_criteria(gko::stop::Iteration::build().with_max_iters(
+                             gko::size_type(maxNumIterations)),
+                         gko::stop::ResidualNorm<ValueType>::build()
+                             .with_reduction_factor(reductionFactor))
+          .on(exec)
+          ->generate(gko_coeffMatrix);
+  solver->add_logger(logger);
+  solver->apply(gko_RHS, gko_x);
+
+  nIterations_ = logger->get_num_iterations();
+  std::copy_n(gko_x->get_const_local_values(), nLocalRows, solVector.begin());
+}
+
+template void DistributedLinearSolver::solve(
+    const gko::matrix_data<double, std::int64_t> &ownedRows,
+    const std::vector<std::size_t> &cellToRank, std::vector<double> &RHS,
+    std::vector<double> &solVector, gko::remove_complex<double> reductionFactor,
+    std::size_t maxNumIterations);
+template void DistributedLinearSolver::solve(
+    const gko::matrix_data<double, std::int64_t> &ownedRows,
+    std::vector<double> &RHS, std::vector<double> &solVector,
+    gko::remove_complex<double> reductionFactor, std::size_t maxNumIterations);
+
+#endif // GINKGO_BUILD_MPI
@@ -0,0 +1,403 @@
+#include "DistributedMesh.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+DistributedMesh::DistributedMesh(Mesh &globalMesh,
+                                 Decomposition &decomposition,
+                                 std::size_t iSubdomain,
+                                 LocalCellOrdering ordering)
+    : localMesh_(globalMesh.caseDir()), nGlobalCells_(globalMesh.nCells())
+{
+  constexpr std::size_t notLocal = std::numeric_limits<std::size_t>::max();
+  const auto &cellToSubdomain = decomposition.cellToSubdomain();
+  auto isOwnedCell = [&cellToSubdomain, iSubdomain](std::size_t iElement) {
+    return cellToSubdomain[iElement] == iSubdomain;
+  };
+
+  // --- Cells: owned cells and their neighbors in other subdomains ---
+  for (const std::size_t iElement :
+       decomposition.subdomains()[iSubdomain].cells()) {
+    globalCells_.push_back(iElement);
+    for (const std::size_t iNeighbor :
+         globalMesh.cells()[iElement].iNeighbors()) {
+      if (!isOwnedCell(iNeighbor)) {
+        globalCells_.push_back(iNeighbor);
+      }
+    }
+  }
+  std::sort(globalCells_.begin(), globalCells_.end());
+  globalCells_.erase(std::unique(globalCells_.begin(), globalCells_.end()),
+                     globalCells_.end());
+
+  // Owned cells next to a halo cell need the exchanged values
+  auto isInterfaceCell = [&](std::size_t iElement) {
+    for (const std::size_t iNeighbor :
+         globalMesh.cells()[iElement].iNeighbors()) {
+      if (!isOwnedCell(iNeighbor)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  for (const std::size_t iElement :
+       decomposition.subdomains()[iSubdomain].cells()) {
+    if (!isInterfaceCell(iElement)) {
+      nInteriorCells_++;
+    }
+  }
+  if (ordering == LocalCellOrdering::interiorFirst) {
+    auto interfaceBegin = std::stable_partition(
+        globalCells_.begin(), globalCells_.end(), [&](std::size_t iElement) {
+          return isOwnedCell(iElement) && !isInterfaceCell(iElement);
+        });
+    std::stable_partition(interfaceBegin, globalCells_.end(),
+                          isOwnedCell);
+  }
+
+  std::vector<std::size_t> localCell(globalMesh.nCells(), notLocal);
+  isOwned_.resize(globalCells_.size());
+  for (std::size_t iLocal = 0; iLocal < globalCells_.size(); ++iLocal) {
+    localCell[globalCells_[iLocal]] = iLocal;
+    isOwned_[iLocal] = isOwnedCell(globalCells_[iLocal]);
+  }
+  for (const std::size_t iElement :
+       decomposition.subdomains()[iSubdomain].cells()) {
+    ownedCells_.push_back(localCell[iElement]);
+  }
+
+  // --- Halo exchange lists from the interface faces ---
+  for (auto &interface : decomposition.subdomains()[iSubdomain].interfaces()) {
+    HaloExchange exchange;
+    exchange.neighbor = interface.neighbor;
+    for (const std::size_t iFace : interface.faces) {
+      std::size_t iOwned = globalMesh.faces()[iFace].iOwner();
+      std::size_t iHalo = globalMesh.faces()[iFace].iNeighbor();
+      if (!isOwnedCell(iOwned)) {
+        std::swap(iOwned, iHalo);
+      }
+      exchange.sendCells.push_back(iOwned);
+      exchange.receiveCells.push_back(iHalo);
+    }
+    for (auto *cells : {&exchange.sendCells, &exchange.receiveCells}) {
+      std::sort(cells->begin(), cells->end());
+      cells->erase(std::unique(cells->begin(), cells->end()), cells->end());
+      for (auto &iElement : *cells) {
+        iElement = localCell[iElement];
+      }
+    }
+    haloExchanges_.push_back(std::move(exchange));
+  }
+
+  // --- Faces: all faces of the owned cells in global order ---
+  for (std::size_t iFace = 0; iFace < globalMesh.nInteriorFaces(); ++iFace) {
+    Face &theFace = globalMesh.faces()[iFace];
+    if (isOwnedCell(theFace.iOwner()) || isOwnedCell(theFace.iNeighbor())) {
+      globalFaces_.push_back(iFace);
+    }
+  }
+  localMesh_.nInteriorFaces() = globalFaces_.size();
+
+  localMesh_.nBoundaries() = globalMesh.nBoundaries();
+  localMesh_.nPatches() = globalMesh.nPatches();
+  localMesh_.boundaries() = globalMesh.boundaries();
+  for (auto &boundary : localMesh_.boundaries()) {
+    const std::size_t startFace = boundary.startFace();
+    const std::size_t nFaces = boundary.nFaces();
+    boundary.startFace() = globalFaces_.size();
+    for (std::size_t iFace = startFace; iFace < startFace + nFaces; ++iFace) {
+      if (isOwnedCell(globalMesh.faces()[iFace].iOwner())) {
+        globalFaces_.push_back(iFace);
+      }
+    }
+    boundary.nFaces() = globalFaces_.size() - boundary.startFace();
+  }
+
+  // --- Nodes: those used by the local faces, in global order ---
+  std::vector<std::size_t> globalNodes;
+  for (const std::size_t iFace : globalFaces_) {
+    const auto &iNodes = globalMesh.faces()[iFace].iNodes();
+    globalNodes.insert(globalNodes.end(), iNodes.begin(), iNodes.end());
+  }
+  std::sort(globalNodes.begin(), globalNodes.end());
+  globalNodes.erase(std::unique(globalNodes.begin(), globalNodes.end()),
+                    globalNodes.end());
+  std::vector<std::size_t> localNode(globalMesh.nNodes(), notLocal);
+  for (std::size_t iLocal = 0; iLocal < globalNodes.size(); ++iLocal) {
+    localNode[globalNodes[iLocal]] = iLocal;
+  }
+
+  // --- Copy the processed entities and renumber their references ---
+  localMesh_.nNodes() = globalNodes.size();
+  localMesh_.nodes().resize(globalNodes.size());
+  for (std::size_t iLocal = 0; iLocal < globalNodes.size(); ++iLocal) {
+    Node &theNode = localMesh_.nodes()[iLocal];
+    theNode = globalMesh.nodes()[globalNodes[iLocal]];
+    theNode.index() = iLocal;
+    theNode.iFaces().clear();
+    theNode.iCells().clear();
+  }
+
+  localMesh_.nFaces() = globalFaces_.size();
+  localMesh_.nOwners() = globalFaces_.size();
+  localMesh_.faces().resize(globalFaces_.size());
+  for (std::size_t iLocal = 0; iLocal < globalFaces_.size(); ++iLocal) {
+    Face &theFace = localMesh_.faces()[iLocal];
+    theFace = globalMesh.faces()[globalFaces_[iLocal]];
+    theFace.index() = iLocal;
+    theFace.iOwner() = static_cast<int>(localCell[theFace.iOwner()]);
+    if (theFace.iNeighbor() != -1) {
+      theFace.iNeighbor() = static_cast<int>(localCell[theFace.iNeighbor()]);
+    }
+    for (auto &iNode : theFace.iNodes()) {
+      iNode = localNode[iNode];
+    }
+  }
+
+  localMesh_.nCells() = globalCells_.size();
+  localMesh_.cells().resize(globalCells_.size());
+  for (std::size_t iLocal = 0; iLocal < globalCells_.size(); ++iLocal) {
+    Cell &theCell = localMesh_.cells()[iLocal];
+    theCell = globalMesh.cells()[globalCells_[iLocal]];
+    theCell.index() = iLocal;
+    theCell.iFaces().clear();
+    theCell.iNeighbors().clear();
+    theCell.faceSigns().clear();
+    theCell.iNodes().clear();
+  }
+
+  MeshReader.constructConnectivity(localMesh_);
+  MeshProcessor.collectBoundaryGeometry(localMesh_);
+}
+
+DistributedMesh::DistributedMesh(Mesh &&localMesh,
+                                 std::vector<std::size_t> globalCells,
+                                 const std::vector<std::size_t> &cellSubdomains,
+                                 std::size_t iSubdomain,
+                                 std::size_t nGlobalCells)
+    : localMesh_(std::move(localMesh)), globalCells_(std::move(globalCells)),
+      nGlobalCells_(nGlobalCells)
+{
+  if (globalCells_.size() != localMesh_.nCells() ||
+      cellSubdomains.size() != localMesh_.nCells()) {
+    throw std::invalid_argument(
+        "Error: The local mesh has " + std::to_string(localMesh_.nCells()) +
+        " cells but " + std::to_string(globalCells_.size()) +
+        " global indices and " + std::to_string(cellSubdomains.size()) +
+        " subdomains were given");
+  }
+  findOwnership(cellSubdomains, iSubdomain);
+}
+
+DistributedMesh::DistributedMesh(
+    Mesh &&piece, std::size_t firstGlobalCell,
+    const std::vector<ProcessorPatchCells> &patchCells,
+    std::size_t iSubdomain, std::size_t nGlobalCells)
+    : localMesh_(std::move(piece)), nGlobalCells_(nGlobalCells)
+{
+  const std::size_t nOwnedCells = localMesh_.nCells();
+  if (patchCells.size() != localMesh_.nBoundaries()) {
+    throw std::invalid_argument(
+        "Error: Cells for " + std::to_string(patchCells.size()) +
+        " patches were given for a piece with " +
+        std::to_string(localMesh_.nBoundaries()) + " patches");
+  }
+  for (std::size_t iLocal = 0; iLocal < nOwnedCells; ++iLocal) {
+    globalCells_.push_back(firstGlobalCell + iLocal);
+  }
+  std::vector<std::size_t> cellSubdomains(nOwnedCells, iSubdomain);
+
+  // --- Halo cells: one per distinct cell across the processor patches ---
+  std::map<std::size_t, std::size_t> haloCell;
+  std::vector<std::array<double, 3>> haloCentroids;
+  for (std::size_t iBoundary = 0; iBoundary < localMesh_.nBoundaries();
+       ++iBoundary) {
+    Boundary &boundary = localMesh_.boundaries()[iBoundary];
+    if (boundary.neighborProcessor() < 0) {
+      continue;
+    }
+    const ProcessorPatchCells &cells = patchCells[iBoundary];
+    if (cells.globalCells.size() != boundary.nFaces() ||
+        cells.centroids.size() != boundary.nFaces()) {
+      throw std::invalid_argument(
+          "Error: Processor patch " + boundary.userName() + " has " +
+          std::to_string(boundary.nFaces()) + " faces but " +
+          std::to_string(cells.globalCells.size()) + " cells were received");
+    }
+    for (std::size_t i = 0; i < boundary.nFaces(); ++i) {
+      if (haloCell.emplace(cells.globalCells[i], globalCells_.size()).second) {
+        globalCells_.push_back(cells.globalCells[i]);
+        cellSubdomains.push_back(boundary.neighborProcessor());
+        haloCentroids.push_back(cells.centroids[i]);
+      }
+    }
+  }
+
+  // --- Faces: interior faces, processor patch faces, remaining patches ---
+  std::vector<Face> faces(localMesh_.faces().begin(),
+                          localMesh_.faces().begin() +
+                              localMesh_.nInteriorFaces());
+  std::vector<std::size_t> convertedFaces;
+  for (std::size_t iBoundary = 0; iBoundary < localMesh_.nBoundaries();
+       ++iBoundary) {
+    Boundary &boundary = localMesh_.boundaries()[iBoundary];
+    if (boundary.neighborProcessor() < 0) {
+      continue;
+    }
+    for (std::size_t i = 0; i < boundary.nFaces(); ++i) {
+      Face theFace = localMesh_.faces()[boundary.startFace() + i];
+      theFace.iNeighbor() =
+          static_cast<int>(haloCell[patchCells[iBoundary].globalCells[i]]);
+      theFace.patchIndex() = -1;
+      theFace.walldist() = 0.0;
+      convertedFaces.push_back(faces.size());
+      faces.push_back(std::move(theFace));
+    }
+  }
+  const std::size_t nInteriorFaces = faces.size();
+
+  std::vector<Boundary> boundaries;
+  for (auto &boundary : localMesh_.boundaries()) {
+    if (boundary.neighborProcessor() >= 0) {
+      continue;
+    }
+    const std::size_t startFace = boundary.startFace();
+    boundary.startFace() = faces.size();
+    boundary.index() = boundaries.size();
+    for (std::size_t iFace = startFace; iFace < startFace + boundary.nFaces();
+         ++iFace) {
+      faces.push_back(localMesh_.faces()[iFace]);
+      faces.back().patchIndex() = static_cast<int>(boundaries.size());
+    }
+    boundaries.push_back(boundary);
+  }
+  for (std::size_t iFace = 0; iFace < faces.size(); ++iFace) {
+    faces[iFace].index() = iFace;
+  }
+
+  localMesh_.faces() = std::move(faces);
+  localMesh_.nFaces() = localMesh_.faces().size();
+  localMesh_.nOwners() = localMesh_.faces().size();
+  localMesh_.nInteriorFaces() = nInteriorFaces;
+  localMesh_.boundaries() = std::move(boundaries);
+  localMesh_.nBoundaries() = localMesh_.boundaries().size();
+  localMesh_.nPatches() = localMesh_.boundaries().size();
+
+  // --- Cells and nodes: rebuild the connectivity with the halo cells ---
+  localMesh_.nCells() = globalCells_.size();
+  localMesh_.cells().resize(globalCells_.size());
+  for (std::size_t iLocal = 0; iLocal < localMesh_.nCells(); ++iLocal) {
+    Cell &theCell = localMesh_.cells()[iLocal];
+    theCell.index() = iLocal;
+    theCell.iFaces().clear();
+    theCell.iNeighbors().clear();
+    theCell.faceSigns().clear();
+    theCell.iNodes().clear();
+    if (iLocal >= nOwnedCells) {
+      theCell.centroid() = haloCentroids[iLocal - nOwnedCells];
+    }
+  }
+  for (auto &theNode : localMesh_.nodes()) {
+    theNode.iFaces().clear();
+    theNode.iCells().clear();
+  }
+
+  MeshReader.constructConnectivity(localMesh_);
+  MeshProcessor.updateSecondaryFaceGeometry(localMesh_, convertedFaces);
+  MeshProcessor.collectBoundaryGeometry(localMesh_);
+  findOwnership(cellSubdomains, iSubdomain);
+}
+
+ProcessorPatchCells
+DistributedMesh::processorPatchCells(Mesh &piece, std::size_t iBoundary,
+                                     std::size_t firstGlobalCell)
+{
+  Boundary &boundary = piece.boundaries()[iBoundary];
+  ProcessorPatchCells cells;
+  for (std::size_t i = 0; i < boundary.nFaces(); ++i) {
+    const std::size_t iOwner = piece.faces()[boundary.startFace() + i].iOwner();
+    cells.globalCells.push_back(firstGlobalCell + iOwner);
+    cells.centroids.push_back(piece.cells()[iOwner].centroid());
+  }
+  return cells;
+}
+
+void DistributedMesh::findOwnership(
+    const std::vector<std::size_t> &cellSubdomains, std::size_t iSubdomain)
+{
+  const std::size_t nLocalCells = localMesh_.nCells();
+  isOwned_.resize(nLocalCells);
+  for (std::size_t iLocal = 0; iLocal < nLocalCells; ++iLocal) {
+    isOwned_[iLocal] = cellSubdomains[iLocal] == iSubdomain;
+    if (isOwned_[iLocal]) {
+      ownedCells_.push_back(iLocal);
+    }
+  }
+  auto byGlobalIndex = [this](std::size_t a, std::size_t b) {
+    return globalCells_[a] < globalCells_[b];
+  };
+  std::sort(ownedCells_.begin(), ownedCells_.end(), byGlobalIndex);
+
+  // --- Halo exchange lists from the neighbors of the owned cells ---
+  std::map<std::size_t, HaloExchange> exchanges;
+  for (const std::size_t iOwned : ownedCells_) {
+    bool isInterfaceCell = false;
+    for (const std::size_t iNeighbor :
+         localMesh_.cells()[iOwned].iNeighbors()) {
+      if (!isOwned_[iNeighbor]) {
+        isInterfaceCell = true;
+        HaloExchange &exchange = exchanges[cellSubdomains[iNeighbor]];
+        exchange.neighbor = cellSubdomains[iNeighbor];
+        exchange.sendCells.push_back(iOwned);
+        exchange.receiveCells.push_back(iNeighbor);
+      }
+    }
+    if (!isInterfaceCell) {
+      nInteriorCells_++;
+    }
+  }
+  for (auto &[neighbor, exchange] : exchanges) {
+    for (auto *cells : {&exchange.sendCells, &exchange.receiveCells}) {
+      std::sort(cells->begin(), cells->end(), byGlobalIndex);
+      cells->erase(std::unique(cells->begin(), cells->end()), cells->end());
+    }
+    haloExchanges_.push_back(std::move(exchange));
+  }
+}
+
+template <typename IndexType>
+gko::matrix_data<double, IndexType> DistributedMesh::ownedRows(
+    const gko::matrix_data<double, int> &localMatrix) const
+{
+  gko::matrix_data<double, IndexType> globalMatrix(
+      gko::dim<2>(nGlobalCells_, nGlobalCells_));
+  for (const auto &nonzero : localMatrix.nonzeros) {
+    if (isOwned_[nonzero.row]) {
+      globalMatrix.nonzeros.emplace_back(
+          static_cast<IndexType>(globalCells_[nonzero.row]),
+          static_cast<IndexType>(globalCells_[nonzero.column]),
+          nonzero.value);
+    }
+  }
+  return globalMatrix;
+}
+
+std::vector<double>
+DistributedMesh::ownedValues(const std::vector<double> &localValues) const
+{
+  std::vector<double> values(ownedCells_.size());
+  for (std::size_t i = 0; i < ownedCells_.size(); ++i) {
+    values[i] = localValues[ownedCells_[i]];
+  }
+  return values;
+}
+
+// Explicit template instantiation for commonly used types
+template gko::matrix_data<double, int> DistributedMesh::ownedRows(
+    const gko::matrix_data<double, int> &localMatrix) const;
+template gko::matrix_data<double, std::int64_t> DistributedMesh::ownedRows(
+    const gko::matrix_data<double, int> &localMatrix) const;
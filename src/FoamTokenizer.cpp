@@ -0,0 +1,380 @@
+#include "FoamTokenizer.hpp"
+#include "CompressedFile.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv> // For decoding numbers without locale lookups
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+
+bool isPunctuation(char c) {
+  return c == '{' || c == '}' || c == '(' || c == ')' || c == '[' ||
+         c == ']' || c == ';';
+}
+
+bool isSpace(char c) { return std::isspace(static_cast<unsigned char>(c)); }
+
+double *components(double &value) { return &value; }
+
+template <std::size_t N> double *components(std::array<double, N> &value) {
+  return value.data();
+}
+
+} // namespace
+
+FoamTokenizer::FoamTokenizer(const std::string &fileName)
+    : FoamTokenizer(fileName, CompressedFile::read(fileName)) {}
+
+FoamTokenizer::FoamTokenizer(const std::string &fileName, std::string text,
+                             bool binary)
+    : binary_(binary) {
+  sources_.push_back({fileName, std::move(text), 0});
+}
+
+FoamToken FoamTokenizer::next() {
+  if (hasPeeked_) {
+    hasPeeked_ = false;
+    return std::move(peeked_);
+  }
+  return lex();
+}
+
+const FoamToken &FoamTokenizer::peek() {
+  if (!hasPeeked_) {
+    peeked_ = lex();
+    hasPeeked_ = true;
+  }
+  return peeked_;
+}
+
+void FoamTokenizer::expect(char c) {
+  const FoamToken token = next();
+  if (!token.is(c)) {
+    fail(std::string("Expected '") + c + "' but found '" + token.text + "'");
+  }
+}
+
+std::string FoamTokenizer::word() {
+  FoamToken token = next();
+  if (token.kind != FoamToken::Kind::word) {
+    fail("Expected a word but found '" + token.text + "'");
+  }
+  return std::move(token.text);
+}
+
+void FoamTokenizer::readHeader() {
+  if (!peek().is("FoamFile")) {
+    return;
+  }
+  next();
+  expect('{');
+  while (!peek().is('}')) {
+    const std::string keyword = word();
+    if (keyword == "format") {
+      binary_ = word() == "binary";
+      expect(';');
+    } else if (keyword == "arch") {
+      const FoamToken arch = next();
+      if (arch.text.find("MSB") != std::string::npos ||
+          arch.text.find("scalar=32") != std::string::npos) {
+        fail("Only little-endian double precision files are supported");
+      }
+      expect(';');
+    } else {
+      skipEntry();
+    }
+  }
+  expect('}');
+}
+
+void FoamTokenizer::skipEntry() {
+  std::size_t depth = 0;
+  for (;;) {
+    const FoamToken token = next();
+    if (token.kind == FoamToken::Kind::end) {
+      fail("Unexpected end of file");
+    }
+    if (token.is('{') || token.is('(') || token.is('[')) {
+      depth++;
+    } else if (token.is('}') || token.is(')') || token.is(']')) {
+      depth--;
+      // A dictionary entry ends with its closing brace
+      if (depth == 0 && token.is('}')) {
+        return;
+      }
+    } else if (depth == 0 && token.is(';')) {
+      return;
+    } else if (token.is("List<scalar>")) {
+      // Lists are skipped as a whole since they may be binary
+      std::vector<double> values;
+      readList(values);
+    } else if (token.is("List<vector>")) {
+      std::vector<std::array<double, 3>> values;
+      readList(values);
+    } else if (token.is("List<tensor>")) {
+      std::vector<std::array<double, 9>> values;
+      readList(values);
+    }
+  }
+}
+
+std::map<std::string, std::vector<std::string>>
+FoamTokenizer::readDictionary() {
+  std::map<std::string, std::vector<std::string>> entries;
+  std::vector<std::string> scope;
+  while (!atEnd()) {
+    if (peek().is('}')) {
+      if (scope.empty()) {
+        fail("Unmatched '}'");
+      }
+      next();
+      scope.pop_back();
+      continue;
+    }
+    std::string key;
+    for (const auto &block : scope) {
+      key += block + ".";
+    }
+    const std::string name = word();
+    key += name;
+
+    if (peek().is('{')) {
+      next();
+      scope.push_back(name);
+      continue;
+    }
+    std::vector<std::string> values;
+    while (!peek().is(';')) {
+      FoamToken token = next();
+      if (token.kind == FoamToken::Kind::end) {
+        fail("Unexpected end of file in entry " + key);
+      }
+      if (!token.is('(') && !token.is(')')) {
+        values.push_back(std::move(token.text));
+      }
+    }
+    next(); // Discard the semicolon
+    entries[key] = std::move(values);
+  }
+  if (!scope.empty()) {
+    fail("Unexpected end of file in dictionary " + scope.back());
+  }
+  return entries;
+}
+
+template <typename ValueType> ValueType FoamTokenizer::readValue() {
+  constexpr std::size_t nComponents = sizeof(ValueType) / sizeof(double);
+  ValueType value{};
+  double *component = components(value);
+  if constexpr (nComponents > 1) {
+    expect('(');
+  }
+  for (std::size_t i = 0; i < nComponents; ++i) {
+    const FoamToken token = next();
+    if (token.kind != FoamToken::Kind::number) {
+      fail("Expected a number but found '" + token.text + "'");
+    }
+    component[i] = token.number;
+  }
+  if constexpr (nComponents > 1) {
+    expect(')');
+  }
+  return value;
+}
+
+template <typename ValueType>
+void FoamTokenizer::readList(std::vector<ValueType> &values) {
+  constexpr std::size_t nComponents = sizeof(ValueType) / sizeof(double);
+  static_assert(sizeof(ValueType) == nComponents * sizeof(double),
+                "A list value must consist of doubles");
+
+  const FoamToken size = next();
+  if (size.kind != FoamToken::Kind::number || size.number < 0.0) {
+    fail("Expected the size of a list but found '" + size.text + "'");
+  }
+  const auto nValues = static_cast<std::size_t>(size.number);
+
+  // The values follow the parenthesis directly, so they are taken from the
+  // buffer instead of as tokens
+  skipSpace();
+  Source &source = sources_.back();
+  const std::string &buffer = source.buffer;
+  if (source.pos < buffer.size() && buffer[source.pos] == '{') {
+    source.pos++;
+    values.assign(nValues, readValue<ValueType>());
+    expect('}');
+    return;
+  }
+  if (source.pos == buffer.size() || buffer[source.pos] != '(') {
+    fail("Expected '(' after the size of a list");
+  }
+  source.pos++;
+  values.resize(nValues);
+
+  if (binary_) {
+    const std::size_t nBytes = nValues * sizeof(ValueType);
+    if (buffer.size() - source.pos < nBytes) {
+      fail("Truncated binary list");
+    }
+    std::memcpy(values.data(), buffer.data() + source.pos, nBytes);
+    source.pos += nBytes;
+    expect(')');
+    return;
+  }
+
+  const char *p = buffer.data() + source.pos;
+  const char *const end = buffer.data() + buffer.size();
+  const auto skip = [&p, end]() {
+    while (p < end && isSpace(*p)) {
+      ++p;
+    }
+  };
+  const auto expectChar = [&](char c) {
+    skip();
+    if (p == end || *p != c) {
+      source.pos = p - buffer.data();
+      fail(std::string("Expected '") + c + "' in a list");
+    }
+    ++p;
+  };
+  for (auto &value : values) {
+    double *component = components(value);
+    if constexpr (nComponents > 1) {
+      expectChar('(');
+    }
+    for (std::size_t i = 0; i < nComponents; ++i) {
+      skip();
+      const auto [ptr, ec] = std::from_chars(p, end, component[i]);
+      if (ec != std::errc()) {
+        source.pos = p - buffer.data();
+        fail("Failed to decode a number of a list");
+      }
+      p = ptr;
+    }
+    if constexpr (nComponents > 1) {
+      expectChar(')');
+    }
+  }
+  source.pos = p - buffer.data();
+  expect(')');
+}
+
+std::size_t FoamTokenizer::position() const {
+  if (hasPeeked_ || sources_.size() > 1) {
+    fail("The position is not available after a peeked token or within an "
+         "included file");
+  }
+  return sources_.back().pos;
+}
+
+void FoamTokenizer::fail(const std::string &message) const {
+  const Source &source = sources_.back();
+  const std::size_t line =
+      1 + std::count(source.buffer.begin(),
+                     source.buffer.begin() + source.pos, '\n');
+  throw std::runtime_error("Error: " + message + " in " + source.fileName +
+                           " at line " + std::to_string(line));
+}
+
+void FoamTokenizer::skipSpace() {
+  for (;;) {
+    Source &source = sources_.back();
+    const std::string &buffer = source.buffer;
+    std::size_t &pos = source.pos;
+    while (pos < buffer.size()) {
+      if (isSpace(buffer[pos])) {
+        ++pos;
+      } else if (buffer.compare(pos, 2, "//") == 0) {
+        pos = std::min(buffer.find('\n', pos), buffer.size());
+      } else if (buffer.compare(pos, 2, "/*") == 0) {
+        const std::size_t end = buffer.find("*/", pos + 2);
+        pos = end == std::string::npos ? buffer.size() : end + 2;
+      } else {
+        return;
+      }
+    }
+    // Continue in the including file
+    if (sources_.size() == 1) {
+      return;
+    }
+    sources_.pop_back();
+  }
+}
+
+FoamToken FoamTokenizer::lex() {
+  for (;;) {
+    skipSpace();
+    Source &source = sources_.back();
+    const std::string &buffer = source.buffer;
+    FoamToken token;
+    if (source.pos == buffer.size()) {
+      return token;
+    }
+
+    const char c = buffer[source.pos];
+    if (isPunctuation(c)) {
+      token.kind = FoamToken::Kind::punctuation;
+      token.text.assign(1, c);
+      source.pos++;
+      return token;
+    }
+    if (c == '"') {
+      const std::size_t end = buffer.find('"', source.pos + 1);
+      if (end == std::string::npos) {
+        fail("Unterminated string");
+      }
+      token.kind = FoamToken::Kind::string;
+      token.text = buffer.substr(source.pos + 1, end - source.pos - 1);
+      source.pos = end + 1;
+      return token;
+    }
+
+    std::size_t end = source.pos;
+    while (end < buffer.size() && !isSpace(buffer[end]) &&
+           !isPunctuation(buffer[end]) && buffer[end] != '"') {
+      ++end;
+    }
+    const char *first = buffer.data() + source.pos;
+    const char *last = buffer.data() + end;
+    token.text.assign(first, last);
+    source.pos = end;
+
+    const auto [ptr, ec] = std::from_chars(first, last, token.number);
+    token.kind = ec == std::errc() && ptr == last ? FoamToken::Kind::number
+                                                  : FoamToken::Kind::word;
+
+    if (token.text == "#include") {
+      const FoamToken fileName = lex();
+      if (fileName.kind != FoamToken::Kind::string) {
+        fail("Expected a file name after #include");
+      }
+      include(fileName.text);
+      continue;
+    }
+    if (token.text == "#inputMode") {
+      lex();
+      continue;
+    }
+    return token;
+  }
+}
+
+void FoamTokenizer::include(const std::string &fileName) {
+  std::filesystem::path path(fileName);
+  if (path.is_relative()) {
+    path = std::filesystem::path(sources_.back().fileName).parent_path() / path;
+  }
+  sources_.push_back({path.string(), CompressedFile::read(path.string()), 0});
+}
+
+// Explicit template instantiation for scalars, vectors and tensors
+template double FoamTokenizer::readValue();
+template std::array<double, 3> FoamTokenizer::readValue();
+template std::array<double, 9> FoamTokenizer::readValue();
+template void FoamTokenizer::readList(std::vector<double> &values);
+template void
+FoamTokenizer::readList(std::vector<std::array<double, 3>> &values);
+template void
+FoamTokenizer::readList(std::vector<std::array<double, 9>> &values);
@@ -0,0 +1,149 @@
+#include "GenerateMesh.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+void GenerateMesh::cartesianBox(Mesh &fvMesh,
+                                const std::array<std::size_t, 3> &nCells,
+                                const std::array<double, 3> &lengths)
+{
+  cartesianBoxLayers(fvMesh, nCells, lengths, 0, nCells[2]);
+}
+
+void GenerateMesh::cartesianBoxLayers(Mesh &fvMesh,
+                                      const std::array<std::size_t, 3> &nCells,
+                                      const std::array<double, 3> &lengths,
+                                      std::size_t kBegin, std::size_t kEnd)
+{
+  const std::size_t nx = nCells[0];
+  const std::size_t ny = nCells[1];
+  if (nx == 0 || ny == 0 || nCells[2] == 0) {
+    throw std::invalid_argument("A Cartesian box needs at least one cell in each direction");
+  }
+  if (kBegin >= kEnd || kEnd > nCells[2]) {
+    throw std::invalid_argument("The layers [" + std::to_string(kBegin) +
+                                ", " + std::to_string(kEnd) +
+                                ") are not a part of the box");
+  }
+  // Number of generated layers; the node coordinates use the global layer
+  // kBegin + k so that they match those of the whole box
+  const std::size_t nz = kEnd - kBegin;
+
+  // --- Nodes ---
+  auto node = [nx, ny](std::size_t i, std::size_t j, std::size_t k) {
+    return i + (nx + 1) * (j + (ny + 1) * k);
+  };
+  fvMesh.nNodes() = (nx + 1) * (ny + 1) * (nz + 1);
+  fvMesh.nodes().assign(fvMesh.nNodes(), Node());
+  for (std::size_t k = 0; k <= nz; ++k) {
+    for (std::size_t j = 0; j <= ny; ++j) {
+      for (std::size_t i = 0; i <= nx; ++i) {
+        Node &theNode = fvMesh.nodes()[node(i, j, k)];
+        theNode.centroid() = {lengths[0] * i / nx, lengths[1] * j / ny,
+                              lengths[2] * (kBegin + k) / nCells[2]};
+        theNode.index() = node(i, j, k);
+      }
+    }
+  }
+
+  // Faces on the planes x_i, y_j and z_k of the cell (i, j, k) with their
+  // normal pointing in the positive direction
+  auto xFace = [&node](std::size_t i, std::size_t j, std::size_t k) {
+    return std::vector<std::size_t>{node(i, j, k), node(i, j + 1, k),
+                                    node(i, j + 1, k + 1), node(i, j, k + 1)};
+  };
+  auto yFace = [&node](std::size_t i, std::size_t j, std::size_t k) {
+    return std::vector<std::size_t>{node(i, j, k), node(i, j, k + 1),
+                                    node(i + 1, j, k + 1), node(i + 1, j, k)};
+  };
+  auto zFace = [&node](std::size_t i, std::size_t j, std::size_t k) {
+    return std::vector<std::size_t>{node(i, j, k), node(i + 1, j, k),
+                                    node(i + 1, j + 1, k), node(i, j + 1, k)};
+  };
+
+  auto cell = [nx, ny](std::size_t i, std::size_t j, std::size_t k) {
+    return static_cast<int>(i + nx * (j + ny * k));
+  };
+  std::vector<Face> &faces = fvMesh.faces();
+  faces.clear();
+  auto addFace = [&faces](std::vector<std::size_t> iNodes, int iOwner,
+                          int iNeighbor) {
+    Face theFace;
+    theFace.nNodes() = iNodes.size();
+    theFace.iNodes() = std::move(iNodes);
+    theFace.iOwner() = iOwner;
+    theFace.iNeighbor() = iNeighbor;
+    theFace.index() = faces.size();
+    faces.push_back(std::move(theFace));
+  };
+
+  // --- Interior faces in upper-triangular order ---
+  for (std::size_t k = 0; k < nz; ++k) {
+    for (std::size_t j = 0; j < ny; ++j) {
+      for (std::size_t i = 0; i < nx; ++i) {
+        if (i + 1 < nx) {
+          addFace(xFace(i + 1, j, k), cell(i, j, k), cell(i + 1, j, k));
+        }
+        if (j + 1 < ny) {
+          addFace(yFace(i, j + 1, k), cell(i, j, k), cell(i, j + 1, k));
+        }
+        if (k + 1 < nz) {
+          addFace(zFace(i, j, k + 1), cell(i, j, k), cell(i, j, k + 1));
+        }
+      }
+    }
+  }
+  fvMesh.nInteriorFaces() = faces.size();
+
+  // --- Boundary patches with outward normals ---
+  fvMesh.nBoundaries() = 6;
+  fvMesh.nPatches() = 6;
+  fvMesh.boundaries().assign(6, Boundary());
+  const std::string patchNames[6] = {"left", "right", "bottom",
+                                     "top",  "back",  "front"};
+  for (std::size_t iBoundary = 0; iBoundary < 6; ++iBoundary) {
+    Boundary &boundary = fvMesh.boundaries()[iBoundary];
+    boundary.userName() = patchNames[iBoundary];
+    boundary.index() = iBoundary;
+    boundary.type() = "wall";
+    boundary.startFace() = faces.size();
+
+    for (std::size_t k = 0; k < nz; ++k) {
+      for (std::size_t j = 0; j < ny; ++j) {
+        for (std::size_t i = 0; i < nx; ++i) {
+          std::vector<std::size_t> iNodes;
+          if (iBoundary == 0 && i == 0) {
+            iNodes = xFace(0, j, k);
+          } else if (iBoundary == 1 && i == nx - 1) {
+            iNodes = xFace(nx, j, k);
+          } else if (iBoundary == 2 && j == 0) {
+            iNodes = yFace(i, 0, k);
+          } else if (iBoundary == 3 && j == ny - 1) {
+            iNodes = yFace(i, ny, k);
+          } else if (iBoundary == 4 && k == 0) {
+            iNodes = zFace(i, j, 0);
+          } else if (iBoundary == 5 && k == nz - 1) {
+            iNodes = zFace(i, j, nz);
+          } else {
+            continue;
+          }
+          // Minimum sides point in the negative direction
+          if (iBoundary % 2 == 0) {
+            std::reverse(iNodes.begin() + 1, iNodes.end());
+          }
+          addFace(std::move(iNodes), cell(i, j, k), -1);
+        }
+      }
+    }
+    boundary.nFaces() = faces.size() - boundary.startFace();
+  }
+
+  fvMesh.nFaces() = faces.size();
+  fvMesh.nOwners() = faces.size();
+  fvMesh.nCells() = nx * ny * nz;
+  fvMesh.cells().assign(fvMesh.nCells(), Cell());
+
+  MeshReader.constructConnectivity(fvMesh);
+  MeshProcessor.processOpenFoamMesh(fvMesh);
+}
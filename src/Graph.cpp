@@ -0,0 +1,38 @@
+#include "Graph.hpp"
+
+Graph::Graph(Mesh &fvMesh)
+{
+  const std::size_t nCells = fvMesh.nCells();
+  adjPtrs_.assign(nCells + 1, 0);
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    adjPtrs_[iElement + 1] =
+        adjPtrs_[iElement] + fvMesh.cells()[iElement].iNeighbors().size();
+  }
+
+  adjacency_.reserve(adjPtrs_.back());
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    const auto &iNeighbors = fvMesh.cells()[iElement].iNeighbors();
+    adjacency_.insert(adjacency_.end(), iNeighbors.begin(), iNeighbors.end());
+  }
+}
+
+template <typename ValueType, typename IndexType>
+Graph::Graph(const CsrMatrix<ValueType, IndexType> &matrix)
+{
+  const std::size_t nRows = matrix.nRows();
+  adjPtrs_.assign(nRows + 1, 0);
+  adjacency_.reserve(matrix.nNonzeros());
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    for (IndexType k = matrix.rowPtrs()[iRow]; k < matrix.rowPtrs()[iRow + 1];
+         ++k) {
+      const auto iCol = static_cast<std::size_t>(matrix.colIdxs()[k]);
+      if (iCol != iRow) {
+        adjacency_.push_back(iCol);
+      }
+    }
+    adjPtrs_[iRow + 1] = adjacency_.size();
+  }
+}
+
+// Explicit template instantiation for commonly used types
+template Graph::Graph(const CsrMatrix<double, int> &matrix);
@@ -0,0 +1,283 @@
+#include "GraphOrdering.hpp"
+#include <algorithm>
+#include <limits>
+
+std::vector<std::size_t>
+GraphOrdering::inverse(const std::vector<std::size_t> &perm)
+{
+  std::vector<std::size_t> inversePerm(perm.size());
+  for (std::size_t i = 0; i < perm.size(); ++i) {
+    inversePerm[perm[i]] = i;
+  }
+  return inversePerm;
+}
+
+std::vector<std::size_t>
+GraphOrdering::levelStructure(const Graph &graph, std::size_t root,
+                              const std::vector<std::size_t> &region,
+                              std::size_t id,
+                              std::vector<std::size_t> &vertices)
+{
+  // Mark visited vertices in a scratch array shared by all calls of a thread
+  thread_local std::vector<std::size_t> visited;
+  thread_local std::size_t stamp = 0;
+  if (visited.size() < graph.nVertices()) {
+    visited.assign(graph.nVertices(), 0);
+    stamp = 0;
+  }
+  stamp++;
+
+  vertices.clear();
+  vertices.push_back(root);
+  visited[root] = stamp;
+  std::vector<std::size_t> levelPtrs{0, 1};
+
+  while (levelPtrs.back() > levelPtrs[levelPtrs.size() - 2]) {
+    const std::size_t levelBegin = levelPtrs[levelPtrs.size() - 2];
+    const std::size_t levelEnd = levelPtrs.back();
+    for (std::size_t i = levelBegin; i < levelEnd; ++i) {
+      const std::size_t v = vertices[i];
+      for (std::size_t k = graph.adjPtrs()[v]; k < graph.adjPtrs()[v + 1];
+           ++k) {
+        const std::size_t w = graph.adjacency()[k];
+        if (region[w] == id && visited[w] != stamp) {
+          visited[w] = stamp;
+          vertices.push_back(w);
+        }
+      }
+    }
+    levelPtrs.push_back(vertices.size());
+  }
+  levelPtrs.pop_back();
+  return levelPtrs;
+}
+
+std::size_t
+GraphOrdering::pseudoPeripheralVertex(const Graph &graph, std::size_t start,
+                                      const std::vector<std::size_t> &region,
+                                      std::size_t id)
+{
+  // George-Liu: restart from a minimum degree vertex of the last level until
+  // the eccentricity stops growing
+  std::vector<std::size_t> vertices;
+  std::size_t root = start;
+  std::size_t nLevels = 0;
+  while (true) {
+    const auto levelPtrs = levelStructure(graph, root, region, id, vertices);
+    if (levelPtrs.size() - 1 <= nLevels) {
+      return root;
+    }
+    nLevels = levelPtrs.size() - 1;
+
+    std::size_t candidate = root;
+    std::size_t minDegree = std::numeric_limits<std::size_t>::max();
+    for (std::size_t i = levelPtrs[nLevels - 1]; i < levelPtrs[nLevels]; ++i) {
+      if (graph.degree(vertices[i]) < minDegree) {
+        minDegree = graph.degree(vertices[i]);
+        candidate = vertices[i];
+      }
+    }
+    if (candidate == root) {
+      return root;
+    }
+    root = candidate;
+  }
+}
+
+std::vector<std::size_t>
+GraphOrdering::reverseCuthillMcKee(const Graph &graph)
+{
+  const std::size_t nVertices = graph.nVertices();
+  std::vector<std::size_t> perm;
+  perm.reserve(nVertices);
+
+  // Vertices numbered so far belong to region 1, the rest to region 0
+  std::vector<std::size_t> region(nVertices, 0);
+
+  // Start the components in order of increasing degree
+  std::vector<std::size_t> starts(nVertices);
+  for (std::size_t v = 0; v < nVertices; ++v) {
+    starts[v] = v;
+  }
+  std::stable_sort(starts.begin(), starts.end(),
+                   [&graph](std::size_t a, std::size_t b) {
+                     return graph.degree(a) < graph.degree(b);
+                   });
+
+  std::vector<std::size_t> neighbors;
+  for (const std::size_t start : starts) {
+    if (region[start] != 0) {
+      continue;
+    }
+    const std::size_t root = pseudoPeripheralVertex(graph, start, region, 0);
+
+    std::size_t head = perm.size();
+    perm.push_back(root);
+    region[root] = 1;
+    while (head < perm.size()) {
+      const std::size_t v = perm[head++];
+      neighbors.clear();
+      for (std::size_t k = graph.adjPtrs()[v]; k < graph.adjPtrs()[v + 1];
+           ++k) {
+        const std::size_t w = graph.adjacency()[k];
+        if (region[w] == 0) {
+          region[w] = 1;
+          neighbors.push_back(w);
+        }
+      }
+      std::stable_sort(neighbors.begin(), neighbors.end(),
+                       [&graph](std::size_t a, std::size_t b) {
+                         return graph.degree(a) < graph.degree(b);
+                       });
+      perm.insert(perm.end(), neighbors.begin(), neighbors.end());
+    }
+  }
+
+  std::reverse(perm.begin(), perm.end());
+  return perm;
+}
+
+std::size_t GraphOrdering::bandwidth(const Graph &graph,
+                                     const std::vector<std::size_t> &perm)
+{
+  std::vector<std::size_t> position;
+  if (perm.empty()) {
+    position.resize(graph.nVertices());
+    for (std::size_t v = 0; v < position.size(); ++v) {
+      position[v] = v;
+    }
+  } else {
+    position = inverse(perm);
+  }
+
+  std::size_t maxDistance = 0;
+  for (std::size_t v = 0; v < graph.nVertices(); ++v) {
+    for (std::size_t k = graph.adjPtrs()[v]; k < graph.adjPtrs()[v + 1];
+         ++k) {
+      const std::size_t w = graph.adjacency()[k];
+      const std::size_t distance = position[v] > position[w]
+                                       ? position[v] - position[w]
+                                       : position[w] - position[v];
+      maxDistance = std::max(maxDistance, distance);
+    }
+  }
+  return maxDistance;
+}
+
+std::vector<std::size_t> GraphOrdering::nestedDissection(const Graph &graph,
+                                                         std::size_t leafSize)
+{
+  const std::size_t nVertices = graph.nVertices();
+  std::vector<std::size_t> perm;
+  perm.reserve(nVertices);
+
+  // region[v] identifies the subgraph v currently belongs to
+  std::vector<std::size_t> region(nVertices, 0);
+  std::size_t nRegions = 1;
+
+  // Work stack of subgraphs. A separator is pushed below the two halves it
+  // splits, so it is numbered after both of them.
+  struct Task
+  {
+    std::vector<std::size_t> vertices;
+    std::size_t id;
+    bool isSeparator;
+  };
+  std::vector<Task> tasks;
+  std::vector<std::size_t> all(nVertices);
+  for (std::size_t v = 0; v < nVertices; ++v) {
+    all[v] = v;
+  }
+  tasks.push_back({std::move(all), 0, false});
+
+  std::vector<std::size_t> vertices;
+  while (!tasks.empty()) {
+    Task task = std::move(tasks.back());
+    tasks.pop_back();
+
+    if (task.isSeparator || task.vertices.size() <= leafSize) {
+      perm.insert(perm.end(), task.vertices.begin(), task.vertices.end());
+      continue;
+    }
+
+    const std::size_t root =
+        pseudoPeripheralVertex(graph, task.vertices.front(), region, task.id);
+    const auto levelPtrs =
+        levelStructure(graph, root, region, task.id, vertices);
+    const std::size_t nLevels = levelPtrs.size() - 1;
+
+    // Split off the vertices not connected to the root without a separator
+    if (vertices.size() < task.vertices.size()) {
+      const std::size_t reachedId = nRegions++;
+      const std::size_t restId = nRegions++;
+      std::vector<std::size_t> rest;
+      for (const std::size_t v : vertices) {
+        region[v] = reachedId;
+      }
+      for (const std::size_t v : task.vertices) {
+        if (region[v] != reachedId) {
+          region[v] = restId;
+          rest.push_back(v);
+        }
+      }
+      tasks.push_back({std::move(rest), restId, false});
+      tasks.push_back({vertices, reachedId, false});
+      continue;
+    }
+
+    // Without at least three levels there is no separating level
+    if (nLevels < 3) {
+      perm.insert(perm.end(), task.vertices.begin(), task.vertices.end());
+      continue;
+    }
+
+    // Separator: the first level at which half of the vertices are reached
+    std::size_t middle = 1;
+    while (middle < nLevels - 2 &&
+           levelPtrs[middle + 1] <= vertices.size() / 2) {
+      middle++;
+    }
+
+    const std::size_t firstId = nRegions++;
+    const std::size_t secondId = nRegions++;
+    const std::size_t separatorId = nRegions++;
+    for (std::size_t i = 0; i < levelPtrs[middle]; ++i) {
+      region[vertices[i]] = firstId;
+    }
+    for (std::size_t i = levelPtrs[middle + 1]; i < vertices.size(); ++i) {
+      region[vertices[i]] = secondId;
+    }
+
+    // Separator vertices without a neighbor in the next level are moved to
+    // the first half to shrink the separator
+    std::vector<std::size_t> first(vertices.begin(),
+                                   vertices.begin() + levelPtrs[middle]);
+    std::vector<std::size_t> second(vertices.begin() + levelPtrs[middle + 1],
+                                    vertices.end());
+    std::vector<std::size_t> separator;
+    for (std::size_t i = levelPtrs[middle]; i < levelPtrs[middle + 1]; ++i) {
+      const std::size_t v = vertices[i];
+      bool touchesSecond = false;
+      for (std::size_t k = graph.adjPtrs()[v]; k < graph.adjPtrs()[v + 1];
+           ++k) {
+        if (region[graph.adjacency()[k]] == secondId) {
+          touchesSecond = true;
+          break;
+        }
+      }
+      if (touchesSecond) {
+        region[v] = separatorId;
+        separator.push_back(v);
+      } else {
+        region[v] = firstId;
+        first.push_back(v);
+      }
+    }
+
+    tasks.push_back({std::move(separator), separatorId, true});
+    tasks.push_back({std::move(second), secondId, false});
+    tasks.push_back({std::move(first), firstId, false});
+  }
+
+  return perm;
+}
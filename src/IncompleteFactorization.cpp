@@ -0,0 +1,321 @@
+#include "IncompleteFactorization.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Position of the diagonal entry of each row
+template <typename ValueType, typename IndexType>
+std::vector<IndexType>
+findDiagonal(const CsrMatrix<ValueType, IndexType> &matrix)
+{
+  std::vector<IndexType> diagPos(matrix.nRows());
+  for (std::size_t iRow = 0; iRow < matrix.nRows(); ++iRow) {
+    const auto rowBegin = matrix.colIdxs().begin() + matrix.rowPtrs()[iRow];
+    const auto rowEnd = matrix.colIdxs().begin() + matrix.rowPtrs()[iRow + 1];
+    const auto diag =
+        std::lower_bound(rowBegin, rowEnd, static_cast<IndexType>(iRow));
+    if (diag == rowEnd || static_cast<std::size_t>(*diag) != iRow) {
+      throw std::invalid_argument(
+          "Incomplete factorization requires a nonzero diagonal in row " +
+          std::to_string(iRow));
+    }
+    diagPos[iRow] = static_cast<IndexType>(diag - matrix.colIdxs().begin());
+  }
+  return diagPos;
+}
+
+// Check that entry (i, j) exists whenever entry (j, i) exists
+template <typename ValueType, typename IndexType>
+bool isStructurallySymmetric(const CsrMatrix<ValueType, IndexType> &matrix)
+{
+  const auto &rowPtrs = matrix.rowPtrs();
+  const auto &colIdxs = matrix.colIdxs();
+  for (std::size_t iRow = 0; iRow < matrix.nRows(); ++iRow) {
+    for (IndexType k = rowPtrs[iRow]; k < rowPtrs[iRow + 1]; ++k) {
+      const IndexType iCol = colIdxs[k];
+      if (!std::binary_search(colIdxs.begin() + rowPtrs[iCol],
+                              colIdxs.begin() + rowPtrs[iCol + 1],
+                              static_cast<IndexType>(iRow))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+template <typename ValueType, typename IndexType>
+IncompleteFactorization<ValueType, IndexType>::IncompleteFactorization(
+    const CsrMatrix<ValueType, IndexType> &matrix,
+    std::shared_ptr<const LevelSchedule> schedule,
+    FactorizationType type)
+    : schedule_(std::move(schedule))
+{
+  if (!schedule_ || !schedule_->matches(matrix)) {
+    throw std::invalid_argument(
+        "Level schedule does not match the matrix sparsity pattern");
+  }
+
+  // The backward solve runs the forward level sets in reverse order, which is
+  // only valid for the structurally symmetric matrices of the FVM assembly
+  if (!isStructurallySymmetric(matrix)) {
+    throw std::invalid_argument(
+        "Incomplete factorization requires a structurally symmetric matrix");
+  }
+
+  if (type == FactorizationType::ilu0) {
+    factorizeIlu0(matrix);
+  } else {
+    factorizeIc0(matrix);
+  }
+}
+
+template <typename ValueType, typename IndexType>
+void IncompleteFactorization<ValueType, IndexType>::factorizeIlu0(
+    const CsrMatrix<ValueType, IndexType> &matrix)
+{
+  const auto &rowPtrs = matrix.rowPtrs();
+  const auto &colIdxs = matrix.colIdxs();
+  const std::vector<IndexType> diagPos = findDiagonal(matrix);
+  const auto &levelPtrs = schedule_->levelPtrs();
+  const auto &rows = schedule_->rows();
+  const std::size_t nLevels = schedule_->nLevels();
+
+  // Factorize in place (IKJ variant) on a copy of the matrix values. A row
+  // only reads rows of earlier levels, so the rows of a level are independent.
+  std::vector<ValueType> lu = matrix.values();
+  bool breakdown = false;
+
+#pragma omp parallel
+  for (std::size_t iLevel = 0; iLevel < nLevels; ++iLevel) {
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t i = levelPtrs[iLevel]; i < static_cast<std::ptrdiff_t>(levelPtrs[iLevel + 1]); ++i) {
+      const std::size_t iRow = rows[i];
+      const IndexType rowEnd = rowPtrs[iRow + 1];
+
+      for (IndexType ik = rowPtrs[iRow]; ik < diagPos[iRow]; ++ik) {
+        const IndexType k = colIdxs[ik];
+        lu[ik] /= lu[diagPos[k]];
+
+        // Update the entries of row i right of column k that also exist in
+        // the upper part of row k
+        IndexType ij = ik + 1;
+        IndexType kj = diagPos[k] + 1;
+        while (ij < rowEnd && kj < rowPtrs[k + 1]) {
+          if (colIdxs[ij] < colIdxs[kj]) {
+            ++ij;
+          } else if (colIdxs[ij] > colIdxs[kj]) {
+            ++kj;
+          } else {
+            lu[ij] -= lu[ik] * lu[kj];
+            ++ij;
+            ++kj;
+          }
+        }
+      }
+
+      if (lu[diagPos[iRow]] == 0.0) {
+#pragma omp atomic write
+        breakdown = true;
+      }
+    }
+  }
+
+  if (breakdown) {
+    throw std::runtime_error("ILU(0) breakdown: zero pivot");
+  }
+
+  // Split the combined factors, storing the unit diagonal of L explicitly
+  const std::size_t nRows = matrix.nRows();
+  std::vector<IndexType> lowerRowPtrs(nRows + 1, 0);
+  std::vector<IndexType> upperRowPtrs(nRows + 1, 0);
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    lowerRowPtrs[iRow + 1] =
+        lowerRowPtrs[iRow] + (diagPos[iRow] - rowPtrs[iRow]) + 1;
+    upperRowPtrs[iRow + 1] =
+        upperRowPtrs[iRow] + (rowPtrs[iRow + 1] - diagPos[iRow]);
+  }
+
+  std::vector<IndexType> lowerColIdxs(lowerRowPtrs.back());
+  std::vector<ValueType> lowerValues(lowerRowPtrs.back());
+  std::vector<IndexType> upperColIdxs(upperRowPtrs.back());
+  std::vector<ValueType> upperValues(upperRowPtrs.back());
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    IndexType l = lowerRowPtrs[iRow];
+    for (IndexType k = rowPtrs[iRow]; k < diagPos[iRow]; ++k, ++l) {
+      lowerColIdxs[l] = colIdxs[k];
+      lowerValues[l] = lu[k];
+    }
+    lowerColIdxs[l] = static_cast<IndexType>(iRow);
+    lowerValues[l] = 1.0;
+
+    IndexType u = upperRowPtrs[iRow];
+    for (IndexType k = diagPos[iRow]; k < rowPtrs[iRow + 1]; ++k, ++u) {
+      upperColIdxs[u] = colIdxs[k];
+      upperValues[u] = lu[k];
+    }
+  }
+
+  lower_ = CsrMatrix<ValueType, IndexType>(
+      std::move(lowerRowPtrs), std::move(lowerColIdxs), std::move(lowerValues));
+  upper_ = CsrMatrix<ValueType, IndexType>(
+      std::move(upperRowPtrs), std::move(upperColIdxs), std::move(upperValues));
+}
+
+template <typename ValueType, typename IndexType>
+void IncompleteFactorization<ValueType, IndexType>::factorizeIc0(
+    const CsrMatrix<ValueType, IndexType> &matrix)
+{
+  const auto &rowPtrs = matrix.rowPtrs();
+  const auto &colIdxs = matrix.colIdxs();
+  const std::vector<IndexType> diagPos = findDiagonal(matrix);
+  const std::size_t nRows = matrix.nRows();
+
+  // Copy the lower triangle including the diagonal, which ends each row
+  std::vector<IndexType> lowerRowPtrs(nRows + 1, 0);
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    lowerRowPtrs[iRow + 1] =
+        lowerRowPtrs[iRow] + (diagPos[iRow] - rowPtrs[iRow]) + 1;
+  }
+  std::vector<IndexType> lowerColIdxs(lowerRowPtrs.back());
+  std::vector<ValueType> l(lowerRowPtrs.back());
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    std::copy(colIdxs.begin() + rowPtrs[iRow],
+              colIdxs.begin() + diagPos[iRow] + 1,
+              lowerColIdxs.begin() + lowerRowPtrs[iRow]);
+    std::copy(matrix.values().begin() + rowPtrs[iRow],
+              matrix.values().begin() + diagPos[iRow] + 1,
+              l.begin() + lowerRowPtrs[iRow]);
+  }
+
+  const auto &levelPtrs = schedule_->levelPtrs();
+  const auto &rows = schedule_->rows();
+  const std::size_t nLevels = schedule_->nLevels();
+  bool breakdown = false;
+
+  // Row-oriented (left-looking) IC(0) restricted to the pattern of A
+#pragma omp parallel
+  for (std::size_t iLevel = 0; iLevel < nLevels; ++iLevel) {
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t i = levelPtrs[iLevel]; i < static_cast<std::ptrdiff_t>(levelPtrs[iLevel + 1]); ++i) {
+      const std::size_t iRow = rows[i];
+      const IndexType iDiag = lowerRowPtrs[iRow + 1] - 1;
+
+      for (IndexType ik = lowerRowPtrs[iRow]; ik < iDiag; ++ik) {
+        const IndexType k = lowerColIdxs[ik];
+        const IndexType kDiag = lowerRowPtrs[k + 1] - 1;
+
+        // l_ik = (a_ik - sum_{j<k} l_ij * l_kj) / l_kk
+        ValueType sum = 0.0;
+        IndexType ij = lowerRowPtrs[iRow];
+        IndexType kj = lowerRowPtrs[k];
+        while (ij < ik && kj < kDiag) {
+          if (lowerColIdxs[ij] < lowerColIdxs[kj]) {
+            ++ij;
+          } else if (lowerColIdxs[ij] > lowerColIdxs[kj]) {
+            ++kj;
+          } else {
+            sum += l[ij] * l[kj];
+            ++ij;
+            ++kj;
+          }
+        }
+        l[ik] = (l[ik] - sum) / l[kDiag];
+      }
+
+      // l_ii = sqrt(a_ii - sum_{j<i} l_ij^2)
+      ValueType pivot = l[iDiag];
+      for (IndexType ij = lowerRowPtrs[iRow]; ij < iDiag; ++ij) {
+        pivot -= l[ij] * l[ij];
+      }
+      if (pivot <= 0.0) {
+#pragma omp atomic write
+        breakdown = true;
+        pivot = 1.0;
+      }
+      l[iDiag] = std::sqrt(pivot);
+    }
+  }
+
+  if (breakdown) {
+    throw std::runtime_error(
+        "IC(0) breakdown: matrix is not symmetric positive definite");
+  }
+
+  // Store L^T explicitly so that the backward solve is row oriented as well.
+  // Visiting the rows of L in order keeps the columns of L^T sorted.
+  std::vector<IndexType> upperRowPtrs(nRows + 1, 0);
+  for (const IndexType iCol : lowerColIdxs) {
+    upperRowPtrs[iCol + 1]++;
+  }
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    upperRowPtrs[iRow + 1] += upperRowPtrs[iRow];
+  }
+  std::vector<IndexType> next(upperRowPtrs.begin(), upperRowPtrs.end() - 1);
+  std::vector<IndexType> upperColIdxs(lowerColIdxs.size());
+  std::vector<ValueType> upperValues(l.size());
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    for (IndexType k = lowerRowPtrs[iRow]; k < lowerRowPtrs[iRow + 1]; ++k) {
+      const IndexType u = next[lowerColIdxs[k]]++;
+      upperColIdxs[u] = static_cast<IndexType>(iRow);
+      upperValues[u] = l[k];
+    }
+  }
+
+  lower_ = CsrMatrix<ValueType, IndexType>(
+      std::move(lowerRowPtrs), std::move(lowerColIdxs), std::move(l));
+  upper_ = CsrMatrix<ValueType, IndexType>(
+      std::move(upperRowPtrs), std::move(upperColIdxs), std::move(upperValues));
+}
+
+template <typename ValueType, typename IndexType>
+void IncompleteFactorization<ValueType, IndexType>::apply(const ValueType *r,
+                                                          ValueType *z) const
+{
+  const auto &levelPtrs = schedule_->levelPtrs();
+  const auto &rows = schedule_->rows();
+  const std::size_t nLevels = schedule_->nLevels();
+  const auto &lowerRowPtrs = lower_.rowPtrs();
+  const auto &lowerColIdxs = lower_.colIdxs();
+  const auto &lowerValues = lower_.values();
+  const auto &upperRowPtrs = upper_.rowPtrs();
+  const auto &upperColIdxs = upper_.colIdxs();
+  const auto &upperValues = upper_.values();
+
+#pragma omp parallel
+  {
+    // Forward substitution L * y = r, level by level
+    for (std::size_t iLevel = 0; iLevel < nLevels; ++iLevel) {
+#pragma omp for schedule(static)
+      for (std::ptrdiff_t i = levelPtrs[iLevel]; i < static_cast<std::ptrdiff_t>(levelPtrs[iLevel + 1]); ++i) {
+        const std::size_t iRow = rows[i];
+        const IndexType iDiag = lowerRowPtrs[iRow + 1] - 1;
+        ValueType sum = r[iRow];
+        for (IndexType k = lowerRowPtrs[iRow]; k < iDiag; ++k) {
+          sum -= lowerValues[k] * z[lowerColIdxs[k]];
+        }
+        z[iRow] = sum / lowerValues[iDiag];
+      }
+    }
+
+    // Backward substitution U * z = y in place, levels in reverse order
+    for (std::size_t iLevel = nLevels; iLevel-- > 0;) {
+#pragma omp for schedule(static)
+      for (std::ptrdiff_t i = levelPtrs[iLevel]; i < static_cast<std::ptrdiff_t>(levelPtrs[iLevel + 1]); ++i) {
+        const std::size_t iRow = rows[i];
+        const IndexType iDiag = upperRowPtrs[iRow];
+        ValueType sum = z[iRow];
+        for (IndexType k = iDiag + 1; k < upperRowPtrs[iRow + 1]; ++k) {
+          sum -= upperValues[k] * z[upperColIdxs[k]];
+        }
+        z[iRow] = sum / upperValues[iDiag];
+      }
+    }
+  }
+}
+
+// Explicit template instantiation for commonly used types
+template class IncompleteFactorization<double, int>;
@@ -0,0 +1,53 @@
+#include "LevelSchedule.hpp"
+#include <algorithm>
+
+template <typename ValueType, typename IndexType>
+LevelSchedule::LevelSchedule(const CsrMatrix<ValueType, IndexType> &matrix)
+    : patternRowPtrs_(matrix.rowPtrs().begin(), matrix.rowPtrs().end()),
+      patternColIdxs_(matrix.colIdxs().begin(), matrix.colIdxs().end())
+{
+  const std::size_t nRows = matrix.nRows();
+
+  // A row sits one level above the deepest row it depends on. Dependencies
+  // always point to smaller row indices, so one forward sweep suffices.
+  std::vector<std::size_t> level(nRows, 0);
+  std::size_t nLevels = nRows > 0 ? 1 : 0;
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    for (std::size_t k = patternRowPtrs_[iRow]; k < patternRowPtrs_[iRow + 1];
+         ++k) {
+      const std::size_t iCol = patternColIdxs_[k];
+      if (iCol < iRow) {
+        level[iRow] = std::max(level[iRow], level[iCol] + 1);
+      }
+    }
+    nLevels = std::max(nLevels, level[iRow] + 1);
+  }
+
+  // Bucket the rows by level, keeping ascending row order inside a level
+  levelPtrs_.assign(nLevels + 1, 0);
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    levelPtrs_[level[iRow] + 1]++;
+  }
+  for (std::size_t iLevel = 0; iLevel < nLevels; ++iLevel) {
+    levelPtrs_[iLevel + 1] += levelPtrs_[iLevel];
+  }
+
+  std::vector<std::size_t> next(levelPtrs_.begin(), levelPtrs_.end() - 1);
+  rows_.resize(nRows);
+  for (std::size_t iRow = 0; iRow < nRows; ++iRow) {
+    rows_[next[level[iRow]]++] = iRow;
+  }
+}
+
+template <typename ValueType, typename IndexType>
+bool LevelSchedule::matches(const CsrMatrix<ValueType, IndexType> &matrix) const
+{
+  return std::equal(patternRowPtrs_.begin(), patternRowPtrs_.end(),
+                    matrix.rowPtrs().begin(), matrix.rowPtrs().end()) &&
+         std::equal(patternColIdxs_.begin(), patternColIdxs_.end(),
+                    matrix.colIdxs().begin(), matrix.colIdxs().end());
+}
+
+// Explicit template instantiation for commonly used types
+template LevelSchedule::LevelSchedule(const CsrMatrix<double, int> &matrix);
+template bool LevelSchedule::matches(const CsrMatrix<double, int> &matrix) const;
@@ -1,12 +1,119 @@
 #include "LinearSolver.hpp"
+#include "ChebyshevPreconditioner.hpp"
+#include "CsrMatrix.hpp"
+#include "IncompleteFactorization.hpp"
+#include <functional>
 #include <iostream>
 
+namespace {
+// Wrap a natively implemented preconditioner z = M^{-1} r into a Ginkgo
+// linear operator so that it can be passed to the Ginkgo solvers. The data of
+// the vectors is accessed directly, so a host executor is required.
+template <typename ValueType>
+class NativePreconditioner
+    : public gko::EnableLinOp<NativePreconditioner<ValueType>> {
+public:
+  using vec = gko::matrix::Dense<ValueType>;
+  using operation = std::function<void(const ValueType *, ValueType *)>;
+
+  NativePreconditioner(std::shared_ptr<const gko::Executor> exec,
+                       gko::size_type size = 0, operation op = {})
+      : gko::EnableLinOp<NativePreconditioner>(exec, gko::dim<2>{size}),
+        op_(std::move(op)) {}
+
+protected:
+  void apply_impl(const gko::LinOp *b, gko::LinOp *x) const override {
+    auto dense_b = gko::as<vec>(b);
+    auto dense_x = gko::as<vec>(x);
+    op_(dense_b->get_const_values(), dense_x->get_values());
+  }
+
+  void apply_impl(const gko::LinOp *alpha, const gko::LinOp *b,
+                  const gko::LinOp *beta, gko::LinOp *x) const override {
+    auto dense_x = gko::as<vec>(x);
+    auto tmp_x = dense_x->clone();
+    this->apply_impl(b, tmp_x.get());
+    dense_x->scale(beta);
+    dense_x->add_scaled(alpha, tmp_x);
+  }
+
+private:
+  operation op_;
+};
+} // namespace
+
+template <typename ValueType, typename IndexType>
+std::function<void(const ValueType *, ValueType *)>
+LinearSolver::makeNativePreconditioner(
+    std::shared_ptr<const CsrMatrix<ValueType, IndexType>> csrMatrix) {
+  if (preconditioner_ == PreconditionerType::chebyshev) {
+    auto chebyshev =
+        std::make_shared<ChebyshevPreconditioner<ValueType, IndexType>>(
+            csrMatrix, chebyshevDegree_, spectralEstimate_);
+    return [chebyshev](const ValueType *r, ValueType *z) {
+      chebyshev->apply(r, z);
+    };
+  }
+
+  if (preconditioner_ == PreconditionerType::ilu0 ||
+      preconditioner_ == PreconditionerType::ic0) {
+    // The level sets are computed once per mesh and reused by later solves
+    if (!levelSchedule_ || !levelSchedule_->matches(*csrMatrix)) {
+      levelSchedule_ = std::make_shared<const LevelSchedule>(*csrMatrix);
+    }
+
+    const FactorizationType factorizationType =
+        preconditioner_ == PreconditionerType::ic0 ? FactorizationType::ic0
+                                                   : FactorizationType::ilu0;
+    auto factorization =
+        std::make_shared<IncompleteFactorization<ValueType, IndexType>>(
+            *csrMatrix, levelSchedule_, factorizationType);
+    return [factorization](const ValueType *r, ValueType *z) {
+      factorization->apply(r, z);
+    };
+  }
+
+  // Ginkgo's block Jacobi only exists inside Ginkgo solvers, so native
+  // solvers fall back to point Jacobi
+  auto invDiag = std::make_shared<std::vector<ValueType>>(csrMatrix->diagonal());
+  for (auto &diag : *invDiag) {
+    diag = 1.0 / diag;
+  }
+  return [invDiag](const ValueType *r, ValueType *z) {
+    const auto n = static_cast<std::ptrdiff_t>(invDiag->size());
+#pragma omp parallel for simd
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      z[i] = (*invDiag)[i] * r[i];
+    }
+  };
+}
+
 template <typename ValueType, typename IndexType>
 void LinearSolver::solve(gko::matrix_data<ValueType, IndexType> &coeffMatrix,
                          std::vector<ValueType> &RHS,
                          std::vector<ValueType> &solVector,
                          gko::remove_complex<ValueType> reduction_factor,
                          IndexType maxNumIterations) {
+  // Direct solve; only the numeric factorization is repeated as long as the
+  // sparsity pattern is unchanged
+  if (solverType_ == SolverType::cholesky) {
+    const CsrMatrix<ValueType, IndexType> csrMatrix(coeffMatrix);
+    cholesky_.factorize(csrMatrix);
+    cholesky_.solve(RHS.data(), solVector.data());
+    return;
+  }
+
+  // Deflated CG recycling the low eigenvectors of the previous solves
+  if (recycleDimension_ > 0) {
+    auto csrMatrix =
+        std::make_shared<const CsrMatrix<ValueType, IndexType>>(coeffMatrix);
+    recycledCg_.recycleDimension() = recycleDimension_;
+    recycledCg_.solve(*csrMatrix, RHS, solVector,
+                      makeNativePreconditioner(csrMatrix), reduction_factor,
+                      static_cast<std::size_t>(maxNumIterations));
+    return;
+  }
+
   // Create an executor (e.g., CPU executor)
   auto exec = gko::ReferenceExecutor::create();
 
@@ -39,20 +146,38 @@ void LinearSolver::solve(gko::matrix_data<ValueType, IndexType> &coeffMatrix,
 
   // === Solve the linear system of equations ===
   // --- Generate solver ---
-  // Generate a Ginkgo CG solver with the block Jacobi preconditioner
+  // Generate a Ginkgo CG solver with the selected preconditioner
   using cg = gko::solver::Cg<ValueType>;
   using bj = gko::preconditioner::Jacobi<ValueType, IndexType>;
 
-  auto solver_factory =
-      cg::build()
-          .with_criteria(
-              gko::stop::Iteration::build().with_max_iters(
-                  gko::size_type(maxNumIterations)),
-              gko::stop::ResidualNorm<ValueType>::build().with_reduction_factor(
-                  reduction_factor))
-          .with_preconditioner(bj::build())
-          .on(exec);
-  auto solver = solver_factory->generate(gko_coeffMatrix);
+  const auto iter_stop = gko::share(
+      gko::stop::Iteration::build()
+          .with_max_iters(gko::size_type(maxNumIterations))
+          .on(exec));
+  const auto tol_stop = gko::share(
+      gko::stop::ResidualNorm<ValueType>::build()
+          .with_reduction_factor(reduction_factor)
+          .on(exec));
+
+  std::shared_ptr<gko::LinOp> solver;
+  if (preconditioner_ == PreconditionerType::blockJacobi) {
+    auto solver_factory = cg::build()
+                              .with_criteria(iter_stop, tol_stop)
+                              .with_preconditioner(bj::build())
+                              .on(exec);
+    solver = solver_factory->generate(gko_coeffMatrix);
+  } else {
+    auto csrMatrix =
+        std::make_shared<const CsrMatrix<ValueType, IndexType>>(coeffMatrix);
+    auto preconditioner = std::make_shared<NativePreconditioner<ValueType>>(
+        exec, nMeshPoints, makeNativePreconditioner(csrMatrix));
+
+    auto solver_factory = cg::build()
+                              .with_criteria(iter_stop, tol_stop)
+                              .with_generated_preconditioner(preconditioner)
+                              .on(exec);
+    solver = solver_factory->generate(gko_coeffMatrix);
+  }
 
   // --- Solve system ---
   solver->apply(gko_RHS, gko_x);
@@ -62,4 +187,4 @@ template void LinearSolver::solve(gko::matrix_data<double, int> &coeffMatrix,
                                   std::vector<double> &RHS,
                                   std::vector<double> &solVector,
                                   gko::remove_complex<double> reduction_factor,
-                                  int maxNumIterations);
\ No newline at end of file
+                                  int maxNumIterations);
@@ -0,0 +1,345 @@
+#include "LossyField.hpp"
+#include "CompressedFile.hpp"
+#include "RenumberMesh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <zlib.h>
+
+namespace {
+
+constexpr char magic[8] = {'L', 'O', 'S', 'S', 'Y', 'F', 'L', 'D'};
+constexpr std::uint32_t formatVersion = 2;
+
+// Largest quantized residual; larger residuals are stored exactly
+constexpr double maxQuantized = 4503599627370496.0; // 2^52
+
+template <typename ValueType> constexpr std::size_t nComponentsOf() {
+  if constexpr (std::is_same_v<ValueType, double>) {
+    return 1;
+  } else {
+    return std::tuple_size_v<ValueType>;
+  }
+}
+
+template <typename T> void put(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+T take(const std::string &in, std::size_t &pos, const std::string &fileName) {
+  if (in.size() - pos < sizeof(T)) {
+    throw std::runtime_error("Error: Truncated lossy field file: " + fileName);
+  }
+  T value;
+  std::memcpy(&value, in.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return value;
+}
+
+// Unsigned LEB128, seven bits per byte
+void putVarint(std::string &out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+std::uint64_t takeVarint(const std::string &in, std::size_t &pos,
+                         const std::string &fileName) {
+  std::uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (pos == in.size()) {
+      break;
+    }
+    const auto byte = static_cast<unsigned char>(in[pos++]);
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Error: Corrupt lossy field file: " + fileName);
+}
+
+// CRC-32 of reconstructed values, which identifies a snapshot as a
+// reference: both sides reconstruct the same values bit for bit
+std::uint32_t checksum(const std::vector<double> &values) {
+  const auto *bytes = reinterpret_cast<const Bytef *>(values.data());
+  std::size_t nBytes = values.size() * sizeof(double);
+  uLong crc = crc32(0L, Z_NULL, 0);
+  while (nBytes > 0) {
+    const auto nChunk =
+        static_cast<uInt>(std::min<std::size_t>(nBytes, 1 << 30));
+    crc = crc32(crc, bytes, nChunk);
+    bytes += nChunk;
+    nBytes -= nChunk;
+  }
+  return static_cast<std::uint32_t>(crc);
+}
+
+// The same reconstruction on both sides, so that the decoder reproduces the
+// values the encoder predicts from bit for bit
+double dequantize(double prediction, std::int64_t quantized, double step) {
+  return prediction + static_cast<double>(quantized) * step;
+}
+
+// Prediction of value i: the previous cell in a keyframe, otherwise the same
+// cell of the reference snapshot plus the change of the previous cell since
+// the reference snapshot
+double predict(const std::vector<double> &values,
+               const std::vector<double> *reference, std::size_t i,
+               std::size_t nComponents) {
+  if (reference) {
+    return i >= nComponents ? (*reference)[i] + values[i - nComponents] -
+                                  (*reference)[i - nComponents]
+                            : (*reference)[i];
+  }
+  return i >= nComponents ? values[i - nComponents] : 0.0;
+}
+
+std::string fieldFileName(const std::string &caseDirectory,
+                          const std::string &timePoint,
+                          const std::string &fieldName) {
+  return caseDirectory + "/" + timePoint + "/" + fieldName + ".lossy";
+}
+
+} // namespace
+
+WriteLossyField::WriteLossyField(const std::string &caseDirectory,
+                                 double errorBound,
+                                 std::size_t keyframeInterval)
+    : caseDirectory_(caseDirectory), errorBound_(errorBound),
+      keyframeInterval_(std::max<std::size_t>(keyframeInterval, 1)) {
+  if (!(errorBound > 0.0) || !std::isfinite(errorBound)) {
+    throw std::runtime_error(
+        "Error: The error bound of lossy fields has to be positive");
+  }
+}
+
+template <typename ValueType>
+void WriteLossyField::write(const std::vector<ValueType> &values,
+                            const std::string &timePoint,
+                            const std::string &fieldName,
+                            const std::vector<std::size_t> &cellOrdering) {
+  constexpr std::size_t nComponents = nComponentsOf<ValueType>();
+  const std::vector<ValueType> originalValues =
+      RenumberMesh::toOriginalNumbering(cellOrdering, values);
+  const auto *exact = reinterpret_cast<const double *>(originalValues.data());
+  const std::size_t nValues = nComponents * originalValues.size();
+
+  const auto found = references_.find(fieldName);
+  // A rewritten time step may be the reference of a later snapshot, so it
+  // must not reference one itself
+  const bool keyframe = found == references_.end() ||
+                        found->second.values.size() != nValues ||
+                        found->second.timePoints.count(timePoint) > 0 ||
+                        found->second.nSinceKeyframe + 1 >= keyframeInterval_;
+  const std::vector<double> *reference =
+      keyframe ? nullptr : &found->second.values;
+
+  // Quantized residuals, shifted by one so that 0 marks an exact value
+  const double step = 2.0 * errorBound_;
+  std::vector<double> reconstructed(nValues);
+  std::string symbols;
+  symbols.reserve(nValues);
+  for (std::size_t i = 0; i < nValues; ++i) {
+    const double prediction = predict(reconstructed, reference, i, nComponents);
+    const double residual = (exact[i] - prediction) / step;
+    if (std::abs(residual) < maxQuantized) {
+      const auto quantized = static_cast<std::int64_t>(std::llround(residual));
+      const double value = dequantize(prediction, quantized, step);
+      if (std::abs(exact[i] - value) <= errorBound_) {
+        const std::uint64_t zigzag =
+            (static_cast<std::uint64_t>(quantized) << 1) ^
+            static_cast<std::uint64_t>(quantized >> 63);
+        putVarint(symbols, zigzag + 1);
+        reconstructed[i] = value;
+        continue;
+      }
+    }
+    symbols.push_back('\0');
+    put(symbols, exact[i]);
+    reconstructed[i] = exact[i];
+  }
+
+  // Entropy coding of the residuals
+  uLongf nCompressed = compressBound(static_cast<uLong>(symbols.size()));
+  std::string compressed(nCompressed, '\0');
+  if (compress2(reinterpret_cast<Bytef *>(compressed.data()), &nCompressed,
+                reinterpret_cast<const Bytef *>(symbols.data()),
+                static_cast<uLong>(symbols.size()),
+                Z_DEFAULT_COMPRESSION) != Z_OK) {
+    throw std::runtime_error("Error: Compression of field " + fieldName +
+                             " failed");
+  }
+  compressed.resize(nCompressed);
+
+  std::string file(magic, sizeof(magic));
+  put(file, formatVersion);
+  put(file, static_cast<std::uint32_t>(nComponents));
+  put(file, static_cast<std::uint64_t>(originalValues.size()));
+  put(file, errorBound_);
+  const std::string referenceTime = keyframe ? "" : found->second.timePoint;
+  put(file, static_cast<std::uint32_t>(referenceTime.size()));
+  file += referenceTime;
+  // The reference as it was written, so that a snapshot whose reference has
+  // been rewritten since is detected
+  put(file, keyframe ? std::uint32_t{0} : found->second.checksum);
+  put(file, static_cast<std::uint64_t>(symbols.size()));
+  put(file, static_cast<std::uint64_t>(compressed.size()));
+  file += compressed;
+
+  const std::filesystem::path targetDirectory =
+      std::filesystem::path(caseDirectory_) / timePoint;
+  std::filesystem::create_directories(targetDirectory);
+  const std::string targetFilePath =
+      fieldFileName(caseDirectory_, timePoint, fieldName);
+  std::ofstream outFile(targetFilePath, std::ios::out | std::ios::binary);
+  if (!outFile.is_open()) {
+    throw std::ios_base::failure("Failed to open or create file: " +
+                                 targetFilePath);
+  }
+  outFile.write(file.data(), static_cast<std::streamsize>(file.size()));
+  outFile.close();
+  if (!outFile) {
+    throw std::ios_base::failure("Failed to write file: " + targetFilePath);
+  }
+  bytesWritten_ = file.size();
+
+  Reference &next = references_[fieldName];
+  next.nSinceKeyframe = keyframe ? 0 : next.nSinceKeyframe + 1;
+  next.timePoint = timePoint;
+  next.timePoints.insert(timePoint);
+  next.checksum = checksum(reconstructed);
+  next.values = std::move(reconstructed);
+}
+
+// Explicit template instantiation for scalar and vector fields
+template void
+WriteLossyField::write(const std::vector<double> &values,
+                       const std::string &timePoint,
+                       const std::string &fieldName,
+                       const std::vector<std::size_t> &cellOrdering);
+template void
+WriteLossyField::write(const std::vector<std::array<double, 3>> &values,
+                       const std::string &timePoint,
+                       const std::string &fieldName,
+                       const std::vector<std::size_t> &cellOrdering);
+
+ReadLossyField::ReadLossyField(const std::string &caseDirectory)
+    : caseDirectory_(caseDirectory) {}
+
+template <typename ValueType>
+std::vector<ValueType> ReadLossyField::read(const std::string &timePoint,
+                                            const std::string &fieldName) {
+  constexpr std::size_t nComponents = nComponentsOf<ValueType>();
+  std::vector<std::string> chain;
+  const std::vector<double> &values =
+      decode(timePoint, fieldName, nComponents, chain);
+  std::vector<ValueType> cellValues(values.size() / nComponents);
+  std::memcpy(cellValues.data(), values.data(),
+              values.size() * sizeof(double));
+  return cellValues;
+}
+
+// Explicit template instantiation for scalar and vector fields
+template std::vector<double>
+ReadLossyField::read(const std::string &timePoint,
+                     const std::string &fieldName);
+template std::vector<std::array<double, 3>>
+ReadLossyField::read(const std::string &timePoint,
+                     const std::string &fieldName);
+
+const std::vector<double> &
+ReadLossyField::decode(const std::string &timePoint,
+                       const std::string &fieldName, std::size_t nComponents,
+                       std::vector<std::string> &chain) {
+  const auto found = last_.find(fieldName);
+  if (found != last_.end() && found->second.timePoint == timePoint &&
+      found->second.nComponents == nComponents) {
+    return found->second.values;
+  }
+  if (std::find(chain.begin(), chain.end(), timePoint) != chain.end()) {
+    throw std::runtime_error("Error: Lossy field " + fieldName +
+                             " references itself through time " + timePoint);
+  }
+  chain.push_back(timePoint);
+
+  const std::string fileName =
+      fieldFileName(caseDirectory_, timePoint, fieldName);
+  const std::string file = CompressedFile::read(fileName);
+  std::size_t pos = sizeof(magic);
+  if (file.compare(0, sizeof(magic), magic, sizeof(magic)) != 0 ||
+      take<std::uint32_t>(file, pos, fileName) != formatVersion) {
+    throw std::runtime_error("Error: Not a lossy field file: " + fileName);
+  }
+  if (take<std::uint32_t>(file, pos, fileName) != nComponents) {
+    throw std::runtime_error("Error: Lossy field file " + fileName +
+                             " has a different number of components");
+  }
+  const std::size_t nValues =
+      nComponents * take<std::uint64_t>(file, pos, fileName);
+  const double step = 2.0 * take<double>(file, pos, fileName);
+  const std::size_t nReferenceTime = take<std::uint32_t>(file, pos, fileName);
+  const std::string referenceTime = file.substr(pos, nReferenceTime);
+  pos += nReferenceTime;
+  const auto referenceChecksum = take<std::uint32_t>(file, pos, fileName);
+  const std::size_t nSymbols = take<std::uint64_t>(file, pos, fileName);
+  const std::size_t nCompressed = take<std::uint64_t>(file, pos, fileName);
+  if (file.size() - std::min(pos, file.size()) < nCompressed) {
+    throw std::runtime_error("Error: Truncated lossy field file: " + fileName);
+  }
+
+  std::string symbols(nSymbols, '\0');
+  uLongf nUncompressed = static_cast<uLongf>(nSymbols);
+  if (uncompress(reinterpret_cast<Bytef *>(symbols.data()), &nUncompressed,
+                 reinterpret_cast<const Bytef *>(file.data() + pos),
+                 static_cast<uLong>(nCompressed)) != Z_OK ||
+      nUncompressed != nSymbols) {
+    throw std::runtime_error("Error: Corrupt lossy field file: " + fileName);
+  }
+
+  // The reference snapshot, decoded first (and from its own reference)
+  std::vector<double> reference;
+  if (!referenceTime.empty()) {
+    reference = decode(referenceTime, fieldName, nComponents, chain);
+    if (reference.size() != nValues) {
+      throw std::runtime_error("Error: Lossy field file " + fileName +
+                               " does not match its reference " +
+                               referenceTime);
+    }
+    if (checksum(reference) != referenceChecksum) {
+      throw std::runtime_error("Error: The reference " + referenceTime +
+                               " of lossy field file " + fileName +
+                               " has been rewritten since");
+    }
+  }
+
+  std::vector<double> values(nValues);
+  std::size_t symbolPos = 0;
+  for (std::size_t i = 0; i < nValues; ++i) {
+    const std::uint64_t symbol = takeVarint(symbols, symbolPos, fileName);
+    if (symbol == 0) {
+      values[i] = take<double>(symbols, symbolPos, fileName);
+      continue;
+    }
+    const std::uint64_t zigzag = symbol - 1;
+    const auto quantized = static_cast<std::int64_t>(zigzag >> 1) ^
+                           -static_cast<std::int64_t>(zigzag & 1);
+    const double prediction = predict(
+        values, referenceTime.empty() ? nullptr : &reference, i, nComponents);
+    values[i] = dequantize(prediction, quantized, step);
+  }
+
+  Snapshot &snapshot = last_[fieldName];
+  snapshot.timePoint = timePoint;
+  snapshot.nComponents = nComponents;
+  snapshot.values = std::move(values);
+  return snapshot.values;
+}
@@ -0,0 +1,194 @@
+#include "MeshQuality.hpp"
+#include "arrayOperations.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+namespace {
+
+// Running statistics of one measure, accumulated per thread and merged
+class Accumulator {
+public:
+  explicit Accumulator(const std::vector<double> &binEdges)
+      : binEdges_(&binEdges), counts_(binEdges.size(), 0) {}
+
+  void add(double value, std::size_t index) {
+    min_ = std::min(min_, value);
+    if (value > max_ || (value == max_ && index < iMax_)) {
+      max_ = value;
+      iMax_ = index;
+    }
+    sum_ += value;
+    n_++;
+    const auto bin = std::upper_bound(binEdges_->begin(), binEdges_->end(),
+                                      value) -
+                     binEdges_->begin();
+    counts_[bin > 0 ? bin - 1 : 0]++;
+  }
+
+  void merge(const Accumulator &other) {
+    min_ = std::min(min_, other.min_);
+    if (other.max_ > max_ || (other.max_ == max_ && other.iMax_ < iMax_)) {
+      max_ = other.max_;
+      iMax_ = other.iMax_;
+    }
+    sum_ += other.sum_;
+    n_ += other.n_;
+    for (std::size_t bin = 0; bin < counts_.size(); ++bin) {
+      counts_[bin] += other.counts_[bin];
+    }
+  }
+
+  QualityDistribution distribution() const {
+    QualityDistribution result;
+    if (n_ > 0) {
+      result.min = min_;
+      result.max = max_;
+      result.mean = sum_ / static_cast<double>(n_);
+      result.iMax = iMax_;
+    }
+    result.binEdges = *binEdges_;
+    result.counts = counts_;
+    return result;
+  }
+
+private:
+  const std::vector<double> *binEdges_;
+  std::vector<std::size_t> counts_;
+  double min_ = std::numeric_limits<double>::infinity();
+  double max_ = -std::numeric_limits<double>::infinity();
+  double sum_ = 0.0;
+  std::size_t iMax_ = std::numeric_limits<std::size_t>::max();
+  std::size_t n_ = 0;
+};
+
+void writeDistribution(const char *name, const QualityDistribution &d,
+                       const char *entity, std::ostream &os) {
+  os << "  " << name << ": min " << d.min << ", mean " << d.mean << ", max "
+     << d.max << " (" << entity << " " << d.iMax << ")\n    histogram:";
+  for (std::size_t bin = 0; bin < d.counts.size(); ++bin) {
+    if (bin + 1 < d.binEdges.size()) {
+      os << " [" << d.binEdges[bin] << ", " << d.binEdges[bin + 1]
+         << "): " << d.counts[bin];
+    } else {
+      os << " >= " << d.binEdges[bin] << ": " << d.counts[bin];
+    }
+  }
+  os << "\n";
+}
+
+} // namespace
+
+MeshQualityReport MeshQuality::check(Mesh &fvMesh) const {
+  const std::vector<double> nonOrthogonalityEdges = {0.0,  10.0, 20.0,
+                                                     30.0, 40.0, 50.0,
+                                                     60.0, 70.0, 80.0};
+  const std::vector<double> skewnessEdges = {0.0, 0.1, 0.2, 0.5,
+                                             1.0, 2.0, 4.0};
+  const std::vector<double> aspectRatioEdges = {1.0,  2.0,  5.0,  10.0,
+                                                20.0, 50.0, 100.0};
+  constexpr double radiansToDegrees = 180.0 / 3.14159265358979323846;
+
+  Accumulator nonOrthogonality(nonOrthogonalityEdges);
+  Accumulator skewness(skewnessEdges);
+  Accumulator aspectRatio(aspectRatioEdges);
+  std::size_t nSevere = 0;
+
+  const auto nFaces = static_cast<std::ptrdiff_t>(fvMesh.nFaces());
+  const auto nInteriorFaces =
+      static_cast<std::ptrdiff_t>(fvMesh.nInteriorFaces());
+  const auto nCells = static_cast<std::ptrdiff_t>(fvMesh.nCells());
+
+  // Distances from the owner and neighbor centroids to the plane of each
+  // face, so that the cell sweep reads compact arrays instead of the faces
+  std::vector<double> ownerDistance(nFaces);
+  std::vector<double> neighborDistance(nInteriorFaces);
+
+#pragma omp parallel
+  {
+    Accumulator localNonOrthogonality(nonOrthogonalityEdges);
+    Accumulator localSkewness(skewnessEdges);
+    Accumulator localAspectRatio(aspectRatioEdges);
+    std::size_t localSevere = 0;
+
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t iFace = 0; iFace < nFaces; ++iFace) {
+      Face &theFace = fvMesh.faces()[iFace];
+      if (iFace >= nInteriorFaces) {
+        ownerDistance[iFace] = std::fabs(theFace.walldist());
+        continue;
+      }
+
+      const double SfDotCN = dot_product(theFace.Sf(), theFace.CN());
+      const double cosAngle =
+          std::clamp(SfDotCN / (theFace.area() * theFace.magCN()), -1.0, 1.0);
+      const double angle = std::acos(cosAngle) * radiansToDegrees;
+      localNonOrthogonality.add(angle, iFace);
+      if (angle > severeNonOrthogonality) {
+        localSevere++;
+      }
+
+      // gf is the fraction of CN at which CN crosses the plane of the face
+      const std::array<double, 3> &ownerCentroid =
+          fvMesh.cells()[theFace.iOwner()].centroid();
+      std::array<double, 3> offset = {0.0, 0.0, 0.0};
+      for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+        offset[iCoordinate] = theFace.centroid()[iCoordinate] -
+                              ownerCentroid[iCoordinate] -
+                              theFace.gf() * theFace.CN()[iCoordinate];
+      }
+      localSkewness.add(mag(offset) / theFace.magCN(), iFace);
+
+      const double distance = theFace.gf() * SfDotCN / theFace.area();
+      ownerDistance[iFace] = std::fabs(distance);
+      neighborDistance[iFace] =
+          std::fabs(SfDotCN / theFace.area() - distance);
+    }
+
+#pragma omp for schedule(static) nowait
+    for (std::ptrdiff_t iElement = 0; iElement < nCells; ++iElement) {
+      Cell &theCell = fvMesh.cells()[iElement];
+      double minDistance = std::numeric_limits<double>::infinity();
+      double maxDistance = 0.0;
+      for (std::size_t i = 0; i < theCell.iFaces().size(); ++i) {
+        const std::size_t iFace = theCell.iFaces()[i];
+        const double distance = theCell.faceSigns()[i] > 0
+                                    ? ownerDistance[iFace]
+                                    : neighborDistance[iFace];
+        minDistance = std::min(minDistance, distance);
+        maxDistance = std::max(maxDistance, distance);
+      }
+      localAspectRatio.add(maxDistance / minDistance, iElement);
+    }
+
+#pragma omp critical
+    {
+      nonOrthogonality.merge(localNonOrthogonality);
+      skewness.merge(localSkewness);
+      aspectRatio.merge(localAspectRatio);
+      nSevere += localSevere;
+    }
+  }
+
+  MeshQualityReport report;
+  report.nonOrthogonality = nonOrthogonality.distribution();
+  report.skewness = skewness.distribution();
+  report.aspectRatio = aspectRatio.distribution();
+  report.nSevereNonOrthogonalFaces = nSevere;
+  return report;
+}
+
+void MeshQuality::writeSummary(const MeshQualityReport &report,
+                               std::ostream &os) const {
+  os << "Mesh quality\n";
+  writeDistribution("Non-orthogonality [deg]", report.nonOrthogonality,
+                    "face", os);
+  os << "    severe (> " << severeNonOrthogonality
+     << " deg): " << report.nSevereNonOrthogonalFaces << " faces\n";
+  writeDistribution("Skewness", report.skewness, "face", os);
+  writeDistribution("Aspect ratio", report.aspectRatio, "cell", os);
+}
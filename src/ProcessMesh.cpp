@@ -1,8 +1,12 @@
 #include "ProcessMesh.hpp"
 #include "arrayOperations.hpp"
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace std::string_literals;
@@ -17,189 +21,661 @@ using namespace std::string_literals;
 // }
 // *******************
 
-void ProcessMesh::processOpenFoamMesh(Mesh &fvMesh) {
-  processBasicFaceGeometry(fvMesh);
-  computeElementVolumeAndCentroid(fvMesh);
-  processSecondaryFaceGeometry(fvMesh);
-  sortBoundaryNodesFromInteriorNodes(fvMesh);
-  labelBoundaryFaces(fvMesh);
+namespace {
+
+// Number of faces gathered into one block of the shape-specialized kernels
+constexpr std::size_t faceBlockSize = 64;
+
+// Basic geometry of a block of faces that all have N nodes. The node
+// coordinates are gathered into structure-of-arrays form so that the
+// arithmetic vectorizes across the faces of the block. Triangles use the
+// closed formula and larger polygons the sub-triangles around the node
+// average, in the operation order of processBasicFaceGeometry.
+template <std::size_t N>
+void processFaceBlock(Mesh &fvMesh, const std::size_t *iFaces,
+                      std::size_t nBlockFaces) {
+  static_assert(N >= 3, "A face has at least three nodes");
+  double x[3][N][faceBlockSize];
+  for (std::size_t b = 0; b < nBlockFaces; ++b) {
+    const std::vector<std::size_t> &iNodes = fvMesh.faces()[iFaces[b]].iNodes();
+    for (std::size_t k = 0; k < N; ++k) {
+      const std::array<double, 3> &node = fvMesh.nodes()[iNodes[k]].centroid();
+      x[0][k][b] = node[0];
+      x[1][k][b] = node[1];
+      x[2][k][b] = node[2];
+    }
+  }
+
+  double centroid[3][faceBlockSize];
+  double Sf[3][faceBlockSize];
+  double area[faceBlockSize];
+  if constexpr (N == 3) {
+#pragma omp simd
+    for (std::size_t b = 0; b < nBlockFaces; ++b) {
+      centroid[0][b] = (x[0][0][b] + x[0][1][b] + x[0][2][b]) / 3.0;
+      centroid[1][b] = (x[1][0][b] + x[1][1][b] + x[1][2][b]) / 3.0;
+      centroid[2][b] = (x[2][0][b] + x[2][1][b] + x[2][2][b]) / 3.0;
+      const double ax = x[0][1][b] - x[0][0][b];
+      const double ay = x[1][1][b] - x[1][0][b];
+      const double az = x[2][1][b] - x[2][0][b];
+      const double bx = x[0][2][b] - x[0][0][b];
+      const double by = x[1][2][b] - x[1][0][b];
+      const double bz = x[2][2][b] - x[2][0][b];
+      Sf[0][b] = 0.5 * (ay * bz - az * by);
+      Sf[1][b] = 0.5 * (az * bx - ax * bz);
+      Sf[2][b] = 0.5 * (ax * by - ay * bx);
+      area[b] = std::sqrt(Sf[0][b] * Sf[0][b] + Sf[1][b] * Sf[1][b] +
+                          Sf[2][b] * Sf[2][b]);
+    }
+  } else {
+    // The loops over the nodes are outside so that the loops over the faces
+    // of the block are the vectorized inner loops
+    double center[3][faceBlockSize];
+    for (std::size_t c = 0; c < 3; ++c) {
+#pragma omp simd
+      for (std::size_t b = 0; b < nBlockFaces; ++b) {
+        center[c][b] = 0.0;
+        centroid[c][b] = 0.0;
+        Sf[c][b] = 0.0;
+      }
+      for (std::size_t k = 0; k < N; ++k) {
+#pragma omp simd
+        for (std::size_t b = 0; b < nBlockFaces; ++b) {
+          center[c][b] += x[c][k][b];
+        }
+      }
+#pragma omp simd
+      for (std::size_t b = 0; b < nBlockFaces; ++b) {
+        center[c][b] /= static_cast<double>(N);
+      }
+    }
+
+    for (std::size_t k = 0; k < N; ++k) {
+      const std::size_t kNext = k + 1 < N ? k + 1 : 0;
+#pragma omp simd
+      for (std::size_t b = 0; b < nBlockFaces; ++b) {
+        const double ax = x[0][k][b] - center[0][b];
+        const double ay = x[1][k][b] - center[1][b];
+        const double az = x[2][k][b] - center[2][b];
+        const double bx = x[0][kNext][b] - center[0][b];
+        const double by = x[1][kNext][b] - center[1][b];
+        const double bz = x[2][kNext][b] - center[2][b];
+        const double localSfX = 0.5 * (ay * bz - az * by);
+        const double localSfY = 0.5 * (az * bx - ax * bz);
+        const double localSfZ = 0.5 * (ax * by - ay * bx);
+        const double localArea = std::sqrt(
+            localSfX * localSfX + localSfY * localSfY + localSfZ * localSfZ);
+        centroid[0][b] +=
+            localArea * ((center[0][b] + x[0][k][b] + x[0][kNext][b]) / 3.0);
+        centroid[1][b] +=
+            localArea * ((center[1][b] + x[1][k][b] + x[1][kNext][b]) / 3.0);
+        centroid[2][b] +=
+            localArea * ((center[2][b] + x[2][k][b] + x[2][kNext][b]) / 3.0);
+        Sf[0][b] += localSfX;
+        Sf[1][b] += localSfY;
+        Sf[2][b] += localSfZ;
+      }
+    }
+
+#pragma omp simd
+    for (std::size_t b = 0; b < nBlockFaces; ++b) {
+      area[b] = std::sqrt(Sf[0][b] * Sf[0][b] + Sf[1][b] * Sf[1][b] +
+                          Sf[2][b] * Sf[2][b]);
+      centroid[0][b] /= area[b];
+      centroid[1][b] /= area[b];
+      centroid[2][b] /= area[b];
+    }
+  }
+
+  for (std::size_t b = 0; b < nBlockFaces; ++b) {
+    Face &theFace = fvMesh.faces()[iFaces[b]];
+    theFace.centroid() = {centroid[0][b], centroid[1][b], centroid[2][b]};
+    theFace.Sf() = {Sf[0][b], Sf[1][b], Sf[2][b]};
+    theFace.area() = area[b];
+  }
 }
 
-void ProcessMesh::processBasicFaceGeometry(Mesh &fvMesh) {
-  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+// Run a block kernel over a bucket of faces, one block per iteration of a
+// work-shared loop of the enclosing parallel region
+template <std::size_t N>
+void processFaceBucket(Mesh &fvMesh, const std::vector<std::size_t> &bucket) {
+  const auto nBlocks = static_cast<std::ptrdiff_t>(
+      (bucket.size() + faceBlockSize - 1) / faceBlockSize);
+#pragma omp for schedule(static) nowait
+  for (std::ptrdiff_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+    const std::size_t begin = iBlock * faceBlockSize;
+    processFaceBlock<N>(fvMesh, bucket.data() + begin,
+                        std::min(faceBlockSize, bucket.size() - begin));
+  }
+}
 
-    std::array<double, 3> centroid = {0.0, 0.0, 0.0};
-    std::array<double, 3> Sf = {0.0, 0.0, 0.0};
-    double area = 0.0;
+// Volume swept by the triangle (a, b, c) while its nodes move linearly by
+// (da, db, dc), positive along its area vector. The area vector is quadratic
+// in time and the mean velocity over the triangle is constant, so Simpson's
+// rule integrates the swept volume exactly.
+double triangleSweptVolume(const std::array<double, 3> &a,
+                           const std::array<double, 3> &b,
+                           const std::array<double, 3> &c,
+                           const std::array<double, 3> &da,
+                           const std::array<double, 3> &db,
+                           const std::array<double, 3> &dc) {
+  auto areaVector = [&](double t) {
+    std::array<double, 3> at, bt, ct;
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      at[iCoordinate] = a[iCoordinate] + t * da[iCoordinate];
+      bt[iCoordinate] = b[iCoordinate] + t * db[iCoordinate];
+      ct[iCoordinate] = c[iCoordinate] + t * dc[iCoordinate];
+    }
+    return 0.5 * cross_product(bt - at, ct - at);
+  };
+  const std::array<double, 3> S0 = areaVector(0.0);
+  const std::array<double, 3> SHalf = areaVector(0.5);
+  const std::array<double, 3> S1 = areaVector(1.0);
+
+  double sweptVolume = 0.0;
+  for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+    const double meanS =
+        (S0[iCoordinate] + 4.0 * SHalf[iCoordinate] + S1[iCoordinate]) / 6.0;
+    const double meanD =
+        (da[iCoordinate] + db[iCoordinate] + dc[iCoordinate]) / 3.0;
+    sweptVolume += meanS * meanD;
+  }
+  return sweptVolume;
+}
 
-    // Consider a special case where the polygon is a triangle
-    if (fvMesh.faces()[iFace].nNodes() == 3) {
+// Volume swept by a face, split into the same sub-triangles around the node
+// average as processBasicFaceGeometry
+double faceSweptVolume(Mesh &fvMesh, Face &theFace,
+                       const std::vector<std::array<double, 3>> &d) {
+  const std::vector<std::size_t> &iNodes = theFace.iNodes();
+  const std::size_t nNodes = theFace.nNodes();
+  if (nNodes == 3) {
+    return triangleSweptVolume(fvMesh.nodes()[iNodes[0]].centroid(),
+                               fvMesh.nodes()[iNodes[1]].centroid(),
+                               fvMesh.nodes()[iNodes[2]].centroid(), d[0],
+                               d[1], d[2]);
+  }
 
-      std::array<double, 3> &triangleNode1 =
-          fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[0]].centroid();
-      std::array<double, 3> &triangleNode2 =
-          fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[1]].centroid();
-      std::array<double, 3> &triangleNode3 =
-          fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[2]].centroid();
+  std::array<double, 3> center = {0.0, 0.0, 0.0};
+  std::array<double, 3> dCenter = {0.0, 0.0, 0.0};
+  for (std::size_t iNode = 0; iNode < nNodes; ++iNode) {
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      center[iCoordinate] +=
+          fvMesh.nodes()[iNodes[iNode]].centroid()[iCoordinate];
+      dCenter[iCoordinate] += d[iNode][iCoordinate];
+    }
+  }
+  for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+    center[iCoordinate] /= static_cast<double>(nNodes);
+    dCenter[iCoordinate] /= static_cast<double>(nNodes);
+  }
 
-      for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
-        centroid[iCoordinate] =
-            (triangleNode1[iCoordinate] + triangleNode2[iCoordinate] +
-             triangleNode3[iCoordinate]) /
-            3.0;
+  double sweptVolume = 0.0;
+  for (std::size_t iNode = 0; iNode < nNodes; ++iNode) {
+    const std::size_t iNext = iNode + 1 < nNodes ? iNode + 1 : 0;
+    sweptVolume += triangleSweptVolume(
+        center, fvMesh.nodes()[iNodes[iNode]].centroid(),
+        fvMesh.nodes()[iNodes[iNext]].centroid(), dCenter, d[iNode], d[iNext]);
+  }
+  return sweptVolume;
+}
+
+} // namespace
+
+void ProcessMesh::processOpenFoamMesh(Mesh &fvMesh) {
+  const auto nFaces = static_cast<std::ptrdiff_t>(fvMesh.nFaces());
+  const auto nCells = static_cast<std::ptrdiff_t>(fvMesh.nCells());
+  const std::size_t nInteriorFaces = fvMesh.nInteriorFaces();
+
+  // Boundary faces of the empty front and back patches mark their nodes as
+  // interior nodes like the interior faces; all other boundary faces mark
+  // their nodes as boundary nodes, which takes precedence
+  std::vector<std::size_t> patchStarts(fvMesh.nBoundaries());
+  std::vector<char> isFrontAndBack(fvMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
+       ++iBoundary) {
+    Boundary &boundary = fvMesh.boundaries()[iBoundary];
+    patchStarts[iBoundary] = boundary.startFace();
+    isFrontAndBack[iBoundary] = boundary.userName() == "frontAndBack"s ||
+                                boundary.userName() == "frontAndBackPlanes"s;
+  }
+
+  // Patches are stored in face order, so a boundary face belongs to the last
+  // patch starting at or before it
+  auto patchOf = [&patchStarts](std::size_t iBFace) {
+    return static_cast<int>(std::upper_bound(patchStarts.begin(),
+                                             patchStarts.end(), iBFace) -
+                            patchStarts.begin()) -
+           1;
+  };
+
+  // Triangles and quadrilaterals go to the shape-specialized kernels
+  std::vector<std::size_t> triangles;
+  std::vector<std::size_t> quadrilaterals;
+  std::vector<std::size_t> polygons;
+  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+    switch (fvMesh.faces()[iFace].nNodes()) {
+    case 3:
+      triangles.push_back(iFace);
+      break;
+    case 4:
+      quadrilaterals.push_back(iFace);
+      break;
+    default:
+      polygons.push_back(iFace);
+    }
+  }
+  const auto nPolygons = static_cast<std::ptrdiff_t>(polygons.size());
+
+#pragma omp parallel
+  {
+    processFaceBucket<3>(fvMesh, triangles);
+    processFaceBucket<4>(fvMesh, quadrilaterals);
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t i = 0; i < nPolygons; ++i) {
+      processBasicFaceGeometry(fvMesh, polygons[i]);
+    }
+
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t iElement = 0; iElement < nCells; ++iElement) {
+      computeElementVolumeAndCentroid(fvMesh, iElement);
+    }
+
+    // Secondary geometry, patch labels and the interior node flags
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t iFace = 0; iFace < nFaces; ++iFace) {
+      processSecondaryFaceGeometry(fvMesh, iFace);
+
+      Face &theFace = fvMesh.faces()[iFace];
+      bool marksInteriorNodes = true;
+      if (static_cast<std::size_t>(iFace) >= nInteriorFaces) {
+        theFace.patchIndex() = patchOf(iFace);
+        marksInteriorNodes = theFace.patchIndex() >= 0 &&
+                             isFrontAndBack[theFace.patchIndex()];
       }
+      if (marksInteriorNodes) {
+        for (std::size_t iNode = 0; iNode < theFace.nNodes(); ++iNode) {
+#pragma omp atomic write
+          fvMesh.nodes()[theFace.iNodes()[iNode]].Flag() = 1;
+        }
+      }
+    }
 
-      // Calculate the surface area vector of a given triangle by cross
-      // product
-      Sf = 0.5 * cross_product(triangleNode2 - triangleNode1,
-                               triangleNode3 - triangleNode1);
-      area = mag(Sf);
-
-    } else { // General case where the polygon is not a triangle
-      std::array<double, 3> center = {0.0, 0.0, 0.0};
-      for (std::size_t iNode = 0; iNode < fvMesh.faces()[iFace].nNodes();
-           ++iNode) {
-        for (std::size_t iCoordinate = 0; iCoordinate < center.size();
-             ++iCoordinate)
-          center[iCoordinate] +=
-              fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[iNode]]
-                  .centroid()[iCoordinate];
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t iBFace = nInteriorFaces; iBFace < nFaces; ++iBFace) {
+      Face &theBFace = fvMesh.faces()[iBFace];
+      if (theBFace.patchIndex() >= 0 &&
+          !isFrontAndBack[theBFace.patchIndex()]) {
+        for (std::size_t iNode = 0; iNode < theBFace.nNodes(); ++iNode) {
+#pragma omp atomic write
+          fvMesh.nodes()[theBFace.iNodes()[iNode]].Flag() = 0;
+        }
       }
+    }
+  }
 
-      for (std::size_t iCoordinate = 0; iCoordinate < center.size();
-           ++iCoordinate) {
-        center[iCoordinate] /=
-            static_cast<double>(fvMesh.faces()[iFace].nNodes());
+  collectBoundaryGeometry(fvMesh);
+}
+
+void ProcessMesh::collectBoundaryGeometry(Mesh &fvMesh) {
+  for (auto &boundary : fvMesh.boundaries()) {
+    const std::size_t nFaces = boundary.nFaces();
+    boundary.faceOwners().resize(nFaces);
+    boundary.gDiff().resize(nFaces);
+    boundary.area().resize(nFaces);
+    boundary.Sf().resize(nFaces);
+    boundary.walldist().resize(nFaces);
+  }
+
+  const auto nInteriorFaces =
+      static_cast<std::ptrdiff_t>(fvMesh.nInteriorFaces());
+  const auto nFaces = static_cast<std::ptrdiff_t>(fvMesh.nFaces());
+#pragma omp parallel for schedule(static)
+  for (std::ptrdiff_t iBFace = nInteriorFaces; iBFace < nFaces; ++iBFace) {
+    storeBoundaryFaceGeometry(fvMesh, iBFace);
+  }
+}
+
+void ProcessMesh::updateSecondaryFaceGeometry(
+    Mesh &fvMesh, const std::vector<std::size_t> &faces) {
+  const auto nUpdatedFaces = static_cast<std::ptrdiff_t>(faces.size());
+#pragma omp parallel for schedule(static)
+  for (std::ptrdiff_t i = 0; i < nUpdatedFaces; ++i) {
+    processSecondaryFaceGeometry(fvMesh, faces[i]);
+  }
+}
+
+void ProcessMesh::moveNodes(
+    Mesh &fvMesh, const std::vector<std::size_t> &movedNodes,
+    const std::vector<std::array<double, 3>> &displacements) {
+  if (movedNodes.size() != displacements.size()) {
+    throw std::invalid_argument(
+        "Error: Number of moved nodes and displacements differ");
+  }
+
+  // Displacements sorted by node for the lookup of the face nodes
+  std::vector<std::pair<std::size_t, std::array<double, 3>>> moved;
+  moved.reserve(movedNodes.size());
+  for (std::size_t i = 0; i < movedNodes.size(); ++i) {
+    if (movedNodes[i] >= fvMesh.nNodes()) {
+      throw std::out_of_range("Error: Moved node index out of range");
+    }
+    moved.emplace_back(movedNodes[i], displacements[i]);
+  }
+  std::sort(moved.begin(), moved.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+  const auto duplicate = std::adjacent_find(
+      moved.begin(), moved.end(),
+      [](const auto &a, const auto &b) { return a.first == b.first; });
+  if (duplicate != moved.end()) {
+    throw std::invalid_argument("Error: Node " +
+                                std::to_string(duplicate->first) +
+                                " is moved more than once");
+  }
+
+  // The swept volumes and old volumes describe the last motion only
+  for (auto iFace : fvMesh.movedFaces()) {
+    fvMesh.faces()[iFace].sweptVolume() = 0.0;
+  }
+  for (auto iElement : fvMesh.movedCells()) {
+    fvMesh.cells()[iElement].oldVolume() = fvMesh.cells()[iElement].volume();
+  }
+  auto displacementOf = [&moved](std::size_t iNode) {
+    auto it = std::lower_bound(
+        moved.begin(), moved.end(), iNode,
+        [](const auto &entry, std::size_t i) { return entry.first < i; });
+    return it != moved.end() && it->first == iNode
+               ? it->second
+               : std::array<double, 3>{0.0, 0.0, 0.0};
+  };
+
+  // Faces touching a moved node
+  std::vector<std::size_t> &movedFaces = fvMesh.movedFaces();
+  movedFaces.clear();
+  for (const auto &entry : moved) {
+    const std::vector<std::size_t> &iFaces =
+        fvMesh.nodes()[entry.first].iFaces();
+    movedFaces.insert(movedFaces.end(), iFaces.begin(), iFaces.end());
+  }
+  std::sort(movedFaces.begin(), movedFaces.end());
+  movedFaces.erase(std::unique(movedFaces.begin(), movedFaces.end()),
+                   movedFaces.end());
+  const auto nMovedFaces = static_cast<std::ptrdiff_t>(movedFaces.size());
+
+  // Swept volumes from the old node positions
+#pragma omp parallel for schedule(static)
+  for (std::ptrdiff_t i = 0; i < nMovedFaces; ++i) {
+    Face &theFace = fvMesh.faces()[movedFaces[i]];
+    std::vector<std::array<double, 3>> d(theFace.nNodes());
+    for (std::size_t iNode = 0; iNode < theFace.nNodes(); ++iNode) {
+      d[iNode] = displacementOf(theFace.iNodes()[iNode]);
+    }
+    theFace.sweptVolume() = faceSweptVolume(fvMesh, theFace, d);
+  }
+
+  for (const auto &entry : moved) {
+    std::array<double, 3> &centroid = fvMesh.nodes()[entry.first].centroid();
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      centroid[iCoordinate] += entry.second[iCoordinate];
+    }
+  }
+
+  // Cells next to a moved face
+  std::vector<std::size_t> &movedCells = fvMesh.movedCells();
+  movedCells.clear();
+  for (auto iFace : movedFaces) {
+    movedCells.push_back(fvMesh.faces()[iFace].iOwner());
+    if (fvMesh.faces()[iFace].iNeighbor() >= 0) {
+      movedCells.push_back(fvMesh.faces()[iFace].iNeighbor());
+    }
+  }
+  std::sort(movedCells.begin(), movedCells.end());
+  movedCells.erase(std::unique(movedCells.begin(), movedCells.end()),
+                   movedCells.end());
+  const auto nMovedCells = static_cast<std::ptrdiff_t>(movedCells.size());
+
+  // The secondary geometry depends on the cell centroids on both sides, so it
+  // is updated for every face of a moved cell
+  std::vector<std::size_t> updatedFaces;
+  for (auto iElement : movedCells) {
+    const std::vector<std::size_t> &iFaces = fvMesh.cells()[iElement].iFaces();
+    updatedFaces.insert(updatedFaces.end(), iFaces.begin(), iFaces.end());
+  }
+  std::sort(updatedFaces.begin(), updatedFaces.end());
+  updatedFaces.erase(std::unique(updatedFaces.begin(), updatedFaces.end()),
+                     updatedFaces.end());
+  const auto nUpdatedFaces = static_cast<std::ptrdiff_t>(updatedFaces.size());
+
+#pragma omp parallel
+  {
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t i = 0; i < nMovedFaces; ++i) {
+      processBasicFaceGeometry(fvMesh, movedFaces[i]);
+    }
+
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t i = 0; i < nMovedCells; ++i) {
+      Cell &theCell = fvMesh.cells()[movedCells[i]];
+      const double oldVolume = theCell.volume();
+      computeElementVolumeAndCentroid(fvMesh, movedCells[i]);
+      theCell.oldVolume() = oldVolume;
+    }
+
+#pragma omp for schedule(static)
+    for (std::ptrdiff_t i = 0; i < nUpdatedFaces; ++i) {
+      processSecondaryFaceGeometry(fvMesh, updatedFaces[i]);
+      if (updatedFaces[i] >= fvMesh.nInteriorFaces()) {
+        storeBoundaryFaceGeometry(fvMesh, updatedFaces[i]);
       }
+    }
+  }
+}
 
-      /*
-      // Using the center to compute the area and centroid of virtual
-      // triangles based on the center and the face nodes
-      */
-      std::array<double, 3> triangleNode1 = center;
-      std::array<double, 3> triangleNode2 = {0.0, 0.0, 0.0};
-      std::array<double, 3> triangleNode3 = {0.0, 0.0, 0.0};
-
-      for (std::size_t iNode = 0; iNode < fvMesh.faces()[iFace].nNodes();
-           ++iNode) {
-        triangleNode2 =
-            fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[iNode]].centroid();
-        if (iNode < fvMesh.faces()[iFace].nNodes() - 1) {
-          triangleNode3 =
-              fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[iNode + 1]]
-                  .centroid();
-        } else {
-          triangleNode3 =
-              fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[0]].centroid();
-        }
+void ProcessMesh::moveNodes(
+    Mesh &fvMesh, const std::vector<std::array<double, 3>> &displacementField) {
+  if (displacementField.size() != fvMesh.nNodes()) {
+    throw std::invalid_argument(
+        "Error: Displacement field size does not match the number of nodes");
+  }
+  std::vector<std::size_t> movedNodes;
+  std::vector<std::array<double, 3>> displacements;
+  for (std::size_t iNode = 0; iNode < displacementField.size(); ++iNode) {
+    const std::array<double, 3> &d = displacementField[iNode];
+    if (d[0] != 0.0 || d[1] != 0.0 || d[2] != 0.0) {
+      movedNodes.push_back(iNode);
+      displacements.push_back(d);
+    }
+  }
+  moveNodes(fvMesh, movedNodes, displacements);
+}
 
-        // Calculate the centroid of a given subtriangle
-        std::array<double, 3> local_centroid = {0.0, 0.0, 0.0};
-        for (std::size_t iCoordinate = 0; iCoordinate < local_centroid.size();
-             ++iCoordinate) {
-          local_centroid[iCoordinate] =
-              (triangleNode1[iCoordinate] + triangleNode2[iCoordinate] +
-               triangleNode3[iCoordinate]) /
-              3.0;
-        }
+void ProcessMesh::processBasicFaceGeometry(Mesh &fvMesh, std::size_t iFace) {
+  std::array<double, 3> centroid = {0.0, 0.0, 0.0};
+  std::array<double, 3> Sf = {0.0, 0.0, 0.0};
+  double area = 0.0;
+
+  // Consider a special case where the polygon is a triangle
+  if (fvMesh.faces()[iFace].nNodes() == 3) {
+
+    std::array<double, 3> &triangleNode1 =
+        fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[0]].centroid();
+    std::array<double, 3> &triangleNode2 =
+        fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[1]].centroid();
+    std::array<double, 3> &triangleNode3 =
+        fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[2]].centroid();
+
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      centroid[iCoordinate] =
+          (triangleNode1[iCoordinate] + triangleNode2[iCoordinate] +
+           triangleNode3[iCoordinate]) /
+          3.0;
+    }
 
-        // Calculate the surface area vector of a given subtriangle by cross
-        // product
-        std::array<double, 3> local_Sf = {0.0, 0.0, 0.0};
+    // Calculate the surface area vector of a given triangle by cross
+    // product
+    Sf = 0.5 * cross_product(triangleNode2 - triangleNode1,
+                             triangleNode3 - triangleNode1);
+    area = mag(Sf);
 
-        local_Sf = 0.5 * cross_product(triangleNode2 - triangleNode1,
-                                       triangleNode3 - triangleNode1);
+  } else { // General case where the polygon is not a triangle
+    std::array<double, 3> center = {0.0, 0.0, 0.0};
+    for (std::size_t iNode = 0; iNode < fvMesh.faces()[iFace].nNodes();
+         ++iNode) {
+      for (std::size_t iCoordinate = 0; iCoordinate < center.size();
+           ++iCoordinate)
+        center[iCoordinate] +=
+            fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[iNode]]
+                .centroid()[iCoordinate];
+    }
 
-        // Calculate the surface area of a given subtriangle
-        double local_area = mag(local_Sf);
+    for (std::size_t iCoordinate = 0; iCoordinate < center.size();
+         ++iCoordinate) {
+      center[iCoordinate] /=
+          static_cast<double>(fvMesh.faces()[iFace].nNodes());
+    }
 
-        for (std::size_t iCoordinate = 0; iCoordinate < centroid.size();
-             ++iCoordinate) {
-          centroid[iCoordinate] += local_area * local_centroid[iCoordinate];
-          Sf[iCoordinate] += local_Sf[iCoordinate];
-        }
+    /*
+    // Using the center to compute the area and centroid of virtual
+    // triangles based on the center and the face nodes
+    */
+    std::array<double, 3> triangleNode1 = center;
+    std::array<double, 3> triangleNode2 = {0.0, 0.0, 0.0};
+    std::array<double, 3> triangleNode3 = {0.0, 0.0, 0.0};
+
+    for (std::size_t iNode = 0; iNode < fvMesh.faces()[iFace].nNodes();
+         ++iNode) {
+      triangleNode2 =
+          fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[iNode]].centroid();
+      if (iNode < fvMesh.faces()[iFace].nNodes() - 1) {
+        triangleNode3 =
+            fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[iNode + 1]]
+                .centroid();
+      } else {
+        triangleNode3 =
+            fvMesh.nodes()[fvMesh.faces()[iFace].iNodes()[0]].centroid();
       }
-      area = mag(Sf);
 
-      // Compute centroid of the polygon
+      // Calculate the centroid of a given subtriangle
+      std::array<double, 3> local_centroid = {0.0, 0.0, 0.0};
+      for (std::size_t iCoordinate = 0; iCoordinate < local_centroid.size();
+           ++iCoordinate) {
+        local_centroid[iCoordinate] =
+            (triangleNode1[iCoordinate] + triangleNode2[iCoordinate] +
+             triangleNode3[iCoordinate]) /
+            3.0;
+      }
+
+      // Calculate the surface area vector of a given subtriangle by cross
+      // product
+      std::array<double, 3> local_Sf = {0.0, 0.0, 0.0};
+
+      local_Sf = 0.5 * cross_product(triangleNode2 - triangleNode1,
+                                     triangleNode3 - triangleNode1);
+
+      // Calculate the surface area of a given subtriangle
+      double local_area = mag(local_Sf);
+
       for (std::size_t iCoordinate = 0; iCoordinate < centroid.size();
            ++iCoordinate) {
-        centroid[iCoordinate] /= area;
+        centroid[iCoordinate] += local_area * local_centroid[iCoordinate];
+        Sf[iCoordinate] += local_Sf[iCoordinate];
       }
     }
-    fvMesh.faces()[iFace].centroid() = centroid;
-    fvMesh.faces()[iFace].Sf() = Sf;
-    fvMesh.faces()[iFace].area() = area;
+    area = mag(Sf);
+
+    // Compute centroid of the polygon
+    for (std::size_t iCoordinate = 0; iCoordinate < centroid.size();
+         ++iCoordinate) {
+      centroid[iCoordinate] /= area;
+    }
   }
+  fvMesh.faces()[iFace].centroid() = centroid;
+  fvMesh.faces()[iFace].Sf() = Sf;
+  fvMesh.faces()[iFace].area() = area;
 }
 
-void ProcessMesh::computeElementVolumeAndCentroid(Mesh &fvMesh) {
-  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
-    const std::vector<std::size_t> &iFaces = fvMesh.cells()[iElement].iFaces();
-
-    // Compute the geometric center of the element
-    std::array<double, 3> elementCenter = {0.0, 0.0, 0.0};
-    for (auto iFace : iFaces) {
-      for (auto iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
-        elementCenter[iCoordinate] +=
-            fvMesh.faces()[iFace].centroid()[iCoordinate];
-      }
-    }
+void ProcessMesh::computeElementVolumeAndCentroid(Mesh &fvMesh,
+                                                  std::size_t iElement) {
+  const std::vector<std::size_t> &iFaces = fvMesh.cells()[iElement].iFaces();
 
+  // Compute the geometric center of the element
+  std::array<double, 3> elementCenter = {0.0, 0.0, 0.0};
+  for (auto iFace : iFaces) {
     for (auto iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
-      elementCenter[iCoordinate] /= iFaces.size();
+      elementCenter[iCoordinate] +=
+          fvMesh.faces()[iFace].centroid()[iCoordinate];
     }
+  }
+
+  for (auto iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+    elementCenter[iCoordinate] /= iFaces.size();
+  }
 
-    // Compute volume and centroid of each element
-    std::array<double, 3> elementCentroid = {0.0, 0.0, 0.0};
-    std::array<double, 3> localVolumeCentroidSum = {0.0, 0.0, 0.0};
-    double localVolumeSum = 0.0;
+  // Compute volume and centroid of each element
+  std::array<double, 3> elementCentroid = {0.0, 0.0, 0.0};
+  std::array<double, 3> localVolumeCentroidSum = {0.0, 0.0, 0.0};
+  double localVolumeSum = 0.0;
 
-    for (std::size_t iFace = 0; iFace < iFaces.size(); ++iFace) {
-      Face &localFace = fvMesh.faces()[iFaces[iFace]];
-      const int localFaceSign = fvMesh.cells()[iElement].faceSigns()[iFace];
-      std::array<double, 3> Sf = {0.0, 0.0, 0.0};
+  for (std::size_t iFace = 0; iFace < iFaces.size(); ++iFace) {
+    Face &localFace = fvMesh.faces()[iFaces[iFace]];
+    const int localFaceSign = fvMesh.cells()[iElement].faceSigns()[iFace];
+    std::array<double, 3> Sf = {0.0, 0.0, 0.0};
 
-      Sf = localFaceSign * localFace.Sf();
+    Sf = localFaceSign * localFace.Sf();
 
-      // Calculate the distance vector from geometric center to the face
-      // centroid
-      std::array<double, 3> d_Gf = {0.0, 0.0, 0.0};
-      d_Gf = localFace.centroid() - elementCenter;
+    // Calculate the distance vector from geometric center to the face
+    // centroid
+    std::array<double, 3> d_Gf = {0.0, 0.0, 0.0};
+    d_Gf = localFace.centroid() - elementCenter;
 
-      // Calculate the volume of each sub-element pyramid
-      double localVolume =
-          (Sf[0] * d_Gf[0] + Sf[1] * d_Gf[1] + Sf[2] * d_Gf[2]) / 3.0;
+    // Calculate the volume of each sub-element pyramid
+    double localVolume =
+        (Sf[0] * d_Gf[0] + Sf[1] * d_Gf[1] + Sf[2] * d_Gf[2]) / 3.0;
 
-      localVolumeSum += localVolume;
+    localVolumeSum += localVolume;
 
-      // Calculate volume-weighted center of sub-element pyramid (centroid)
-      std::array<double, 3> localCentroid = {0.0, 0.0, 0.0};
-      for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
-        localCentroid[iCoordinate] = 0.75 * localFace.centroid()[iCoordinate] +
-                                     0.25 * elementCenter[iCoordinate];
-      }
+    // Calculate volume-weighted center of sub-element pyramid (centroid)
+    std::array<double, 3> localCentroid = {0.0, 0.0, 0.0};
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      localCentroid[iCoordinate] = 0.75 * localFace.centroid()[iCoordinate] +
+                                   0.25 * elementCenter[iCoordinate];
+    }
 
-      for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
-        localVolumeCentroidSum[iCoordinate] +=
-            localCentroid[iCoordinate] * localVolume;
-      }
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      localVolumeCentroidSum[iCoordinate] +=
+          localCentroid[iCoordinate] * localVolume;
     }
+  }
 
-    // Compute the centroid of the element
-    fvMesh.cells()[iElement].centroid() =
-        (1 / localVolumeSum) * localVolumeCentroidSum;
+  // Compute the centroid of the element
+  fvMesh.cells()[iElement].centroid() =
+      (1 / localVolumeSum) * localVolumeCentroidSum;
 
-    fvMesh.cells()[iElement].volume() = localVolumeSum;
-    fvMesh.cells()[iElement].oldVolume() = localVolumeSum;
+  fvMesh.cells()[iElement].volume() = localVolumeSum;
+  fvMesh.cells()[iElement].oldVolume() = localVolumeSum;
+
+  // Number the matrix coefficients of the interior faces in the order of the
+  // element neighbors
+  std::vector<std::size_t> &iNeighbors = fvMesh.cells()[iElement].iNeighbors();
+  std::size_t kf = 1;
+  for (std::size_t i = 0; i < iNeighbors.size(); ++i) {
+    const std::size_t iFace = iFaces[i];
+    if (fvMesh.faces()[iFace].iOwner() == iElement) {
+      fvMesh.faces()[iFace].iOwnerNeighborCoef() = kf;
+
+    } else if (fvMesh.faces()[iFace].iNeighbor() == iElement) {
+      fvMesh.faces()[iFace].iNeighborOwnerCoef() = kf;
+    }
+    kf++;
   }
 }
 
-void ProcessMesh::processSecondaryFaceGeometry(Mesh &fvMesh) {
-  // Loop over interiror faces
-  for (std::size_t iFace = 0; iFace < fvMesh.nInteriorFaces(); ++iFace) {
-    Face &theFace = fvMesh.faces()[iFace];
+void ProcessMesh::processSecondaryFaceGeometry(Mesh &fvMesh,
+                                               std::size_t iFace) {
+  Face &theFace = fvMesh.faces()[iFace];
 
+  if (iFace < fvMesh.nInteriorFaces()) { // If it is an interior face
     // Compute unit surface normal vector
     std::array<double, 3> nf = {0.0, 0.0, 0.0};
     nf = (1 / theFace.area()) * theFace.Sf();
@@ -209,21 +685,21 @@ void ProcessMesh::processSecondaryFaceGeometry(Mesh &fvMesh) {
 
     std::array<double, 3> CN = {0.0, 0.0, 0.0};
     CN = neighborElement.centroid() - ownerElement.centroid();
-    fvMesh.faces()[iFace].CN() = CN;
+    theFace.CN() = CN;
 
     std::array<double, 3> eCN = {0.0, 0.0, 0.0};
     const double magCN = mag(CN);
-    fvMesh.faces()[iFace].magCN() = magCN;
+    theFace.magCN() = magCN;
     eCN = (1 / magCN) * CN;
 
-    fvMesh.faces()[iFace].eCN() = eCN;
+    theFace.eCN() = eCN;
 
     std::array<double, 3> E = {0.0, 0.0, 0.0};
     E = theFace.area() * eCN;
 
-    fvMesh.faces()[iFace].gDiff() = mag(E) / magCN;
+    theFace.gDiff() = mag(E) / magCN;
 
-    fvMesh.faces()[iFace].T() = theFace.Sf() - E;
+    theFace.T() = theFace.Sf() - E;
 
     // Compute face weighting factor
     std::array<double, 3> Cf = {0.0, 0.0, 0.0};
@@ -232,138 +708,50 @@ void ProcessMesh::processSecondaryFaceGeometry(Mesh &fvMesh) {
     std::array<double, 3> fF = {0.0, 0.0, 0.0};
     fF = neighborElement.centroid() - theFace.centroid();
 
-    fvMesh.faces()[iFace].gf() =
+    theFace.gf() =
         dot_product(Cf, nf) / (dot_product(Cf, nf) + dot_product(fF, nf));
 
-    // fvMesh.faces()[iFace].walldist() = 0.0; Default value = 0.0
-  }
-
-  // Loop over boundary faces
-  for (std::size_t iBFace = fvMesh.nInteriorFaces(); iBFace < fvMesh.nFaces();
-       ++iBFace) {
-    Face &theBFace = fvMesh.faces()[iBFace];
+    // theFace.walldist() = 0.0; Default value = 0.0
 
-    // Compute unit surface normal vector
-    std::array<double, 3> nf = {0.0, 0.0, 0.0};
-    // for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
-    //   nf[iCoordinate] = theBFace.Sf()[iCoordinate] / theBFace.area();
-    // }
-
-    Cell &ownerElement = fvMesh.cells()[theBFace.iOwner()];
+  } else { // If it is a boundary face
+    Cell &ownerElement = fvMesh.cells()[theFace.iOwner()];
 
     std::array<double, 3> CN = {0.0, 0.0, 0.0};
-    CN = theBFace.centroid() - ownerElement.centroid();
+    CN = theFace.centroid() - ownerElement.centroid();
 
-    fvMesh.faces()[iBFace].CN() = CN;
+    theFace.CN() = CN;
 
-    fvMesh.faces()[iBFace].gDiff() =
-        theBFace.area() * theBFace.area() / dot_product(CN, theBFace.Sf());
+    theFace.gDiff() =
+        theFace.area() * theFace.area() / dot_product(CN, theFace.Sf());
 
     std::array<double, 3> eCN = {0.0, 0.0, 0.0};
     const double magCN = mag(CN);
-    fvMesh.faces()[iBFace].magCN() = magCN;
+    theFace.magCN() = magCN;
 
     eCN = (1 / magCN) * CN;
 
-    fvMesh.faces()[iBFace].eCN() = eCN;
+    theFace.eCN() = eCN;
 
     std::array<double, 3> E = {0.0, 0.0, 0.0};
-    E = theBFace.area() * eCN;
-
-    fvMesh.faces()[iBFace].T() = theBFace.Sf() - E;
-
-    fvMesh.faces()[iBFace].gf() = 1.0;
-    fvMesh.faces()[iBFace].walldist() =
-        dot_product(CN, theBFace.Sf()) / mag(theBFace.Sf());
-  }
-
-  // Loop over cells
-  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
-    std::vector<std::size_t> &iFaces = fvMesh.cells()[iElement].iFaces();
-    std::vector<std::size_t> &iNeighbors =
-        fvMesh.cells()[iElement].iNeighbors();
-
-    std::size_t kf = 1;
+    E = theFace.area() * eCN;
 
-    // Loop over local interior faces of an element
-    for (std::size_t i = 0; i < iNeighbors.size(); ++i) {
-      const std::size_t iFace = iFaces[i];
-      if (fvMesh.faces()[iFace].iOwner() == iElement) {
-        fvMesh.faces()[iFace].iOwnerNeighborCoef() = kf;
+    theFace.T() = theFace.Sf() - E;
 
-      } else if (fvMesh.faces()[iFace].iNeighbor() == iElement) {
-        fvMesh.faces()[iFace].iNeighborOwnerCoef() = kf;
-      }
-      kf++;
-    }
+    theFace.gf() = 1.0;
+    theFace.walldist() = dot_product(CN, theFace.Sf()) / mag(theFace.Sf());
   }
 }
 
-void ProcessMesh::sortBoundaryNodesFromInteriorNodes(Mesh &fvMesh) {
-  for (std::size_t iFace = 0; iFace < fvMesh.nInteriorFaces(); ++iFace) {
-    // fvMesh.faces()[iFace].patchIndex() = 0;
-
-    std::vector<std::size_t> &iNodes = fvMesh.faces()[iFace].iNodes();
-    std::size_t nNodes = fvMesh.faces()[iFace].nNodes();
-    for (std::size_t iNode = 0; iNode < nNodes; ++iNode) {
-      fvMesh.nodes()[iNodes[iNode]].Flag() = 1;
-    }
-  }
-
-  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
-       ++iBoundary) {
-    const std::size_t &startFace = fvMesh.boundaries()[iBoundary].startFace();
-    const std::size_t &nBFaces = fvMesh.boundaries()[iBoundary].nFaces();
-
-    bool s1 = (fvMesh.boundaries()[iBoundary].userName() == "frontAndBack"s);
-    bool s2 =
-        (fvMesh.boundaries()[iBoundary].userName() == "frontAndBackPlanes"s);
-    if (s1 || s2) {
-      for (std::size_t iFace = startFace; iFace < startFace + nBFaces;
-           ++iFace) {
-
-        std::vector<std::size_t> &iNodes = fvMesh.faces()[iFace].iNodes();
-        const std::size_t &nNodes = fvMesh.faces()[iFace].nNodes();
-
-        for (std::size_t iNode = 0; iNode < nNodes; ++iNode) {
-          fvMesh.nodes()[iNodes[iNode]].Flag() = 1;
-        }
-      }
-    }
-  }
-
-  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
-       ++iBoundary) {
-    const std::size_t &startFace = fvMesh.boundaries()[iBoundary].startFace();
-    const std::size_t &nBFaces = fvMesh.boundaries()[iBoundary].nFaces();
-
-    bool s1 = (fvMesh.boundaries()[iBoundary].userName() == "frontAndBack"s);
-    bool s2 =
-        (fvMesh.boundaries()[iBoundary].userName() == "frontAndBackPlanes"s);
-    if (!s1 && !s2) {
-      for (std::size_t iFace = startFace; iFace < startFace + nBFaces;
-           ++iFace) {
-        // fvMesh.faces()[iFace].patchIndex() = iBoundary;
-
-        std::vector<std::size_t> &iNodes = fvMesh.faces()[iFace].iNodes();
-        const std::size_t &nNodes = fvMesh.faces()[iFace].nNodes();
-
-        for (std::size_t iNode = 0; iNode < nNodes; ++iNode) {
-          fvMesh.nodes()[iNodes[iNode]].Flag() = 0;
-        }
-      }
-    }
+void ProcessMesh::storeBoundaryFaceGeometry(Mesh &fvMesh, std::size_t iFace) {
+  Face &theFace = fvMesh.faces()[iFace];
+  if (theFace.patchIndex() < 0) {
+    return;
   }
+  Boundary &boundary = fvMesh.boundaries()[theFace.patchIndex()];
+  const std::size_t iPatchFace = iFace - boundary.startFace();
+  boundary.faceOwners()[iPatchFace] = theFace.iOwner();
+  boundary.gDiff()[iPatchFace] = theFace.gDiff();
+  boundary.area()[iPatchFace] = theFace.area();
+  boundary.Sf()[iPatchFace] = theFace.Sf();
+  boundary.walldist()[iPatchFace] = theFace.walldist();
 }
-
-void ProcessMesh::labelBoundaryFaces(Mesh &fvMesh) {
-  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
-       ++iBoundary) {
-    const std::size_t &startFace = fvMesh.boundaries()[iBoundary].startFace();
-    const std::size_t &nBFaces = fvMesh.boundaries()[iBoundary].nFaces();
-
-    for (std::size_t iFace = startFace; iFace < startFace + nBFaces; ++iFace) {
-      fvMesh.faces()[iFace].patchIndex() = iBoundary;
-    }
-  }
-}
\ No newline at end of file
@@ -1,172 +1,249 @@
 #include "ReadInitialBoundaryConditions.hpp"
-#include "IO.hpp"
-#include <fstream>
+#include "FoamTokenizer.hpp"
+#include "RenumberMesh.hpp"
+#include <exception>
 #include <iostream>
+#include <stdexcept>
 
 using namespace std::string_literals;
 
-void ReadInitialBoundaryConditions::readOpenFoamInitialBoundaryConditions(
-    Mesh &fvMesh, Field<std::array<double, 3>> &internalVelocityField, std::vector<boundaryField<std::array<double, 3>>> &boundaryVelocityFields, Field<double> &internalTemperatureField, std::vector<boundaryField<double>> &boundaryTemperatureFields)
-{
-
-  std::cout << "Reading initial and boundary conditions..." << std::endl;
+namespace {
 
-  readVelocityField(fvMesh, internalVelocityField, boundaryVelocityFields);
-  readTemperatureField(fvMesh, internalTemperatureField, boundaryTemperatureFields);
+void checkSize(FoamTokenizer &tokens, std::size_t size, std::size_t nElements)
+{
+  if (size != nElements) {
+    tokens.fail("List of " + std::to_string(size) + " values where " +
+                std::to_string(nElements) + " are expected");
+  }
+}
 
-  // TO DO:
-  // readPressureField(fvMesh);
+// Read the value of an entry, "uniform <value>" or "nonuniform List<...>
+// <list>", into a field. "$internalField" refers to a uniform internal field.
+template <typename ValueType>
+void readFieldValues(FoamTokenizer &tokens, Field<ValueType> &field,
+                     std::size_t nElements,
+                     const Field<ValueType> *internalField = nullptr)
+{
+  const std::string kind = tokens.word();
+  if (kind == "uniform"s) {
+    field.set(tokens.readValue<ValueType>());
+  } else if (kind == "nonuniform"s) {
+    tokens.word(); // List<scalar>, List<vector> or List<tensor>
+    field.resize(0); // Nothing to expand before the list is read
+    tokens.readList(field.values());
+    checkSize(tokens, field.size(), nElements);
+  } else if (kind == "$internalField"s && internalField != nullptr &&
+             internalField->isUniform()) {
+    field.set(internalField->uniformValue());
+  } else {
+    tokens.fail("Unsupported field value '" + kind + "'");
+  }
+  tokens.expect(';');
 }
 
-void ReadInitialBoundaryConditions::readVelocityField(
-    Mesh &fvMesh,
-    Field<std::array<double, 3>> &internalVelocityField,
-    std::vector<boundaryField<std::array<double, 3>>> &boundaryVelocityFields)
+// Read the value of an entry, uniform or nonuniform, into per-face values
+template <typename ValueType>
+void readFieldValues(FoamTokenizer &tokens, std::vector<ValueType> &values,
+                     std::size_t nElements)
 {
+  const std::string kind = tokens.word();
+  if (kind == "uniform"s) {
+    values.assign(nElements, tokens.readValue<ValueType>());
+  } else if (kind == "nonuniform"s) {
+    tokens.word();
+    tokens.readList(values);
+    checkSize(tokens, values.size(), nElements);
+  } else {
+    tokens.fail("Unsupported field value '" + kind + "'");
+  }
+  tokens.expect(';');
+}
 
-  std::string UFileName = fvMesh.caseDir() + "/0/U"s;
-  std::ifstream UFile(UFileName);
-  IO::ifFileOpened(UFile, UFileName);
+// Read the dictionary of a patch
+template <typename ValueType>
+void readPatch(FoamTokenizer &tokens, boundaryField<ValueType> &patchField,
+               const std::string &fieldName, const std::string &patchName,
+               std::size_t nFaces, const Field<ValueType> &internalField)
+{
+  patchField.resize(nFaces);
+  tokens.expect('{');
+  while (!tokens.peek().is('}')) {
+    const std::string keyword = tokens.word();
+    if (keyword == "type"s) {
+      const std::string typeName = tokens.word();
+      try {
+        patchField.setBoundaryType(typeName);
+      } catch (const std::invalid_argument &error) {
+        tokens.fail(error.what() + " for patch "s + patchName + " of field "s +
+                    fieldName);
+      }
+      if (typeName == "noSlip"s) {
+        patchField.set(ValueType{});
+      }
+      tokens.expect(';');
+    } else if (keyword == "value"s || keyword == "refValue"s) {
+      readFieldValues(tokens, patchField, nFaces, &internalField);
+    } else if (keyword == "gradient"s || keyword == "refGradient"s) {
+      readFieldValues(tokens, patchField.gradient(), nFaces);
+    } else if (keyword == "valueFraction"s) {
+      readFieldValues(tokens, patchField.valueFraction(), nFaces);
+    } else {
+      tokens.skipEntry();
+    }
+  }
+  tokens.expect('}');
+}
 
-  // Discard the file header and the specific line #17 about the dimensions
-  IO::discardLines(UFile, 18);
+} // namespace
 
-  // Read the internal velocity field
-  std::string word;
-  UFile >> word;
+void ReadInitialBoundaryConditions::readOpenFoamInitialBoundaryConditions(
+    Mesh &fvMesh, Field<std::array<double, 3>> &internalVelocityField, std::vector<boundaryField<std::array<double, 3>>> &boundaryVelocityFields, Field<double> &internalTemperatureField, std::vector<boundaryField<double>> &boundaryTemperatureFields,
+    Field<double> &internalPressureField,
+    std::vector<boundaryField<double>> &boundaryPressureFields,
+    const std::string &timeDirectory)
+{
 
-  if (word == "internalField"s) {
-    UFile >> word;
+  std::cout << "Reading initial and boundary conditions..." << std::endl;
 
-    if (word == "uniform"s) {
-      UFile.ignore(2); // Discard the space and the left parenthesis
-      std::array<double, 3> U = {0.0, 0.0, 0.0};
-      UFile >> U[0] >> U[1] >> U[2];
-      internalVelocityField.set(U);
+  // The files are independent, so reading takes as long as the largest one.
+  // Errors are passed on from the tasks to the caller.
+  std::array<std::exception_ptr, 3> errors;
+#pragma omp parallel
+#pragma omp single
+  {
+#pragma omp task shared(errors)
+    try {
+      readVelocityField(fvMesh, internalVelocityField, boundaryVelocityFields,
+                        timeDirectory);
+    } catch (...) {
+      errors[0] = std::current_exception();
+    }
+#pragma omp task shared(errors)
+    try {
+      readTemperatureField(fvMesh, internalTemperatureField,
+                           boundaryTemperatureFields, timeDirectory);
+    } catch (...) {
+      errors[1] = std::current_exception();
+    }
+#pragma omp task shared(errors)
+    try {
+      readPressureField(fvMesh, internalPressureField, boundaryPressureFields,
+                        timeDirectory);
+    } catch (...) {
+      errors[2] = std::current_exception();
     }
   }
 
-  // Read the boundary velocity field
-  const std::size_t nBoundaries = fvMesh.nBoundaries();
-  boundaryVelocityFields.resize(nBoundaries);
-
-  // Discard the rest of the line and the next line
-  IO::discardLines(UFile, 2);
-  UFile >> word;
-
-  if (word == "boundaryField"s) {
-    IO::discardLines(UFile, 2);
-    for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
-         ++iBoundary) {
-      UFile >> word;
-
-      if (word == fvMesh.boundaries()[iBoundary].userName()) {
-        boundaryVelocityFields[iBoundary].values().resize(
-            fvMesh.boundaries()[iBoundary].nFaces());
-
-        IO::discardLines(UFile, 2);
-        std::string token{""};
-        UFile >> token;
-
-        while (token != "}"s) {
-          if (token == "type"s) {
-            UFile >> boundaryVelocityFields[iBoundary].boundaryType();
-            boundaryVelocityFields[iBoundary].boundaryType().pop_back();
-
-            if (boundaryVelocityFields[iBoundary].boundaryType() == "noSlip"s) {
-              boundaryVelocityFields[iBoundary].set({0.0, 0.0, 0.0});
-            }
-
-          } else if (token == "value"s) {
-            UFile >> token;
-            if (token == "uniform"s) {
-              UFile.ignore(2); // Discard the space and the left parenthesis
-              std::array<double, 3> U = {0.0, 0.0, 0.0};
-              UFile >> U[0] >> U[1] >> U[2];
-              boundaryVelocityFields[iBoundary].set(U);
-            }
-          }
-          IO::discardLines(UFile);
-          UFile >> token;
-        }
-      }
+  for (const auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
     }
   }
-  UFile.close();
 }
 
-void ReadInitialBoundaryConditions::readTemperatureField(
-    Mesh &fvMesh,
-    Field<double> &internalTemperatureField,
-    std::vector<boundaryField<double>> &boundaryTemperatureFields)
+template <typename ValueType>
+void ReadInitialBoundaryConditions::readField(
+    Mesh &fvMesh, const std::string &fieldName,
+    Field<ValueType> &internalField,
+    std::vector<boundaryField<ValueType>> &boundaryFields,
+    const std::string &timeDirectory)
 {
+  FoamTokenizer tokens(fvMesh.caseDir() + "/"s + timeDirectory + "/"s +
+                       fieldName);
+  tokens.readHeader();
 
-  std::string TFileName = fvMesh.caseDir() + "/0/T"s;
-  std::ifstream TFile(TFileName);
-  IO::ifFileOpened(TFile, TFileName);
-
-  // Discard the file header and the specific line #17 about the dimensions
-  IO::discardLines(TFile, 18);
+  const std::size_t nBoundaries = fvMesh.nBoundaries();
+  boundaryFields.assign(nBoundaries, boundaryField<ValueType>());
+  std::vector<bool> patchRead(nBoundaries, false);
+
+  while (!tokens.atEnd()) {
+    const std::string keyword = tokens.word();
+
+    if (keyword == "internalField"s) {
+      // Nonuniform internal fields are written in the numbering of the mesh
+      // files
+      internalField.resize(fvMesh.nCells());
+      readFieldValues(tokens, internalField, fvMesh.nCells());
+      if (!internalField.isUniform()) {
+        RenumberMesh::toCurrentNumbering(fvMesh, internalField.values());
+      }
 
-  // Read the internal temperature field
-  std::string word;
-  TFile >> word;
+    } else if (keyword == "boundaryField"s) {
+      tokens.expect('{');
+      while (!tokens.peek().is('}')) {
+        const FoamToken patchName = tokens.next();
+        std::size_t iBoundary = 0;
+        while (iBoundary < nBoundaries &&
+               fvMesh.boundaries()[iBoundary].userName() != patchName.text) {
+          ++iBoundary;
+        }
+        // Entries of patches that the mesh does not have are skipped
+        if (iBoundary == nBoundaries) {
+          tokens.skipEntry();
+          continue;
+        }
+        readPatch(tokens, boundaryFields[iBoundary], fieldName, patchName.text,
+                  fvMesh.boundaries()[iBoundary].nFaces(), internalField);
+        patchRead[iBoundary] = true;
+      }
+      tokens.expect('}');
 
-  if (word == "internalField"s) {
-    TFile >> word;
-    if (word == "uniform"s) {
-      double temperature = 0.0;
-      TFile >> temperature;
-      internalTemperatureField.set(temperature);
+    } else {
+      tokens.skipEntry();
     }
   }
 
-  // Read the boundary temperature field
-  const std::size_t nBoundaries = fvMesh.nBoundaries();
-  boundaryTemperatureFields.resize(nBoundaries);
-
-  // Discard the rest of the line and the next line
-  IO::discardLines(TFile, 2);
-  TFile >> word;
-
-  if (word == "boundaryField"s) {
-    IO::discardLines(TFile, 2);
-    for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
-         ++iBoundary) {
-      TFile >> word;
-
-      if (word == fvMesh.boundaries()[iBoundary].userName()) {
-        boundaryTemperatureFields[iBoundary].values().resize(
-            fvMesh.boundaries()[iBoundary].nFaces());
-
-        IO::discardLines(TFile, 2);
-        std::string token{""};
-        TFile >> token;
-
-        while (token != "}"s) {
-          if (token == "type"s) {
-            TFile >> boundaryTemperatureFields[iBoundary].boundaryType();
-            boundaryTemperatureFields[iBoundary].boundaryType().pop_back();
-          } else if (token == "value"s) {
-            TFile >> token;
-            if (token == "uniform"s) {
-              double temperature = 0.0;
-              TFile >> temperature;
-              boundaryTemperatureFields[iBoundary].set(temperature);
-            }
-          }
-          IO::discardLines(TFile);
-          TFile >> token;
-        }
-      }
+  for (std::size_t iBoundary = 0; iBoundary < nBoundaries; ++iBoundary) {
+    if (!patchRead[iBoundary]) {
+      throw std::runtime_error("Error: No boundary condition for patch " +
+                               fvMesh.boundaries()[iBoundary].userName() +
+                               " in " + fieldName);
     }
   }
-  TFile.close();
 }
 
-// TO DO:
-// void ReadInitialBoundaryConditions::readPressureField(Mesh &fvMesh) {
-//   std::string pFileName = fvMesh.caseDir() + "/0/p";
-//   std::ifstream pFile(pFileName);
-//   IO::ifFileOpened(pFile, pFileName);
-// }
\ No newline at end of file
+// Explicit template instantiation for scalar, vector and tensor fields
+template void ReadInitialBoundaryConditions::readField(
+    Mesh &fvMesh, const std::string &fieldName, Field<double> &internalField,
+    std::vector<boundaryField<double>> &boundaryFields,
+    const std::string &timeDirectory);
+template void ReadInitialBoundaryConditions::readField(
+    Mesh &fvMesh, const std::string &fieldName,
+    Field<std::array<double, 3>> &internalField,
+    std::vector<boundaryField<std::array<double, 3>>> &boundaryFields,
+    const std::string &timeDirectory);
+template void ReadInitialBoundaryConditions::readField(
+    Mesh &fvMesh, const std::string &fieldName,
+    Field<std::array<double, 9>> &internalField,
+    std::vector<boundaryField<std::array<double, 9>>> &boundaryFields,
+    const std::string &timeDirectory);
+
+void ReadInitialBoundaryConditions::readVelocityField(
+    Mesh &fvMesh,
+    Field<std::array<double, 3>> &internalVelocityField,
+    std::vector<boundaryField<std::array<double, 3>>> &boundaryVelocityFields,
+    const std::string &timeDirectory)
+{
+  readField(fvMesh, "U"s, internalVelocityField, boundaryVelocityFields,
+            timeDirectory);
+}
+
+void ReadInitialBoundaryConditions::readTemperatureField(
+    Mesh &fvMesh,
+    Field<double> &internalTemperatureField,
+    std::vector<boundaryField<double>> &boundaryTemperatureFields,
+    const std::string &timeDirectory)
+{
+  readField(fvMesh, "T"s, internalTemperatureField, boundaryTemperatureFields,
+            timeDirectory);
+}
+
+void ReadInitialBoundaryConditions::readPressureField(
+    Mesh &fvMesh,
+    Field<double> &internalPressureField,
+    std::vector<boundaryField<double>> &boundaryPressureFields,
+    const std::string &timeDirectory)
+{
+  readField(fvMesh, "p"s, internalPressureField, boundaryPressureFields,
+            timeDirectory);
+}
@@ -1,10 +1,16 @@
 #include "ReadMesh.hpp"
+#include "CompressedFile.hpp"
 #include "IO.hpp"
 #include <algorithm>
+#include <cstdlib>
+#include <exception>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 using namespace std::string_literals;
 
@@ -32,21 +38,27 @@ void ReadMesh::readOpenFoamMesh(Mesh &fvMesh)
   readOwnersFile(fvMesh);
   readNeighborsFile(fvMesh);
   readBoundaryFile(fvMesh);
+  constructConnectivity(fvMesh);
+  MeshProcessor.processOpenFoamMesh(fvMesh);
+}
+
+void ReadMesh::constructConnectivity(Mesh &fvMesh)
+{
   constructCells(fvMesh);
   setupNodeConnectivities(fvMesh);
-  MeshProcessor.processOpenFoamMesh(fvMesh);
 }
 
 void ReadMesh::readPointsFile(Mesh &fvMesh)
 {
   std::string pointsFileName = fvMesh.caseDir() + "/constant/polyMesh/points"s;
 
-  if (!std::filesystem::exists(pointsFileName)) {
+  if (!CompressedFile::exists(pointsFileName)) {
     throw std::runtime_error("Error: Points file '" + pointsFileName + "' does not exist.");
   }
 
-  std::ifstream pointsFile(pointsFileName);
-  IO::IO::ifFileOpened(pointsFile, pointsFileName);
+  const std::unique_ptr<std::istream> pointsStream =
+      CompressedFile::open(pointsFileName);
+  std::istream &pointsFile = *pointsStream;
 
   // Discard the file header
   IO::discardLines(pointsFile, 18);
@@ -72,20 +84,19 @@ void ReadMesh::readPointsFile(Mesh &fvMesh)
 
     fvMesh.nodes()[iNode].index() = iNode;
   }
-
-  pointsFile.close();
 }
 
 void ReadMesh::readFacesFile(Mesh &fvMesh)
 {
   std::string facesFileName = fvMesh.caseDir() + "/constant/polyMesh/faces"s;
 
-  if (!std::filesystem::exists(facesFileName)) {
+  if (!CompressedFile::exists(facesFileName)) {
     throw std::runtime_error("Error: Faces file '" + facesFileName + "' does not exist.");
   }
 
-  std::ifstream facesFile(facesFileName);
-  IO::ifFileOpened(facesFile, facesFileName);
+  const std::unique_ptr<std::istream> facesStream =
+      CompressedFile::open(facesFileName);
+  std::istream &facesFile = *facesStream;
 
   // Discard the file header
   IO::discardLines(facesFile, 18);
@@ -112,28 +123,28 @@ void ReadMesh::readFacesFile(Mesh &fvMesh)
 
     fvMesh.faces()[iFace].index() = iFace;
   }
-
-  facesFile.close();
 }
 
 void ReadMesh::readOwnersFile(Mesh &fvMesh)
 {
   std::string ownersFileName = fvMesh.caseDir() + "/constant/polyMesh/owner"s;
 
-  if (!std::filesystem::exists(ownersFileName)) {
+  if (!CompressedFile::exists(ownersFileName)) {
     throw std::runtime_error("Error: Owners file '" + ownersFileName + "' does not exist.");
   }
 
-  std::ifstream ownersFile(ownersFileName);
-  IO::ifFileOpened(ownersFile, ownersFileName);
+  const std::unique_ptr<std::istream> ownersStream =
+      CompressedFile::open(ownersFileName);
+  std::istream &ownersFile = *ownersStream;
 
   // Discard the file header
   IO::discardLines(ownersFile, 18);
 
   ownersFile >> fvMesh.nOwners();
 
-  // Discard the rest of the line and the next line
-  IO::discardLines(ownersFile, 2);
+  // Short lists are written on one line
+  ownersFile >> std::ws;
+  ownersFile.ignore(1); // Discard the left parenthesis
 
   std::size_t maxOwnerIdx{0};
   std::size_t ownerIdx{0};
@@ -145,8 +156,6 @@ void ReadMesh::readOwnersFile(Mesh &fvMesh)
     }
   }
   fvMesh.nCells() = maxOwnerIdx + 1;
-
-  ownersFile.close();
 }
 
 void ReadMesh::readNeighborsFile(Mesh &fvMesh)
@@ -154,24 +163,23 @@ void ReadMesh::readNeighborsFile(Mesh &fvMesh)
   std::string neighborsFileName =
       fvMesh.caseDir() + "/constant/polyMesh/neighbour"s;
 
-  if (!std::filesystem::exists(neighborsFileName)) {
+  if (!CompressedFile::exists(neighborsFileName)) {
     throw std::runtime_error("Error: Neighbors file '" + neighborsFileName + "' does not exist.");
   }
 
-  std::ifstream neighborsFile(neighborsFileName);
-  IO::ifFileOpened(neighborsFile, neighborsFileName);
+  const std::unique_ptr<std::istream> neighborsStream =
+      CompressedFile::open(neighborsFileName);
+  std::istream &neighborsFile = *neighborsStream;
 
   // Discard the file header
   IO::discardLines(neighborsFile, 18);
 
   std::size_t nNeighbors{0};
   neighborsFile >> nNeighbors;
-  // Discard the rest of the line and the next line
-  if (nNeighbors <= 4) {
-    neighborsFile.ignore(1); // Discard the left parenthesis
-  } else {
-    IO::discardLines(neighborsFile, 2);
-  }
+
+  // Short lists are written on one line
+  neighborsFile >> std::ws;
+  neighborsFile.ignore(1); // Discard the left parenthesis
   size_t i = 0;
   for (std::size_t iNeighbor = 0; iNeighbor < nNeighbors; ++iNeighbor) {
     neighborsFile >> fvMesh.faces()[iNeighbor].iNeighbor();
@@ -181,7 +189,6 @@ void ReadMesh::readNeighborsFile(Mesh &fvMesh)
   }
 
   fvMesh.nInteriorFaces() = i;
-  neighborsFile.close();
 }
 
 void ReadMesh::readBoundaryFile(Mesh &fvMesh)
@@ -189,12 +196,13 @@ void ReadMesh::readBoundaryFile(Mesh &fvMesh)
   std::string boundaryFileName =
       fvMesh.caseDir() + "/constant/polyMesh/boundary"s;
 
-  if (!std::filesystem::exists(boundaryFileName)) {
+  if (!CompressedFile::exists(boundaryFileName)) {
     throw std::runtime_error("Error: Boundary file '" + boundaryFileName + "' does not exist.");
   }
 
-  std::ifstream boundaryFile(boundaryFileName);
-  IO::ifFileOpened(boundaryFile, boundaryFileName);
+  const std::unique_ptr<std::istream> boundaryStream =
+      CompressedFile::open(boundaryFileName);
+  std::istream &boundaryFile = *boundaryStream;
 
   // Discard the file header
   IO::discardLines(boundaryFile, 17);
@@ -228,12 +236,277 @@ void ReadMesh::readBoundaryFile(Mesh &fvMesh)
 
       } else if (token == "startFace"s) {
         boundaryFile >> fvMesh.boundaries()[iBoundary].startFace();
+
+      } else if (token == "neighbProcNo"s) {
+        boundaryFile >> fvMesh.boundaries()[iBoundary].neighborProcessor();
       }
       IO::discardLines(boundaryFile);
       boundaryFile >> token;
     }
   }
-  boundaryFile.close();
+}
+
+std::vector<long>
+ReadMesh::readAddressingFile(const std::string &addressingFileName)
+{
+  if (!CompressedFile::exists(addressingFileName)) {
+    throw std::runtime_error("Error: Addressing file '" + addressingFileName + "' does not exist.");
+  }
+
+  const std::unique_ptr<std::istream> addressingStream =
+      CompressedFile::open(addressingFileName);
+  std::istream &addressingFile = *addressingStream;
+
+  // Discard the file header
+  IO::discardLines(addressingFile, 18);
+
+  std::size_t nLabels{0};
+  addressingFile >> nLabels;
+
+  // Short lists are written on one line
+  addressingFile >> std::ws;
+  addressingFile.ignore(1); // Discard the left parenthesis
+
+  std::vector<long> labels(nLabels);
+  for (auto &label : labels) {
+    addressingFile >> label;
+  }
+  if (!addressingFile) {
+    throw std::runtime_error("Error: Failed to read addressing file '" + addressingFileName + "'.");
+  }
+
+  return labels;
+}
+
+void ReadMesh::readDecomposedOpenFoamMesh(DecomposedMesh &decomposedMesh)
+{
+  const std::string &caseDir = decomposedMesh.caseDir();
+  auto processorDir = [&caseDir](std::size_t iProcessor) {
+    return caseDir + "/processor" + std::to_string(iProcessor);
+  };
+
+  std::size_t nProcessors = 0;
+  while (std::filesystem::exists(processorDir(nProcessors) + "/constant/polyMesh")) {
+    ++nProcessors;
+  }
+  if (nProcessors == 0) {
+    throw std::runtime_error("Error: Case directory '" + caseDir + "' has no processor0/constant/polyMesh.");
+  }
+
+  decomposedMesh.processorMeshes().assign(nProcessors, Mesh());
+  decomposedMesh.cellAddressing().assign(nProcessors, {});
+  decomposedMesh.faceAddressing().assign(nProcessors, {});
+  decomposedMesh.nodeAddressing().assign(nProcessors, {});
+  decomposedMesh.faceFlipped().assign(nProcessors, {});
+  decomposedMesh.interfaces().assign(nProcessors, {});
+
+  // The pieces are independent, so each thread reads whole pieces. Errors
+  // are collected and rethrown outside of the parallel region.
+  std::vector<std::exception_ptr> errors(nProcessors);
+  const auto nPieces = static_cast<std::ptrdiff_t>(nProcessors);
+#pragma omp parallel for schedule(dynamic)
+  for (std::ptrdiff_t iProcessor = 0; iProcessor < nPieces; ++iProcessor) {
+    try {
+      Mesh &localMesh = decomposedMesh.processorMeshes()[iProcessor];
+      localMesh.caseDir() = processorDir(iProcessor);
+      ReadMesh pieceReader;
+      pieceReader.readOpenFoamMesh(localMesh);
+
+      const std::string polyMeshDir = localMesh.caseDir() + "/constant/polyMesh/";
+      std::vector<long> cellLabels =
+          pieceReader.readAddressingFile(polyMeshDir + "cellProcAddressing");
+      std::vector<long> faceLabels =
+          pieceReader.readAddressingFile(polyMeshDir + "faceProcAddressing");
+      std::vector<long> pointLabels =
+          pieceReader.readAddressingFile(polyMeshDir + "pointProcAddressing");
+      if (cellLabels.size() != localMesh.nCells() ||
+          faceLabels.size() != localMesh.nFaces() ||
+          pointLabels.size() != localMesh.nNodes()) {
+        throw std::runtime_error("Error: Addressing of '" + localMesh.caseDir() + "' does not match its mesh.");
+      }
+
+      auto &cellAddressing = decomposedMesh.cellAddressing()[iProcessor];
+      cellAddressing.assign(cellLabels.begin(), cellLabels.end());
+      auto &nodeAddressing = decomposedMesh.nodeAddressing()[iProcessor];
+      nodeAddressing.assign(pointLabels.begin(), pointLabels.end());
+
+      // Face labels are shifted by one and negative for reversed faces
+      auto &faceAddressing = decomposedMesh.faceAddressing()[iProcessor];
+      auto &faceFlipped = decomposedMesh.faceFlipped()[iProcessor];
+      faceAddressing.resize(faceLabels.size());
+      faceFlipped.resize(faceLabels.size());
+      for (std::size_t iFace = 0; iFace < faceLabels.size(); ++iFace) {
+        if (faceLabels[iFace] == 0) {
+          throw std::runtime_error("Error: Invalid face label in '" + polyMeshDir + "faceProcAddressing'.");
+        }
+        faceAddressing[iFace] = std::labs(faceLabels[iFace]) - 1;
+        faceFlipped[iFace] = faceLabels[iFace] < 0;
+      }
+
+      for (auto &boundary : localMesh.boundaries()) {
+        if (boundary.neighborProcessor() < 0) {
+          continue;
+        }
+        Interface interface;
+        interface.neighbor = boundary.neighborProcessor();
+        for (std::size_t iFace = boundary.startFace();
+             iFace < boundary.startFace() + boundary.nFaces(); ++iFace) {
+          interface.faces.push_back(iFace);
+        }
+        decomposedMesh.interfaces()[iProcessor].push_back(std::move(interface));
+      }
+      std::sort(decomposedMesh.interfaces()[iProcessor].begin(),
+                decomposedMesh.interfaces()[iProcessor].end(),
+                [](const Interface &a, const Interface &b) {
+                  return a.neighbor < b.neighbor;
+                });
+    } catch (...) {
+      errors[iProcessor] = std::current_exception();
+    }
+  }
+  for (auto &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // Global sizes and the piece of each global cell
+  decomposedMesh.nGlobalCells() = 0;
+  decomposedMesh.nGlobalFaces() = 0;
+  decomposedMesh.nGlobalNodes() = 0;
+  for (std::size_t iProcessor = 0; iProcessor < nProcessors; ++iProcessor) {
+    decomposedMesh.nGlobalCells() +=
+        decomposedMesh.cellAddressing()[iProcessor].size();
+    for (std::size_t iFace : decomposedMesh.faceAddressing()[iProcessor]) {
+      decomposedMesh.nGlobalFaces() =
+          std::max(decomposedMesh.nGlobalFaces(), iFace + 1);
+    }
+    for (std::size_t iNode : decomposedMesh.nodeAddressing()[iProcessor]) {
+      decomposedMesh.nGlobalNodes() =
+          std::max(decomposedMesh.nGlobalNodes(), iNode + 1);
+    }
+  }
+
+  auto &cellToProcessor = decomposedMesh.cellToProcessor();
+  cellToProcessor.assign(decomposedMesh.nGlobalCells(), nProcessors);
+  for (std::size_t iProcessor = 0; iProcessor < nProcessors; ++iProcessor) {
+    for (std::size_t iElement : decomposedMesh.cellAddressing()[iProcessor]) {
+      if (iElement >= cellToProcessor.size() ||
+          cellToProcessor[iElement] != nProcessors) {
+        throw std::runtime_error("Error: Cell addressing of '" + caseDir + "' is not a partition of the cells.");
+      }
+      cellToProcessor[iElement] = iProcessor;
+    }
+  }
+}
+
+void ReadMesh::mergeDecomposedMesh(DecomposedMesh &decomposedMesh, Mesh &fvMesh)
+{
+  const std::size_t nProcessors = decomposedMesh.nProcessors();
+  if (nProcessors == 0) {
+    throw std::invalid_argument("Decomposed mesh has no pieces");
+  }
+
+  fvMesh.caseDir() = decomposedMesh.caseDir();
+  fvMesh.nCells() = decomposedMesh.nGlobalCells();
+  fvMesh.nFaces() = decomposedMesh.nGlobalFaces();
+  fvMesh.nOwners() = decomposedMesh.nGlobalFaces();
+  fvMesh.nNodes() = decomposedMesh.nGlobalNodes();
+  fvMesh.nodes().assign(fvMesh.nNodes(), Node());
+  fvMesh.faces().assign(fvMesh.nFaces(), Face());
+  fvMesh.cells().clear();
+
+  // The physical patches come first in every piece, followed by the
+  // processor patches. Their faces follow the interior faces globally.
+  fvMesh.boundaries().clear();
+  std::size_t nBoundaryFaces = 0;
+  for (auto &boundary : decomposedMesh.processorMeshes()[0].boundaries()) {
+    if (boundary.neighborProcessor() >= 0) {
+      break;
+    }
+    Boundary globalBoundary;
+    globalBoundary.userName() = boundary.userName();
+    globalBoundary.index() = fvMesh.boundaries().size();
+    globalBoundary.type() = boundary.type();
+    for (auto &piece : decomposedMesh.processorMeshes()) {
+      globalBoundary.nFaces() += piece.boundaries()[globalBoundary.index()].nFaces();
+    }
+    nBoundaryFaces += globalBoundary.nFaces();
+    fvMesh.boundaries().push_back(globalBoundary);
+  }
+  fvMesh.nBoundaries() = fvMesh.boundaries().size();
+  fvMesh.nPatches() = fvMesh.nBoundaries();
+  if (nBoundaryFaces > fvMesh.nFaces()) {
+    throw std::runtime_error("Error: Patches of '" + decomposedMesh.caseDir() + "' do not match the face addressing.");
+  }
+  fvMesh.nInteriorFaces() = fvMesh.nFaces() - nBoundaryFaces;
+  std::size_t startFace = fvMesh.nInteriorFaces();
+  for (auto &boundary : fvMesh.boundaries()) {
+    boundary.startFace() = startFace;
+    startFace += boundary.nFaces();
+  }
+
+  // A node shared by several pieces is copied from the first one
+  std::vector<std::size_t> nodeSource(fvMesh.nNodes(), nProcessors);
+  for (std::size_t iProcessor = 0; iProcessor < nProcessors; ++iProcessor) {
+    for (std::size_t iNode : decomposedMesh.nodeAddressing()[iProcessor]) {
+      if (nodeSource[iNode] == nProcessors) {
+        nodeSource[iNode] = iProcessor;
+      }
+    }
+  }
+
+  // Scatter the pieces. A processor face is written by both of its sides:
+  // the unflipped side sets the nodes and the owner, the flipped side only
+  // the neighbor, so the writes never overlap.
+  const auto nPieces = static_cast<std::ptrdiff_t>(nProcessors);
+#pragma omp parallel for schedule(dynamic)
+  for (std::ptrdiff_t iProcessor = 0; iProcessor < nPieces; ++iProcessor) {
+    Mesh &piece = decomposedMesh.processorMeshes()[iProcessor];
+    const auto &cellAddressing = decomposedMesh.cellAddressing()[iProcessor];
+    const auto &faceAddressing = decomposedMesh.faceAddressing()[iProcessor];
+    const auto &nodeAddressing = decomposedMesh.nodeAddressing()[iProcessor];
+    const auto &faceFlipped = decomposedMesh.faceFlipped()[iProcessor];
+
+    for (std::size_t iNode = 0; iNode < piece.nNodes(); ++iNode) {
+      const std::size_t iGlobalNode = nodeAddressing[iNode];
+      if (nodeSource[iGlobalNode] == static_cast<std::size_t>(iProcessor)) {
+        fvMesh.nodes()[iGlobalNode].centroid() = piece.nodes()[iNode].centroid();
+        fvMesh.nodes()[iGlobalNode].index() = iGlobalNode;
+      }
+    }
+
+    for (std::size_t iFace = 0; iFace < piece.nFaces(); ++iFace) {
+      Face &localFace = piece.faces()[iFace];
+      Face &globalFace = fvMesh.faces()[faceAddressing[iFace]];
+      const int iGlobalOwner = static_cast<int>(cellAddressing[localFace.iOwner()]);
+      if (faceFlipped[iFace]) {
+        globalFace.iNeighbor() = iGlobalOwner;
+        continue;
+      }
+      globalFace.index() = faceAddressing[iFace];
+      globalFace.nNodes() = localFace.nNodes();
+      globalFace.allocateNodeList();
+      for (std::size_t iNode = 0; iNode < localFace.nNodes(); ++iNode) {
+        globalFace.iNodes()[iNode] = nodeAddressing[localFace.iNodes()[iNode]];
+      }
+      globalFace.iOwner() = iGlobalOwner;
+      if (iFace < piece.nInteriorFaces()) {
+        globalFace.iNeighbor() =
+            static_cast<int>(cellAddressing[localFace.iNeighbor()]);
+      }
+    }
+  }
+
+  for (std::size_t iFace = 0; iFace < fvMesh.nInteriorFaces(); ++iFace) {
+    if (fvMesh.faces()[iFace].iOwner() < 0 ||
+        fvMesh.faces()[iFace].iNeighbor() < 0) {
+      throw std::runtime_error("Error: Processor patches of '" + decomposedMesh.caseDir() + "' do not match.");
+    }
+  }
+
+  constructConnectivity(fvMesh);
+  MeshProcessor.processOpenFoamMesh(fvMesh);
 }
 
 void ReadMesh::constructCells(Mesh &fvMesh)
@@ -0,0 +1,330 @@
+#include "RecycledCg.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+template <typename ValueType>
+ValueType dot(const std::vector<ValueType> &a, const std::vector<ValueType> &b)
+{
+  const auto n = static_cast<std::ptrdiff_t>(a.size());
+  ValueType sum = 0.0;
+#pragma omp parallel for reduction(+ : sum)
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+// y = y + alpha * x
+template <typename ValueType>
+void axpy(const ValueType alpha, const std::vector<ValueType> &x,
+          std::vector<ValueType> &y)
+{
+  const auto n = static_cast<std::ptrdiff_t>(x.size());
+#pragma omp parallel for simd
+  for (std::ptrdiff_t i = 0; i < n; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+// In-place Cholesky factorization of a small dense row-major matrix.
+// Returns false if the matrix is not numerically positive definite.
+template <typename ValueType>
+bool denseCholesky(std::vector<ValueType> &a, const std::size_t n)
+{
+  for (std::size_t j = 0; j < n; ++j) {
+    ValueType pivot = a[j * n + j];
+    for (std::size_t k = 0; k < j; ++k) {
+      pivot -= a[j * n + k] * a[j * n + k];
+    }
+    if (pivot <= 0.0) {
+      return false;
+    }
+    a[j * n + j] = std::sqrt(pivot);
+    for (std::size_t i = j + 1; i < n; ++i) {
+      ValueType sum = a[i * n + j];
+      for (std::size_t k = 0; k < j; ++k) {
+        sum -= a[i * n + k] * a[j * n + k];
+      }
+      a[i * n + j] = sum / a[j * n + j];
+    }
+  }
+  return true;
+}
+
+// Solve L * L^T * x = b in place with the factor from denseCholesky
+template <typename ValueType>
+void denseCholeskySolve(const std::vector<ValueType> &l, const std::size_t n,
+                        std::vector<ValueType> &x)
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t k = 0; k < i; ++k) {
+      x[i] -= l[i * n + k] * x[k];
+    }
+    x[i] /= l[i * n + i];
+  }
+  for (std::size_t i = n; i-- > 0;) {
+    for (std::size_t k = i + 1; k < n; ++k) {
+      x[i] -= l[k * n + i] * x[k];
+    }
+    x[i] /= l[i * n + i];
+  }
+}
+
+// Eigenvalues and eigenvectors of a small dense symmetric row-major matrix by
+// cyclic Jacobi rotations. Eigenvector j is column j of the returned matrix.
+template <typename ValueType>
+void denseSymmetricEigen(std::vector<ValueType> a, const std::size_t n,
+                         std::vector<ValueType> &eigenvalues,
+                         std::vector<ValueType> &eigenvectors)
+{
+  eigenvectors.assign(n * n, 0.0);
+  for (std::size_t i = 0; i < n; ++i) {
+    eigenvectors[i * n + i] = 1.0;
+  }
+
+  for (int sweep = 0; sweep < 100; ++sweep) {
+    ValueType offDiagonal = 0.0;
+    ValueType diagonal = 0.0;
+    for (std::size_t p = 0; p < n; ++p) {
+      diagonal += a[p * n + p] * a[p * n + p];
+      for (std::size_t q = p + 1; q < n; ++q) {
+        offDiagonal += a[p * n + q] * a[p * n + q];
+      }
+    }
+    if (offDiagonal <= 1.0e-30 * diagonal) {
+      break;
+    }
+
+    for (std::size_t p = 0; p < n; ++p) {
+      for (std::size_t q = p + 1; q < n; ++q) {
+        if (a[p * n + q] == 0.0) {
+          continue;
+        }
+        const ValueType theta =
+            (a[q * n + q] - a[p * n + p]) / (2.0 * a[p * n + q]);
+        const ValueType t = (theta >= 0.0 ? 1.0 : -1.0) /
+                            (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        const ValueType c = 1.0 / std::sqrt(t * t + 1.0);
+        const ValueType s = t * c;
+
+        for (std::size_t k = 0; k < n; ++k) {
+          const ValueType akp = a[k * n + p];
+          const ValueType akq = a[k * n + q];
+          a[k * n + p] = c * akp - s * akq;
+          a[k * n + q] = s * akp + c * akq;
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+          const ValueType apk = a[p * n + k];
+          const ValueType aqk = a[q * n + k];
+          a[p * n + k] = c * apk - s * aqk;
+          a[q * n + k] = s * apk + c * aqk;
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+          const ValueType vkp = eigenvectors[k * n + p];
+          const ValueType vkq = eigenvectors[k * n + q];
+          eigenvectors[k * n + p] = c * vkp - s * vkq;
+          eigenvectors[k * n + q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  eigenvalues.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    eigenvalues[i] = a[i * n + i];
+  }
+}
+} // namespace
+
+template <typename ValueType, typename IndexType>
+std::size_t RecycledCg<ValueType, IndexType>::solve(
+    const CsrMatrix<ValueType, IndexType> &matrix,
+    const std::vector<ValueType> &RHS,
+    std::vector<ValueType> &solVector,
+    const preconditioner &applyPreconditioner,
+    ValueType reductionFactor,
+    std::size_t maxNumIterations)
+{
+  const std::size_t nRows = matrix.nRows();
+  if (!recycleSpace_.empty() && recycleSpace_.front().size() != nRows) {
+    clear();
+  }
+
+  // Initial residual r = b - A * x
+  std::vector<ValueType> residual(nRows);
+  matrix.apply(solVector.data(), residual.data());
+  for (std::size_t i = 0; i < nRows; ++i) {
+    residual[i] = RHS[i] - residual[i];
+  }
+  const ValueType initialResidualNorm = std::sqrt(dot(residual, residual));
+  if (initialResidualNorm == 0.0) {
+    return 0;
+  }
+
+  // Coarse operator E = W^T * A * W of the recycle space for the current
+  // matrix. The space is dropped if it has become numerically singular.
+  std::size_t nRecycled = recycleSpace_.size();
+  std::vector<std::vector<ValueType>> AW(nRecycled,
+                                         std::vector<ValueType>(nRows));
+  std::vector<ValueType> coarseFactor(nRecycled * nRecycled);
+  for (std::size_t j = 0; j < nRecycled; ++j) {
+    matrix.apply(recycleSpace_[j].data(), AW[j].data());
+  }
+  for (std::size_t i = 0; i < nRecycled; ++i) {
+    for (std::size_t j = 0; j < nRecycled; ++j) {
+      coarseFactor[i * nRecycled + j] = dot(recycleSpace_[i], AW[j]);
+    }
+  }
+  if (!denseCholesky(coarseFactor, nRecycled)) {
+    clear();
+    AW.clear();
+    nRecycled = 0;
+  }
+
+  // mu = E^{-1} * B^T * v for B = W or B = A * W
+  auto coarseSolve = [&](const std::vector<std::vector<ValueType>> &basis,
+                         const std::vector<ValueType> &v) {
+    std::vector<ValueType> mu(nRecycled);
+    for (std::size_t j = 0; j < nRecycled; ++j) {
+      mu[j] = dot(basis[j], v);
+    }
+    denseCholeskySolve(coarseFactor, nRecycled, mu);
+    return mu;
+  };
+
+  // Start from the Galerkin projection onto the recycle space, which makes
+  // the initial residual orthogonal to W
+  if (nRecycled > 0) {
+    const std::vector<ValueType> mu = coarseSolve(recycleSpace_, residual);
+    for (std::size_t j = 0; j < nRecycled; ++j) {
+      axpy(mu[j], recycleSpace_[j], solVector);
+      axpy(-mu[j], AW[j], residual);
+    }
+  }
+
+  // Remove the components of z along W in the A inner product
+  auto deflate = [&](std::vector<ValueType> &z) {
+    if (nRecycled == 0) {
+      return;
+    }
+    const std::vector<ValueType> mu = coarseSolve(AW, z);
+    for (std::size_t j = 0; j < nRecycled; ++j) {
+      axpy(-mu[j], recycleSpace_[j], z);
+    }
+  };
+
+  std::vector<ValueType> z(nRows);
+  applyPreconditioner(residual.data(), z.data());
+  deflate(z);
+  std::vector<ValueType> direction = z;
+  std::vector<ValueType> Ap(nRows);
+  ValueType rz = dot(residual, z);
+
+  // The first search directions span the low end of the spectrum best and
+  // are harvested to refresh the recycle space
+  std::vector<std::vector<ValueType>> harvested;
+  const std::size_t nHarvest = 2 * recycleDimension_;
+
+  std::size_t iteration = 0;
+  ValueType residualNorm = std::sqrt(dot(residual, residual));
+  const auto n = static_cast<std::ptrdiff_t>(nRows);
+  while (iteration < maxNumIterations &&
+         residualNorm > reductionFactor * initialResidualNorm) {
+    if (harvested.size() < nHarvest) {
+      harvested.push_back(direction);
+    }
+
+    matrix.apply(direction.data(), Ap.data());
+    const ValueType alpha = rz / dot(direction, Ap);
+    axpy(alpha, direction, solVector);
+    axpy(-alpha, Ap, residual);
+    iteration++;
+
+    residualNorm = std::sqrt(dot(residual, residual));
+    if (residualNorm <= reductionFactor * initialResidualNorm) {
+      break;
+    }
+
+    applyPreconditioner(residual.data(), z.data());
+    const ValueType rzNew = dot(residual, z);
+    const ValueType beta = rzNew / rz;
+    rz = rzNew;
+
+    deflate(z);
+#pragma omp parallel for simd
+    for (std::ptrdiff_t i = 0; i < n; ++i) {
+      direction[i] = z[i] + beta * direction[i];
+    }
+  }
+
+  if (recycleDimension_ > 0) {
+    updateRecycleSpace(matrix, harvested);
+  }
+  return iteration;
+}
+
+template <typename ValueType, typename IndexType>
+void RecycledCg<ValueType, IndexType>::updateRecycleSpace(
+    const CsrMatrix<ValueType, IndexType> &matrix,
+    std::vector<std::vector<ValueType>> &directions)
+{
+  // Orthonormal basis Q of the old recycle space and the new directions
+  // (modified Gram-Schmidt, dropping numerically dependent vectors)
+  std::vector<std::vector<ValueType>> basis = std::move(recycleSpace_);
+  for (auto &direction : directions) {
+    basis.push_back(std::move(direction));
+  }
+  std::vector<std::vector<ValueType>> Q;
+  for (auto &v : basis) {
+    const ValueType originalNorm = std::sqrt(dot(v, v));
+    for (const auto &q : Q) {
+      axpy(-dot(q, v), q, v);
+    }
+    const ValueType norm = std::sqrt(dot(v, v));
+    if (norm > 1.0e-10 * originalNorm && norm > 0.0) {
+      for (auto &value : v) {
+        value /= norm;
+      }
+      Q.push_back(std::move(v));
+    }
+  }
+
+  if (Q.empty()) {
+    return;
+  }
+
+  // Rayleigh-Ritz: the eigenvectors of Q^T * A * Q with the smallest
+  // eigenvalues approximate the lowest eigenvectors of A
+  const std::size_t m = Q.size();
+  std::vector<ValueType> G(m * m);
+  std::vector<ValueType> AQ(Q.front().size());
+  for (std::size_t j = 0; j < m; ++j) {
+    matrix.apply(Q[j].data(), AQ.data());
+    for (std::size_t i = 0; i <= j; ++i) {
+      G[i * m + j] = G[j * m + i] = dot(Q[i], AQ);
+    }
+  }
+
+  std::vector<ValueType> eigenvalues;
+  std::vector<ValueType> eigenvectors;
+  denseSymmetricEigen(G, m, eigenvalues, eigenvectors);
+
+  std::vector<std::size_t> order(m);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    return eigenvalues[a] < eigenvalues[b];
+  });
+
+  const std::size_t nKeep = std::min(recycleDimension_, m);
+  recycleSpace_.assign(nKeep, std::vector<ValueType>(Q.front().size(), 0.0));
+  for (std::size_t j = 0; j < nKeep; ++j) {
+    for (std::size_t i = 0; i < m; ++i) {
+      axpy(eigenvectors[i * m + order[j]], Q[i], recycleSpace_[j]);
+    }
+  }
+}
+
+// Explicit template instantiation for commonly used types
+template class RecycledCg<double, int>;
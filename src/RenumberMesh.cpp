@@ -0,0 +1,322 @@
+#include "RenumberMesh.hpp"
+#include "Graph.hpp"
+#include "GraphOrdering.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Bits per coordinate, so that three coordinates fit into a 64-bit key
+constexpr unsigned int nCurveBits = 21;
+
+// Interleave the bits of the first nDims coordinates, most significant first
+std::uint64_t interleaveBits(const std::array<std::uint32_t, 3> &X,
+                             const std::size_t nDims) {
+  std::uint64_t key = 0;
+  for (int iBit = nCurveBits - 1; iBit >= 0; --iBit) {
+    for (std::size_t iCoordinate = 0; iCoordinate < nDims; ++iCoordinate) {
+      key = (key << 1) | ((X[iCoordinate] >> iBit) & 1u);
+    }
+  }
+  return key;
+}
+
+// Hilbert index from Skilling's transform of the coordinates into the
+// transposed Hilbert index ("Programming the Hilbert curve", 2004)
+std::uint64_t hilbertKey(std::array<std::uint32_t, 3> X,
+                         const std::size_t nDims) {
+  const std::uint32_t M = 1u << (nCurveBits - 1);
+
+  // Inverse undo excess work
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1) {
+    const std::uint32_t P = Q - 1;
+    for (std::size_t i = 0; i < nDims; ++i) {
+      if (X[i] & Q) {
+        X[0] ^= P;
+      } else {
+        const std::uint32_t t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  for (std::size_t i = 1; i < nDims; ++i) {
+    X[i] ^= X[i - 1];
+  }
+  std::uint32_t t = 0;
+  for (std::uint32_t Q = M; Q > 1; Q >>= 1) {
+    if (X[nDims - 1] & Q) {
+      t ^= Q - 1;
+    }
+  }
+  for (std::size_t i = 0; i < nDims; ++i) {
+    X[i] ^= t;
+  }
+
+  return interleaveBits(X, nDims);
+}
+
+// Compose the ordering of an earlier renumbering with perm
+void composeOrdering(std::vector<std::size_t> &ordering,
+                     const std::vector<std::size_t> &perm) {
+  if (ordering.empty()) {
+    ordering = perm;
+    return;
+  }
+  std::vector<std::size_t> composed(perm.size());
+  for (std::size_t i = 0; i < perm.size(); ++i) {
+    composed[i] = ordering[perm[i]];
+  }
+  ordering = std::move(composed);
+}
+
+} // namespace
+
+void RenumberMesh::reverseCuthillMcKee(Mesh &fvMesh) {
+  const Graph cellGraph(fvMesh);
+  renumberCells(fvMesh, GraphOrdering::reverseCuthillMcKee(cellGraph));
+}
+
+void RenumberMesh::renumberCells(Mesh &fvMesh,
+                                 const std::vector<std::size_t> &cellPerm) {
+  if (cellPerm.size() != fvMesh.nCells()) {
+    throw std::invalid_argument(
+        "Cell permutation does not match the number of cells");
+  }
+  const std::vector<std::size_t> cellPosition =
+      GraphOrdering::inverse(cellPerm);
+
+  // Move owners and neighbors to the new numbering. Interior faces whose
+  // owner would become larger than the neighbor are flipped, which reverses
+  // their node order so that Sf still points from owner to neighbor.
+  std::vector<Face> &faces = fvMesh.faces();
+  for (std::size_t iFace = 0; iFace < fvMesh.nInteriorFaces(); ++iFace) {
+    Face &theFace = faces[iFace];
+    const auto iOwner = static_cast<int>(cellPosition[theFace.iOwner()]);
+    const auto iNeighbor = static_cast<int>(cellPosition[theFace.iNeighbor()]);
+    theFace.iOwner() = std::min(iOwner, iNeighbor);
+    theFace.iNeighbor() = std::max(iOwner, iNeighbor);
+    if (iOwner > iNeighbor) {
+      std::reverse(theFace.iNodes().begin() + 1, theFace.iNodes().end());
+    }
+  }
+  for (std::size_t iBFace = fvMesh.nInteriorFaces(); iBFace < fvMesh.nFaces();
+       ++iBFace) {
+    faces[iBFace].iOwner() =
+        static_cast<int>(cellPosition[faces[iBFace].iOwner()]);
+  }
+
+  // Upper-triangular order of the interior faces
+  std::vector<std::size_t> facePerm(fvMesh.nFaces());
+  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+    facePerm[iFace] = iFace;
+  }
+  std::sort(facePerm.begin(), facePerm.begin() + fvMesh.nInteriorFaces(),
+            [&faces](std::size_t a, std::size_t b) {
+              return std::make_pair(faces[a].iOwner(), faces[a].iNeighbor()) <
+                     std::make_pair(faces[b].iOwner(), faces[b].iNeighbor());
+            });
+  const std::vector<std::size_t> facePosition =
+      GraphOrdering::inverse(facePerm);
+
+  std::vector<Face> newFaces(fvMesh.nFaces());
+  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+    newFaces[iFace] = std::move(faces[facePerm[iFace]]);
+    newFaces[iFace].index() = iFace;
+  }
+  faces = std::move(newFaces);
+
+  // Rebuild the cell connectivity in the order of constructCells: interior
+  // faces first, each list sorted by face index
+  std::vector<Cell> newCells(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    newCells[iElement].index() = iElement;
+    newCells[iElement].iNodes() =
+        std::move(fvMesh.cells()[cellPerm[iElement]].iNodes());
+  }
+  for (std::size_t iFace = 0; iFace < fvMesh.nInteriorFaces(); ++iFace) {
+    const std::size_t iOwner = faces[iFace].iOwner();
+    const std::size_t iNeighbor = faces[iFace].iNeighbor();
+
+    newCells[iOwner].iFaces().push_back(iFace);
+    newCells[iOwner].iNeighbors().push_back(iNeighbor);
+    newCells[iOwner].faceSigns().push_back(1);
+
+    newCells[iNeighbor].iFaces().push_back(iFace);
+    newCells[iNeighbor].iNeighbors().push_back(iOwner);
+    newCells[iNeighbor].faceSigns().push_back(-1);
+  }
+  for (std::size_t iBFace = fvMesh.nInteriorFaces(); iBFace < fvMesh.nFaces();
+       ++iBFace) {
+    const std::size_t iOwner = faces[iBFace].iOwner();
+    newCells[iOwner].iFaces().push_back(iBFace);
+    newCells[iOwner].faceSigns().push_back(1);
+  }
+  for (auto &cell : newCells) {
+    cell.nNeighbors() = cell.iNeighbors().size();
+  }
+  fvMesh.cells() = std::move(newCells);
+
+  // Node connectivities only change their numbering
+  for (auto &node : fvMesh.nodes()) {
+    for (auto &iFace : node.iFaces()) {
+      iFace = facePosition[iFace];
+    }
+    for (auto &iElement : node.iCells()) {
+      iElement = cellPosition[iElement];
+    }
+    std::sort(node.iFaces().begin(), node.iFaces().end());
+    std::sort(node.iCells().begin(), node.iCells().end());
+  }
+
+  composeOrdering(fvMesh.cellOrdering(), cellPerm);
+  composeOrdering(fvMesh.faceOrdering(), facePerm);
+
+  // Recompute the geometry with the flipped faces and new connectivity
+  MeshProcessor.processOpenFoamMesh(fvMesh);
+}
+
+void RenumberMesh::spaceFillingCurve(Mesh &fvMesh, SpaceFillingCurve curve) {
+  // Bounding box of the cell centroids
+  std::array<double, 3> lower;
+  std::array<double, 3> upper;
+  lower.fill(std::numeric_limits<double>::max());
+  upper.fill(std::numeric_limits<double>::lowest());
+  for (auto &cell : fvMesh.cells()) {
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      lower[iCoordinate] = std::min(lower[iCoordinate], cell.centroid()[iCoordinate]);
+      upper[iCoordinate] = std::max(upper[iCoordinate], cell.centroid()[iCoordinate]);
+    }
+  }
+
+  // Quantize with the same scale in all directions so the curve is not
+  // distorted on elongated domains. Directions without extent (one cell
+  // thick 2D meshes) are dropped, since a 3D curve restricted to a plane
+  // is not continuous.
+  double extent = 0.0;
+  for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+    extent = std::max(extent, upper[iCoordinate] - lower[iCoordinate]);
+  }
+  std::vector<std::size_t> axes;
+  for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+    if (upper[iCoordinate] - lower[iCoordinate] > 1.0e-12 * extent) {
+      axes.push_back(iCoordinate);
+    }
+  }
+  const double maxCoordinate = static_cast<double>((1u << nCurveBits) - 1);
+  const double scale = extent > 0.0 ? maxCoordinate / extent : 0.0;
+
+  std::vector<std::pair<std::uint64_t, std::size_t>> keys(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    std::array<std::uint32_t, 3> X = {0, 0, 0};
+    for (std::size_t i = 0; i < axes.size(); ++i) {
+      X[i] = static_cast<std::uint32_t>(
+          (fvMesh.cells()[iElement].centroid()[axes[i]] - lower[axes[i]]) *
+          scale);
+    }
+    std::uint64_t key = 0;
+    if (!axes.empty()) {
+      key = curve == SpaceFillingCurve::hilbert ? hilbertKey(X, axes.size())
+                                                : interleaveBits(X, axes.size());
+    }
+    keys[iElement] = {key, iElement};
+  }
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<std::size_t> cellPerm(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    cellPerm[iElement] = keys[iElement].second;
+  }
+  renumberCells(fvMesh, cellPerm);
+  renumberNodesByFirstUse(fvMesh);
+}
+
+void RenumberMesh::renumberNodesByFirstUse(Mesh &fvMesh) {
+  constexpr std::size_t unnumbered = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> nodePosition(fvMesh.nNodes(), unnumbered);
+  std::vector<std::size_t> nodePerm;
+  nodePerm.reserve(fvMesh.nNodes());
+  for (auto &face : fvMesh.faces()) {
+    for (const std::size_t iNode : face.iNodes()) {
+      if (nodePosition[iNode] == unnumbered) {
+        nodePosition[iNode] = nodePerm.size();
+        nodePerm.push_back(iNode);
+      }
+    }
+  }
+  // Points not used by any face keep their relative order at the end
+  for (std::size_t iNode = 0; iNode < fvMesh.nNodes(); ++iNode) {
+    if (nodePosition[iNode] == unnumbered) {
+      nodePosition[iNode] = nodePerm.size();
+      nodePerm.push_back(iNode);
+    }
+  }
+
+  std::vector<Node> newNodes(fvMesh.nNodes());
+  for (std::size_t iNode = 0; iNode < fvMesh.nNodes(); ++iNode) {
+    newNodes[iNode] = std::move(fvMesh.nodes()[nodePerm[iNode]]);
+    newNodes[iNode].index() = iNode;
+  }
+  fvMesh.nodes() = std::move(newNodes);
+
+  for (auto &face : fvMesh.faces()) {
+    for (auto &iNode : face.iNodes()) {
+      iNode = nodePosition[iNode];
+    }
+  }
+  for (auto &cell : fvMesh.cells()) {
+    for (auto &iNode : cell.iNodes()) {
+      iNode = nodePosition[iNode];
+    }
+  }
+
+  composeOrdering(fvMesh.nodeOrdering(), nodePerm);
+}
+
+template <typename ValueType>
+void RenumberMesh::toCurrentNumbering(Mesh &fvMesh,
+                                      std::vector<ValueType> &cellValues) {
+  const std::vector<std::size_t> &cellOrdering = fvMesh.cellOrdering();
+  if (cellOrdering.empty()) {
+    return;
+  }
+  std::vector<ValueType> renumbered(cellValues.size());
+  for (std::size_t iElement = 0; iElement < cellOrdering.size(); ++iElement) {
+    renumbered[iElement] = cellValues[cellOrdering[iElement]];
+  }
+  cellValues = std::move(renumbered);
+}
+
+template <typename ValueType>
+std::vector<ValueType>
+RenumberMesh::toOriginalNumbering(const std::vector<std::size_t> &cellOrdering,
+                                  const std::vector<ValueType> &cellValues) {
+  if (cellOrdering.empty()) {
+    return cellValues;
+  }
+  std::vector<ValueType> original(cellValues.size());
+  for (std::size_t iElement = 0; iElement < cellOrdering.size(); ++iElement) {
+    original[cellOrdering[iElement]] = cellValues[iElement];
+  }
+  return original;
+}
+
+// Explicit template instantiation for commonly used types
+template void RenumberMesh::toCurrentNumbering(Mesh &fvMesh,
+                                               std::vector<double> &cellValues);
+template void RenumberMesh::toCurrentNumbering(
+    Mesh &fvMesh, std::vector<std::array<double, 3>> &cellValues);
+template void RenumberMesh::toCurrentNumbering(
+    Mesh &fvMesh, std::vector<std::array<double, 9>> &cellValues);
+template std::vector<double>
+RenumberMesh::toOriginalNumbering(const std::vector<std::size_t> &cellOrdering,
+                                  const std::vector<double> &cellValues);
+template std::vector<std::array<double, 3>> RenumberMesh::toOriginalNumbering(
+    const std::vector<std::size_t> &cellOrdering,
+    const std::vector<std::array<double, 3>> &cellValues);
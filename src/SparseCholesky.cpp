@@ -0,0 +1,202 @@
+#include "SparseCholesky.hpp"
+#include "Graph.hpp"
+#include "GraphOrdering.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Nonzero pattern of row k of L: the union of the elimination tree paths from
+// the entries of column k of the upper triangle. The pattern is returned in
+// topological order in stack[top], ..., stack[n - 1] (CSparse's cs_ereach).
+std::size_t ereach(const std::size_t k,
+                   const std::vector<std::size_t> &upperColPtrs,
+                   const std::vector<std::size_t> &upperRowIdxs,
+                   const std::vector<std::ptrdiff_t> &parent,
+                   std::vector<std::size_t> &stack,
+                   std::vector<std::size_t> &mark)
+{
+  const std::size_t n = parent.size();
+  std::size_t top = n;
+  mark[k] = k;
+  for (std::size_t p = upperColPtrs[k]; p < upperColPtrs[k + 1]; ++p) {
+    std::size_t i = upperRowIdxs[p];
+
+    // Walk up the tree until reaching a vertex that is already in the pattern
+    std::size_t len = 0;
+    while (mark[i] != k) {
+      stack[len++] = i;
+      mark[i] = k;
+      i = static_cast<std::size_t>(parent[i]);
+    }
+    while (len > 0) {
+      stack[--top] = stack[--len];
+    }
+  }
+  return top;
+}
+} // namespace
+
+template <typename ValueType, typename IndexType>
+void SparseCholesky<ValueType, IndexType>::analyze(
+    const CsrMatrix<ValueType, IndexType> &matrix,
+    std::vector<std::size_t> ordering)
+{
+  const std::size_t n = matrix.nRows();
+  patternRowPtrs_ = matrix.rowPtrs();
+  patternColIdxs_ = matrix.colIdxs();
+
+  // --- Fill-reducing ordering ---
+  if (ordering.empty()) {
+    ordering = GraphOrdering::nestedDissection(Graph(matrix));
+  }
+  if (ordering.size() != n) {
+    throw std::invalid_argument("Ordering size " + std::to_string(ordering.size()) +
+                                " does not match matrix size " + std::to_string(n));
+  }
+  perm_ = std::move(ordering);
+  inversePerm_ = GraphOrdering::inverse(perm_);
+
+  // --- Upper triangle of P * A * P^T by columns ---
+  // Column k holds the entries of row perm[k] of A whose new column index
+  // does not exceed k (A is symmetric)
+  upperColPtrs_.assign(n + 1, 0);
+  upperRowIdxs_.clear();
+  upperValueMap_.clear();
+  for (std::size_t k = 0; k < n; ++k) {
+    const std::size_t iRow = perm_[k];
+    for (IndexType p = patternRowPtrs_[iRow]; p < patternRowPtrs_[iRow + 1];
+         ++p) {
+      const std::size_t i = inversePerm_[patternColIdxs_[p]];
+      if (i <= k) {
+        upperRowIdxs_.push_back(i);
+        upperValueMap_.push_back(static_cast<std::size_t>(p));
+      }
+    }
+    upperColPtrs_[k + 1] = upperRowIdxs_.size();
+  }
+
+  // --- Elimination tree with path compression (Liu) ---
+  parent_.assign(n, -1);
+  std::vector<std::ptrdiff_t> ancestor(n, -1);
+  for (std::size_t k = 0; k < n; ++k) {
+    for (std::size_t p = upperColPtrs_[k]; p < upperColPtrs_[k + 1]; ++p) {
+      auto i = static_cast<std::ptrdiff_t>(upperRowIdxs_[p]);
+      while (i != -1 && i < static_cast<std::ptrdiff_t>(k)) {
+        const std::ptrdiff_t next = ancestor[i];
+        ancestor[i] = static_cast<std::ptrdiff_t>(k);
+        if (next == -1) {
+          parent_[i] = static_cast<std::ptrdiff_t>(k);
+        }
+        i = next;
+      }
+    }
+  }
+
+  // --- Column counts of L from the row patterns ---
+  std::vector<std::size_t> colCounts(n, 1);
+  std::vector<std::size_t> stack(n);
+  std::vector<std::size_t> mark(n, std::numeric_limits<std::size_t>::max());
+  for (std::size_t k = 0; k < n; ++k) {
+    for (std::size_t top = ereach(k, upperColPtrs_, upperRowIdxs_, parent_,
+                                  stack, mark);
+         top < n; ++top) {
+      colCounts[stack[top]]++;
+    }
+  }
+
+  colPtrs_.assign(n + 1, 0);
+  for (std::size_t j = 0; j < n; ++j) {
+    colPtrs_[j + 1] = colPtrs_[j] + colCounts[j];
+  }
+  rowIdxs_.assign(colPtrs_.back(), 0);
+  values_.assign(colPtrs_.back(), 0.0);
+}
+
+template <typename ValueType, typename IndexType>
+void SparseCholesky<ValueType, IndexType>::factorize(
+    const CsrMatrix<ValueType, IndexType> &matrix)
+{
+  if (!isAnalyzed() || matrix.rowPtrs() != patternRowPtrs_ ||
+      matrix.colIdxs() != patternColIdxs_) {
+    analyze(matrix);
+  }
+
+  // Up-looking factorization: row k of L is obtained from a sparse triangular
+  // solve with the already computed rows (CSparse's cs_chol)
+  const std::size_t n = matrix.nRows();
+  const auto &values = matrix.values();
+  std::vector<ValueType> x(n, 0.0);
+  std::vector<std::size_t> next(colPtrs_.begin(), colPtrs_.end() - 1);
+  std::vector<std::size_t> stack(n);
+  std::vector<std::size_t> mark(n, std::numeric_limits<std::size_t>::max());
+
+  for (std::size_t k = 0; k < n; ++k) {
+    std::size_t top =
+        ereach(k, upperColPtrs_, upperRowIdxs_, parent_, stack, mark);
+
+    // Scatter column k of the upper triangle
+    for (std::size_t p = upperColPtrs_[k]; p < upperColPtrs_[k + 1]; ++p) {
+      x[upperRowIdxs_[p]] = values[upperValueMap_[p]];
+    }
+    ValueType diagonal = x[k];
+    x[k] = 0.0;
+
+    for (; top < n; ++top) {
+      const std::size_t i = stack[top];
+      const ValueType lki = x[i] / values_[colPtrs_[i]];
+      x[i] = 0.0;
+      for (std::size_t p = colPtrs_[i] + 1; p < next[i]; ++p) {
+        x[rowIdxs_[p]] -= values_[p] * lki;
+      }
+      diagonal -= lki * lki;
+
+      const std::size_t p = next[i]++;
+      rowIdxs_[p] = k;
+      values_[p] = lki;
+    }
+
+    if (diagonal <= 0.0) {
+      throw std::runtime_error(
+          "Sparse Cholesky: matrix is not positive definite");
+    }
+    const std::size_t p = next[k]++;
+    rowIdxs_[p] = k;
+    values_[p] = std::sqrt(diagonal);
+  }
+}
+
+template <typename ValueType, typename IndexType>
+void SparseCholesky<ValueType, IndexType>::solve(const ValueType *b,
+                                                 ValueType *x) const
+{
+  const std::size_t n = perm_.size();
+  std::vector<ValueType> y(n);
+  for (std::size_t k = 0; k < n; ++k) {
+    y[k] = b[perm_[k]];
+  }
+
+  // Forward substitution L * z = P * b by columns
+  for (std::size_t j = 0; j < n; ++j) {
+    y[j] /= values_[colPtrs_[j]];
+    for (std::size_t p = colPtrs_[j] + 1; p < colPtrs_[j + 1]; ++p) {
+      y[rowIdxs_[p]] -= values_[p] * y[j];
+    }
+  }
+
+  // Backward substitution L^T * y = z by rows of L^T
+  for (std::size_t j = n; j-- > 0;) {
+    for (std::size_t p = colPtrs_[j] + 1; p < colPtrs_[j + 1]; ++p) {
+      y[j] -= values_[p] * y[rowIdxs_[p]];
+    }
+    y[j] /= values_[colPtrs_[j]];
+  }
+
+  for (std::size_t k = 0; k < n; ++k) {
+    x[perm_[k]] = y[k];
+  }
+}
+
+// Explicit template instantiation for commonly used types
+template class SparseCholesky<double, int>;
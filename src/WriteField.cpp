@@ -0,0 +1,354 @@
+#include "WriteField.hpp"
+#include "CompressedFile.hpp"
+#include "FoamTokenizer.hpp"
+#include "RenumberMesh.hpp"
+#include <algorithm>
+#include <charconv> // For formatting numbers without locale lookups
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace {
+
+// Output that is formatted into a large buffer and written to the file in
+// chunks, one write call per chunk, or passed on to a compressor. The rest
+// of the buffer is written by an explicit flush(), which may throw, so it is
+// not done on destruction.
+class ChunkedOutput {
+public:
+  explicit ChunkedOutput(std::ofstream &file, GzipWriter *compressor = nullptr)
+      : file_(file), compressor_(compressor), buffer_(chunkSize) {}
+
+  void append(std::string_view text) {
+    if (buffer_.size() - size_ < text.size()) {
+      flush();
+    }
+    if (text.size() > buffer_.size()) {
+      writeOut(text);
+      return;
+    }
+    text.copy(buffer_.data() + size_, text.size());
+    size_ += text.size();
+  }
+
+  void append(double value, int precision) {
+    if (buffer_.size() - size_ < maxNumberLength) {
+      flush();
+    }
+    std::to_chars_result result = format(value, precision);
+    if (result.ec == std::errc::value_too_large) {
+      // A longer number than maxNumberLength, e.g. with many digits
+      flush();
+      result = format(value, precision);
+    }
+    if (result.ec != std::errc()) {
+      throw std::runtime_error("Error: Failed to format a field value");
+    }
+    size_ = result.ptr - buffer_.data();
+  }
+
+  void append(char c) {
+    if (size_ == buffer_.size()) {
+      flush();
+    }
+    buffer_[size_++] = c;
+  }
+
+  void flush() {
+    writeOut(std::string_view(buffer_.data(), size_));
+    size_ = 0;
+  }
+
+  std::size_t nBytes() const { return nBytes_ + size_; }
+
+private:
+  std::to_chars_result format(double value, int precision) {
+    char *first = buffer_.data() + size_;
+    char *last = buffer_.data() + buffer_.size();
+    return precision > 0 ? std::to_chars(first, last, value,
+                                         std::chars_format::general, precision)
+                         : std::to_chars(first, last, value);
+  }
+
+  void writeOut(std::string_view data) {
+    if (compressor_) {
+      compressor_->write(data);
+    } else {
+      file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    nBytes_ += data.size();
+  }
+
+  static constexpr std::size_t chunkSize = 1 << 20;
+  // Longest number that to_chars writes with at most 17 significant digits
+  static constexpr std::size_t maxNumberLength = 32;
+
+  std::ofstream &file_;
+  GzipWriter *compressor_;
+  std::vector<char> buffer_;
+  std::size_t size_ = 0;
+  std::size_t nBytes_ = 0;
+};
+
+// Decode a list of the tokens and append it in the other format
+template <typename ValueType>
+void convertList(FoamTokenizer &tokens, std::string &converted) {
+  std::vector<ValueType> values;
+  tokens.readList(values);
+  converted += '\n';
+  converted += std::to_string(values.size());
+  converted += '(';
+  if (!tokens.binary()) {
+    converted.append(reinterpret_cast<const char *>(values.data()),
+                     values.size() * sizeof(ValueType));
+    converted += ')';
+    return;
+  }
+  converted += '\n';
+  char number[32];
+  for (const auto &value : values) {
+    const double *component = reinterpret_cast<const double *>(&value);
+    const std::size_t nComponents = sizeof(ValueType) / sizeof(double);
+    if (nComponents > 1) {
+      converted += '(';
+    }
+    for (std::size_t i = 0; i < nComponents; ++i) {
+      if (i > 0) {
+        converted += ' ';
+      }
+      const std::to_chars_result result =
+          std::to_chars(number, number + sizeof(number), component[i]);
+      converted.append(number, result.ptr);
+    }
+    converted += nComponents > 1 ? ")\n" : "\n";
+  }
+  converted += ')';
+}
+
+// The text with its lists of values converted from the binary format to
+// ascii or the other way around; everything else is copied
+std::string convertLists(const std::string &fileName, const std::string &text,
+                         bool binary) {
+  FoamTokenizer tokens(fileName, text, binary);
+  std::string converted;
+  std::size_t copied = 0;
+  while (!tokens.atEnd()) {
+    const FoamToken token = tokens.next();
+    if (!token.is("List<scalar>") && !token.is("List<vector>") &&
+        !token.is("List<tensor>")) {
+      continue;
+    }
+    const std::size_t start = tokens.position();
+    converted.append(text, copied, start - copied);
+    if (token.is("List<scalar>")) {
+      convertList<double>(tokens, converted);
+    } else if (token.is("List<vector>")) {
+      convertList<std::array<double, 3>>(tokens, converted);
+    } else {
+      convertList<std::array<double, 9>>(tokens, converted);
+    }
+    copied = tokens.position();
+  }
+  converted.append(text, copied, std::string::npos);
+  return converted;
+}
+
+} // namespace
+
+WriteField::WriteField(const std::string &caseDirectory)
+    : caseDirectory_(caseDirectory) {
+  const std::string controlDictName = caseDirectory + "/system/controlDict";
+  if (!std::filesystem::exists(controlDictName)) {
+    return;
+  }
+  FoamTokenizer tokens(controlDictName);
+  tokens.readHeader();
+  while (!tokens.atEnd()) {
+    const FoamToken keyword = tokens.next();
+    if (keyword.is("writePrecision")) {
+      // More than 17 digits do not change the value of a double
+      writePrecision_ =
+          static_cast<int>(std::clamp(tokens.readValue<double>(), 0.0, 17.0));
+      tokens.expect(';');
+    } else if (keyword.is("writeFormat")) {
+      writeFormat_ = tokens.word() == "binary" ? WriteFormat::binary
+                                               : WriteFormat::ascii;
+      tokens.expect(';');
+    } else if (keyword.is("writeCompression")) {
+      const std::string compression = tokens.word();
+      writeCompression_ = compression == "on" || compression == "yes" ||
+                          compression == "true" ||
+                          compression == "compressed";
+      tokens.expect(';');
+    } else if (keyword.kind == FoamToken::Kind::word) {
+      tokens.skipEntry();
+    }
+  }
+}
+
+template <typename ValueType>
+void WriteField::write(const std::vector<ValueType> &values,
+                       const std::string &timePoint,
+                       const std::string &fieldName,
+                       const std::vector<std::size_t> &cellOrdering) {
+  constexpr bool isScalar = std::is_same_v<ValueType, double>;
+  const bool binary = writeFormat_ == WriteFormat::binary;
+  SourceEntries &entries = sourceEntries(fieldName);
+
+  const std::filesystem::path targetDirectory =
+      std::filesystem::path(caseDirectory_) / timePoint;
+  std::filesystem::create_directories(targetDirectory);
+  const std::string uncompressedFilePath =
+      (targetDirectory / fieldName).string();
+  const std::string targetFilePath =
+      writeCompression_ ? uncompressedFilePath + ".gz" : uncompressedFilePath;
+
+  std::ofstream outFile(targetFilePath, std::ios::out | std::ios::binary);
+  if (!outFile.is_open()) {
+    throw std::ios_base::failure("Failed to open or create file: " +
+                                 targetFilePath);
+  }
+
+  std::optional<GzipWriter> compressor;
+  if (writeCompression_) {
+    compressor.emplace(outFile);
+  }
+  ChunkedOutput output(outFile, compressor ? &*compressor : nullptr);
+
+  // Write the header (similar to the OpenFOAM "T" file format)
+  output.append("FoamFile\n"
+                "{\n"
+                "    version     2.0;\n");
+  output.append(binary ? "    format      binary;\n"
+                         "    arch        \"LSB;label=32;scalar=64\";\n"
+                       : "    format      ascii;\n");
+  output.append(isScalar ? "    class       volScalarField;\n"
+                         : "    class       volVectorField;\n");
+  output.append("    location    \"");
+  output.append(timePoint);
+  output.append("\";\n"
+                "    object      ");
+  output.append(fieldName);
+  output.append(";\n"
+                "}\n"
+                "// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * "
+                "//\n\n");
+
+  output.append(entries.dimensions);
+  output.append("\n\n");
+
+  // Write the internal field
+  output.append(isScalar ? "internalField   nonuniform List<scalar> \n"
+                         : "internalField   nonuniform List<vector> \n");
+  output.append(std::to_string(values.size()));
+  output.append("\n(");
+  const std::vector<ValueType> originalValues =
+      RenumberMesh::toOriginalNumbering(cellOrdering, values);
+  if (binary) {
+    // The raw doubles, assuming a little-endian host
+    output.append(std::string_view(
+        reinterpret_cast<const char *>(originalValues.data()),
+        originalValues.size() * sizeof(ValueType)));
+  } else {
+    output.append('\n');
+    for (const auto &value : originalValues) {
+      if constexpr (isScalar) {
+        output.append(value, writePrecision_);
+      } else {
+        output.append('(');
+        output.append(value[0], writePrecision_);
+        output.append(' ');
+        output.append(value[1], writePrecision_);
+        output.append(' ');
+        output.append(value[2], writePrecision_);
+        output.append(')');
+      }
+      output.append('\n');
+    }
+  }
+  output.append(")\n;\n\n");
+
+  // The boundary conditions are copied, with their lists of values in the
+  // format of this file
+  if (entries.binary == binary) {
+    output.append(entries.boundaryField);
+  } else {
+    if (entries.convertedBoundaryField.empty()) {
+      entries.convertedBoundaryField =
+          convertLists(caseDirectory_ + "/0/" + fieldName,
+                       entries.boundaryField, entries.binary);
+    }
+    output.append(entries.convertedBoundaryField);
+  }
+  output.flush();
+  bytesWritten_ = output.nBytes();
+  if (compressor) {
+    compressor->finish();
+    bytesWritten_ = compressor->nBytesOut();
+  }
+
+  if (!outFile) {
+    throw std::ios_base::failure("Failed to write file: " + targetFilePath);
+  }
+
+  // A stale file of the other compression would be read instead of this one
+  std::error_code error;
+  std::filesystem::remove(writeCompression_ ? uncompressedFilePath
+                                            : uncompressedFilePath + ".gz",
+                          error);
+}
+
+// Explicit template instantiation for scalar and vector fields
+template void
+WriteField::write(const std::vector<double> &values,
+                  const std::string &timePoint, const std::string &fieldName,
+                  const std::vector<std::size_t> &cellOrdering);
+template void
+WriteField::write(const std::vector<std::array<double, 3>> &values,
+                  const std::string &timePoint, const std::string &fieldName,
+                  const std::vector<std::size_t> &cellOrdering);
+
+WriteField::SourceEntries &
+WriteField::sourceEntries(const std::string &fieldName) {
+  const auto cached = sourceEntries_.find(fieldName);
+  if (cached != sourceEntries_.end()) {
+    return cached->second;
+  }
+
+  const std::string sourceFilePath = caseDirectory_ + "/0/" + fieldName;
+  const std::string text = CompressedFile::read(sourceFilePath);
+  SourceEntries entries;
+  FoamTokenizer header(sourceFilePath, text);
+  header.readHeader();
+  entries.binary = header.binary();
+
+  // The dimensions entry, at the start of a line, up to its semicolon
+  std::size_t dimensions = text.compare(0, 10, "dimensions") == 0
+                               ? 0
+                               : text.find("\ndimensions");
+  if (dimensions != 0 && dimensions != std::string::npos) {
+    dimensions++;
+  }
+  const std::size_t dimensionsEnd = text.find(';', dimensions);
+  if (dimensions == std::string::npos || dimensionsEnd == std::string::npos) {
+    throw std::runtime_error("dimensions entry not found in source file: " +
+                             sourceFilePath);
+  }
+  entries.dimensions = text.substr(dimensions, dimensionsEnd + 1 - dimensions);
+
+  // The boundaryField entry, from the start of its line to the end of the
+  // file
+  std::size_t start = text.find("boundaryField");
+  if (start == std::string::npos) {
+    throw std::runtime_error("boundaryField entry not found in source file: " +
+                             sourceFilePath);
+  }
+  start = text.rfind('\n', start);
+  start = start == std::string::npos ? 0 : start + 1;
+  entries.boundaryField = text.substr(start);
+
+  return sourceEntries_.emplace(fieldName, std::move(entries)).first->second;
+}
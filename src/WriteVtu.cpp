@@ -0,0 +1,218 @@
+#include "WriteVtu.hpp"
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+// VTK cell type of an arbitrary polyhedron
+constexpr std::uint8_t vtkPolyhedron = 42;
+
+// An array of the appended block, written as its size in bytes followed by
+// the raw bytes
+struct AppendedArray {
+  const char *type;
+  const char *name;
+  int nComponents;
+  const void *data;
+  std::uint64_t nBytes;
+};
+
+template <typename T>
+AppendedArray appendedArray(const char *type, const char *name,
+                            int nComponents, const std::vector<T> &values) {
+  return {type, name, nComponents, values.data(), values.size() * sizeof(T)};
+}
+
+// DataArray elements of the arrays, with their offsets into the appended
+// block
+void appendDataArrays(std::string &xml,
+                      const std::vector<AppendedArray> &arrays,
+                      std::uint64_t &offset) {
+  for (const AppendedArray &array : arrays) {
+    xml += "        <DataArray type=\"";
+    xml += array.type;
+    xml += "\" Name=\"";
+    xml += array.name;
+    xml += "\"";
+    if (array.nComponents > 1) {
+      xml += " NumberOfComponents=\"" + std::to_string(array.nComponents) +
+             "\"";
+    }
+    xml += " format=\"appended\" offset=\"" + std::to_string(offset) +
+           "\"/>\n";
+    offset += sizeof(std::uint64_t) + array.nBytes;
+  }
+}
+
+std::string caseName(const std::string &caseDirectory) {
+  std::filesystem::path path =
+      std::filesystem::path(caseDirectory).lexically_normal();
+  if (!path.has_filename()) {
+    path = path.parent_path();
+  }
+  return path.filename().string();
+}
+
+} // namespace
+
+WriteVtu::WriteVtu(Mesh &fvMesh) : fvMesh_(fvMesh) {
+  const std::size_t nCells = fvMesh.nCells();
+  offsets_.reserve(nCells);
+  types_.assign(nCells, vtkPolyhedron);
+  faceOffsets_.reserve(nCells);
+
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    Cell &theCell = fvMesh.cells()[iElement];
+    connectivity_.insert(connectivity_.end(), theCell.iNodes().begin(),
+                         theCell.iNodes().end());
+    offsets_.push_back(static_cast<std::int64_t>(connectivity_.size()));
+
+    // Number of faces, then the node count and nodes of each face, ordered
+    // so that the face normal points out of the cell
+    faces_.push_back(static_cast<std::int64_t>(theCell.iFaces().size()));
+    for (std::size_t iFace = 0; iFace < theCell.iFaces().size(); ++iFace) {
+      const std::vector<std::size_t> &iNodes =
+          fvMesh.faces()[theCell.iFaces()[iFace]].iNodes();
+      faces_.push_back(static_cast<std::int64_t>(iNodes.size()));
+      if (theCell.faceSigns()[iFace] > 0) {
+        faces_.insert(faces_.end(), iNodes.begin(), iNodes.end());
+      } else {
+        faces_.insert(faces_.end(), iNodes.rbegin(), iNodes.rend());
+      }
+    }
+    faceOffsets_.push_back(static_cast<std::int64_t>(faces_.size()));
+  }
+}
+
+template <typename ValueType>
+void WriteVtu::addField(const std::string &fieldName,
+                        const std::vector<ValueType> &values) {
+  if (values.size() != fvMesh_.nCells()) {
+    throw std::runtime_error("Error: Field " + fieldName + " has " +
+                             std::to_string(values.size()) +
+                             " values for " +
+                             std::to_string(fvMesh_.nCells()) + " cells");
+  }
+  constexpr int nComponents = std::is_same_v<ValueType, double> ? 1 : 3;
+  fields_.push_back({fieldName, nComponents,
+                     reinterpret_cast<const double *>(values.data())});
+}
+
+// Explicit template instantiation for scalar and vector fields
+template void WriteVtu::addField(const std::string &fieldName,
+                                 const std::vector<double> &values);
+template void
+WriteVtu::addField(const std::string &fieldName,
+                   const std::vector<std::array<double, 3>> &values);
+
+void WriteVtu::write(const std::string &fileName) {
+  const std::size_t nCells = fvMesh_.nCells();
+  std::vector<double> points(3 * fvMesh_.nNodes());
+  for (std::size_t iNode = 0; iNode < fvMesh_.nNodes(); ++iNode) {
+    const std::array<double, 3> &centroid = fvMesh_.nodes()[iNode].centroid();
+    points[3 * iNode] = centroid[0];
+    points[3 * iNode + 1] = centroid[1];
+    points[3 * iNode + 2] = centroid[2];
+  }
+
+  std::vector<AppendedArray> pointArrays = {
+      appendedArray("Float64", "Points", 3, points)};
+  std::vector<AppendedArray> cellArrays = {
+      appendedArray("Int64", "connectivity", 1, connectivity_),
+      appendedArray("Int64", "offsets", 1, offsets_),
+      appendedArray("UInt8", "types", 1, types_),
+      appendedArray("Int64", "faces", 1, faces_),
+      appendedArray("Int64", "faceoffsets", 1, faceOffsets_)};
+  std::vector<AppendedArray> fieldArrays;
+  fieldArrays.reserve(fields_.size());
+  for (const CellField &field : fields_) {
+    fieldArrays.push_back(
+        {"Float64", field.name.c_str(), field.nComponents, field.values,
+         nCells * field.nComponents * sizeof(double)});
+  }
+
+  std::uint64_t offset = 0;
+  std::string xml = "<?xml version=\"1.0\"?>\n"
+                    "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+                    "byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+                    "  <UnstructuredGrid>\n"
+                    "    <Piece NumberOfPoints=\"" +
+                    std::to_string(fvMesh_.nNodes()) + "\" NumberOfCells=\"" +
+                    std::to_string(nCells) + "\">\n";
+  xml += "      <Points>\n";
+  appendDataArrays(xml, pointArrays, offset);
+  xml += "      </Points>\n"
+         "      <Cells>\n";
+  appendDataArrays(xml, cellArrays, offset);
+  xml += "      </Cells>\n"
+         "      <CellData>\n";
+  appendDataArrays(xml, fieldArrays, offset);
+  xml += "      </CellData>\n"
+         "    </Piece>\n"
+         "  </UnstructuredGrid>\n"
+         "  <AppendedData encoding=\"raw\">\n"
+         "_";
+
+  std::ofstream outFile(fileName, std::ios::out | std::ios::binary);
+  if (!outFile.is_open()) {
+    throw std::ios_base::failure("Failed to open or create file: " + fileName);
+  }
+  outFile.write(xml.data(), static_cast<std::streamsize>(xml.size()));
+  // The arrays as raw bytes, assuming a little-endian host
+  for (const auto *arrays : {&pointArrays, &cellArrays, &fieldArrays}) {
+    for (const AppendedArray &array : *arrays) {
+      outFile.write(reinterpret_cast<const char *>(&array.nBytes),
+                    sizeof(array.nBytes));
+      outFile.write(static_cast<const char *>(array.data),
+                    static_cast<std::streamsize>(array.nBytes));
+    }
+  }
+  const std::string end = "\n  </AppendedData>\n</VTKFile>\n";
+  outFile.write(end.data(), static_cast<std::streamsize>(end.size()));
+  outFile.close();
+  if (!outFile) {
+    throw std::ios_base::failure("Failed to write file: " + fileName);
+  }
+
+  bytesWritten_ = xml.size() + offset + end.size();
+  fields_.clear();
+}
+
+void WriteVtu::writeTimeStep(double time) {
+  const std::filesystem::path directory =
+      std::filesystem::path(fvMesh_.caseDir()) / "VTK";
+  std::filesystem::create_directories(directory);
+  const std::string name = caseName(fvMesh_.caseDir());
+  const std::string fileName =
+      name + "_" + std::to_string(timeSteps_.size()) + ".vtu";
+  write((directory / fileName).string());
+  timeSteps_.emplace_back(time, fileName);
+
+  // The series file, rewritten so that it is complete after every step
+  std::string pvd = "<?xml version=\"1.0\"?>\n"
+                    "<VTKFile type=\"Collection\" version=\"1.0\" "
+                    "byte_order=\"LittleEndian\">\n"
+                    "  <Collection>\n";
+  for (const auto &[stepTime, stepFileName] : timeSteps_) {
+    char buffer[32];
+    const std::to_chars_result result =
+        std::to_chars(buffer, buffer + sizeof(buffer), stepTime);
+    pvd += "    <DataSet timestep=\"" + std::string(buffer, result.ptr) +
+           "\" part=\"0\" file=\"" + stepFileName + "\"/>\n";
+  }
+  pvd += "  </Collection>\n"
+         "</VTKFile>\n";
+
+  const std::string pvdName = (directory / (name + ".pvd")).string();
+  std::ofstream pvdFile(pvdName, std::ios::out | std::ios::binary);
+  if (!pvdFile.is_open()) {
+    throw std::ios_base::failure("Failed to open or create file: " + pvdName);
+  }
+  pvdFile << pvd;
+  if (!pvdFile) {
+    throw std::ios_base::failure("Failed to write file: " + pvdName);
+  }
+}
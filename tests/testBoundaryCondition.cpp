@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include "AssembleDiffusionTerm.hpp"
+#include "BoundaryCondition.hpp"
+#include "Field.hpp"
+#include "GenerateMesh.hpp"
+#include "Matrix.hpp"
+#include "Mesh.hpp"
+#include "arrayOperations.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include "utilitiesForTesting.hpp"
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ****** Helpers ******
+// Row of three unit cubes: fixedValue 1 on the left, mixed on the right with
+// valueFraction 0.5, refValue 2 and refGradient 4, zeroGradient elsewhere
+template <typename ValueType>
+std::vector<boundaryField<ValueType>> rowBoundaryFields(Mesh &fvMesh,
+                                                        ValueType unit)
+{
+  std::vector<boundaryField<ValueType>> boundaryFields(fvMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    boundaryFields[iBoundary].setBoundaryType("zeroGradient");
+  }
+  boundaryFields[0].setBoundaryType("fixedValue");
+  boundaryFields[0].values().assign(1, unit);
+  boundaryFields[1].setBoundaryType("mixed");
+  boundaryFields[1].values().assign(1, 2.0 * unit);
+  boundaryFields[1].gradient().assign(1, 4.0 * unit);
+  boundaryFields[1].valueFraction().assign(1, 0.5);
+  return boundaryFields;
+}
+
+// ****** Tests ******
+TEST(BoundaryConditionTest, ResolvesTypeNames)
+{
+  // --- Arrange ---
+  boundaryField<double> field;
+
+  // --- Act ---
+  field.setBoundaryType("noSlip");
+
+  // --- Assert ---
+  EXPECT_EQ(field.boundaryType(), "noSlip");
+  EXPECT_EQ(field.conditionType(), BoundaryConditionType::fixedValue);
+  EXPECT_EQ(toBoundaryConditionType("fixedGradient"),
+            BoundaryConditionType::fixedGradient);
+  EXPECT_EQ(toBoundaryConditionType("empty"), BoundaryConditionType::empty);
+  // Types without a contribution of their own keep their name
+  field.setBoundaryType("symmetryPlane");
+  EXPECT_EQ(field.boundaryType(), "symmetryPlane");
+  EXPECT_EQ(field.conditionType(), BoundaryConditionType::zeroGradient);
+  for (const std::string typeName :
+       {"calculated", "slip", "symmetry", "nutkWallFunction"}) {
+    EXPECT_EQ(toBoundaryConditionType(typeName),
+              BoundaryConditionType::zeroGradient);
+  }
+}
+
+TEST(BoundaryConditionTest, RejectsCoupledAndUnknownTypeNames)
+{
+  // --- Arrange ---
+  boundaryField<double> field;
+  field.setBoundaryType("fixedValue");
+
+  // --- Act and Assert ---
+  for (const std::string typeName :
+       {"processor", "cyclic", "cyclicAMI", "fixedvalue", "WallFunction", ""}) {
+    EXPECT_THROW(field.setBoundaryType(typeName), std::invalid_argument)
+        << typeName;
+  }
+  // A rejected type leaves the field as it was
+  EXPECT_EQ(field.boundaryType(), "fixedValue");
+  EXPECT_EQ(field.conditionType(), BoundaryConditionType::fixedValue);
+}
+
+TEST(BoundaryConditionTest, MixedConditionBlendsValueAndGradient)
+{
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+  meshGenerator.cartesianBox(fvMesh, {3, 1, 1}, {3.0, 1.0, 1.0});
+  std::vector<boundaryField<double>> boundaryFields =
+      rowBoundaryFields(fvMesh, 1.0);
+  const std::vector<double> diffusionCoef(fvMesh.nFaces(), 1.0);
+  const std::vector<double> source(fvMesh.nCells(), 0.0);
+  AssembleDiffusionTerm diffusionTermAssembler;
+
+  // gDiff is 2 on the boundary faces and 1 on the interior faces
+  const std::vector<double> expectedDiag = {3.0, 2.0, 2.0};
+  const std::vector<double> expectedRHS = {2.0, 0.0, 4.0};
+
+  // --- Act ---
+  Matrix<double> coeffMatrix(3, 3);
+  std::vector<double> RHS(3, 0.0);
+  diffusionTermAssembler.faceBasedAssemble(fvMesh, diffusionCoef, source,
+                                           boundaryFields, coeffMatrix, RHS);
+  gko::matrix_data<double, int> batchedMatrix;
+  std::vector<double> batchedRHS(3, 0.0);
+  diffusionTermAssembler.batchedFaceBasedAssemble(
+      fvMesh, diffusionCoef, source, boundaryFields, batchedMatrix, batchedRHS);
+
+  // --- Assert ---
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_DOUBLE_EQ(coeffMatrix(i, i), expectedDiag[i]);
+    EXPECT_DOUBLE_EQ(RHS[i], expectedRHS[i]);
+    EXPECT_DOUBLE_EQ(batchedRHS[i], expectedRHS[i]);
+  }
+  for (const auto &nonzero : batchedMatrix.nonzeros) {
+    EXPECT_DOUBLE_EQ(nonzero.value,
+                     coeffMatrix(nonzero.row, nonzero.column));
+  }
+}
+
+TEST(BoundaryConditionTest, VectorKernelsMatchScalarKernels)
+{
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+  meshGenerator.cartesianBox(fvMesh, {3, 1, 1}, {3.0, 1.0, 1.0});
+  const std::array<double, 3> unit = {1.0, -1.0, 0.5};
+  std::vector<boundaryField<std::array<double, 3>>> boundaryFields =
+      rowBoundaryFields(fvMesh, unit);
+  Field<std::array<double, 3>> internalVelocity(fvMesh.nCells());
+  AssembleDiffusionTerm diffusionTermAssembler;
+
+  const std::vector<double> expectedDiag = {3.0, 2.0, 2.0};
+  const std::vector<double> expectedRHS = {2.0, 0.0, 4.0};
+
+  // --- Act ---
+  std::vector<gko::matrix_data<double, int>> coeffMatrix(3);
+  std::vector<std::array<double, 3>> RHS(fvMesh.nCells(), {0.0, 0.0, 0.0});
+  diffusionTermAssembler.cellBasedAssemble(fvMesh, 1.0, internalVelocity,
+                                           boundaryFields, coeffMatrix, RHS);
+
+  // --- Assert ---
+  for (std::size_t dim = 0; dim < 3; ++dim) {
+    for (const auto &nonzero : coeffMatrix[dim].nonzeros) {
+      if (nonzero.row == nonzero.column) {
+        EXPECT_DOUBLE_EQ(nonzero.value, expectedDiag[nonzero.row]);
+      }
+    }
+    for (std::size_t i = 0; i < 3; ++i) {
+      EXPECT_DOUBLE_EQ(RHS[i][dim], expectedRHS[i] * unit[dim]);
+    }
+  }
+}
+
+TEST(BoundaryConditionTest, UniformValuesAreBroadcast)
+{
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+  meshGenerator.cartesianBox(fvMesh, {3, 2, 2}, {3.0, 2.0, 2.0});
+  std::vector<boundaryField<double>> uniformFields(fvMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    uniformFields[iBoundary].setBoundaryType("fixedValue");
+    uniformFields[iBoundary].resize(fvMesh.boundaries()[iBoundary].nFaces());
+    uniformFields[iBoundary].set(1.0 + iBoundary);
+  }
+  std::vector<boundaryField<double>> expandedFields = uniformFields;
+  for (auto &field : expandedFields) {
+    field.values();
+  }
+  const std::vector<double> diffusionCoef(fvMesh.nFaces(), 1.0);
+  const std::vector<double> source(fvMesh.nCells(), 0.0);
+  AssembleDiffusionTerm diffusionTermAssembler;
+
+  // --- Act ---
+  gko::matrix_data<double, int> uniformMatrix;
+  std::vector<double> uniformRHS(fvMesh.nCells(), 0.0);
+  diffusionTermAssembler.batchedFaceBasedAssemble(
+      fvMesh, diffusionCoef, source, uniformFields, uniformMatrix, uniformRHS);
+  gko::matrix_data<double, int> expandedMatrix;
+  std::vector<double> expandedRHS(fvMesh.nCells(), 0.0);
+  diffusionTermAssembler.batchedFaceBasedAssemble(
+      fvMesh, diffusionCoef, source, expandedFields, expandedMatrix, expandedRHS);
+
+  // --- Assert ---
+  for (const auto &field : uniformFields) {
+    EXPECT_TRUE(field.isUniform());
+  }
+  EXPECT_FALSE(expandedFields[0].isUniform());
+  EXPECT_TRUE(VectorMatch(uniformRHS, expandedRHS, fvMesh.nCells()));
+  ASSERT_EQ(uniformMatrix.nonzeros.size(), expandedMatrix.nonzeros.size());
+  for (std::size_t i = 0; i < uniformMatrix.nonzeros.size(); ++i) {
+    EXPECT_EQ(uniformMatrix.nonzeros[i].value, expandedMatrix.nonzeros[i].value);
+  }
+}
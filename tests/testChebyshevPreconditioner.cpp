@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "ChebyshevPreconditioner.hpp"
+#include "CsrMatrix.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include "utilitiesForTesting.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// ****** Helpers ******
+double residualNorm(const CsrMatrix<double, int> &matrix,
+                    const std::vector<double> &x,
+                    const std::vector<double> &b)
+{
+  std::vector<double> Ax(x.size());
+  matrix.apply(x.data(), Ax.data());
+  double sum = 0.0;
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    sum += (b[i] - Ax[i]) * (b[i] - Ax[i]);
+  }
+  return std::sqrt(sum);
+}
+
+// ****** Tests ******
+TEST(ChebyshevPreconditionerTest, GershgorinBoundsTheSpectrum)
+{
+  // --- Arrange ---
+  const int n = 50;
+  auto matrix =
+      std::make_shared<const CsrMatrix<double, int>>(laplacianMatrix(n, 1));
+
+  // Eigenvalues of D^{-1} * A are those of A divided by 2
+  const double expected_max = 1.0 - std::cos(n * M_PI / (n + 1));
+
+  // --- Act ---
+  ChebyshevPreconditioner<double, int> chebyshev(
+      matrix, 3, SpectralEstimate::gershgorin);
+
+  // --- Assert ---
+  EXPECT_GE(chebyshev.maxEigenvalue(), expected_max);
+  EXPECT_DOUBLE_EQ(chebyshev.maxEigenvalue(), 2.0);
+  EXPECT_DOUBLE_EQ(chebyshev.minEigenvalue(), 2.0 / 30.0);
+}
+
+TEST(ChebyshevPreconditionerTest, LanczosEstimatesTheLargestEigenvalue)
+{
+  // --- Arrange ---
+  const int n = 50;
+  auto matrix =
+      std::make_shared<const CsrMatrix<double, int>>(laplacianMatrix(n, 1));
+  const double expected_max = 1.0 - std::cos(n * M_PI / (n + 1));
+
+  // --- Act ---
+  ChebyshevPreconditioner<double, int> chebyshev(
+      matrix, 3, SpectralEstimate::lanczos, 20);
+
+  // --- Assert ---
+  // Upper end enlarged by at most the 10% safety margin
+  EXPECT_GE(chebyshev.maxEigenvalue(), expected_max);
+  EXPECT_LE(chebyshev.maxEigenvalue(), 1.1 * expected_max);
+  EXPECT_GT(chebyshev.minEigenvalue(), 0.0);
+}
+
+TEST(ChebyshevPreconditionerTest, PreconditionerIsSymmetric)
+{
+  // --- Arrange ---
+  auto matrix =
+      std::make_shared<const CsrMatrix<double, int>>(laplacianMatrix(30, 1));
+  ChebyshevPreconditioner<double, int> chebyshev(matrix, 5);
+  std::vector<double> x(30);
+  std::vector<double> y(30);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    x[i] = std::sin(0.3 * static_cast<double>(i));
+    y[i] = 1.0 + 0.1 * static_cast<double>(i);
+  }
+  std::vector<double> Mx(30);
+  std::vector<double> My(30);
+
+  // --- Act ---
+  chebyshev.apply(x.data(), Mx.data());
+  chebyshev.apply(y.data(), My.data());
+
+  // --- Assert ---
+  double yMx = 0.0;
+  double xMy = 0.0;
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    yMx += y[i] * Mx[i];
+    xMy += x[i] * My[i];
+  }
+  EXPECT_TRUE(ScalarAlmostEqual(yMx, xMy, 1.0e-12, 1.0e-10));
+}
+
+TEST(ChebyshevPreconditionerTest, HigherDegreeReducesResidual)
+{
+  // --- Arrange ---
+  auto matrix =
+      std::make_shared<const CsrMatrix<double, int>>(laplacianMatrix(40, 1));
+  const std::vector<double> RHS(40, 1.0);
+  std::vector<double> lowDegreeSolution(40);
+  std::vector<double> highDegreeSolution(40);
+
+  // --- Act ---
+  ChebyshevPreconditioner<double, int> lowDegree(matrix, 2);
+  ChebyshevPreconditioner<double, int> highDegree(matrix, 8);
+  lowDegree.apply(RHS.data(), lowDegreeSolution.data());
+  highDegree.apply(RHS.data(), highDegreeSolution.data());
+
+  // --- Assert ---
+  EXPECT_LT(residualNorm(*matrix, highDegreeSolution, RHS),
+            residualNorm(*matrix, lowDegreeSolution, RHS));
+}
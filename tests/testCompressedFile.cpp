@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "CompressedFile.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <zlib.h>
+
+// ****** Helpers ******
+namespace {
+
+std::string sampleText(std::size_t nLines)
+{
+  std::string text;
+  for (std::size_t iLine = 0; iLine < nLines; ++iLine) {
+    text += std::to_string(300.0 + iLine / 7.0) + "\n";
+  }
+  return text;
+}
+
+void compressFile(const std::filesystem::path &fileName)
+{
+  const std::string text = CompressedFile::read(fileName.string());
+  std::ofstream outFile(fileName.string() + ".gz", std::ios::binary);
+  GzipWriter compressor(outFile);
+  compressor.write(text);
+  compressor.finish();
+  outFile.close();
+  std::filesystem::remove(fileName);
+}
+
+} // namespace
+
+// ****** Tests ******
+TEST(CompressedFileTest, IndependentBlocksAreOneGzipFile)
+{
+  // --- Arrange ---
+  const std::string text = sampleText(20000);
+  const std::filesystem::path fileName =
+      std::filesystem::temp_directory_path() / "testCompressedFile.gz";
+
+  // --- Act ---
+  std::ofstream outFile(fileName, std::ios::binary);
+  GzipWriter compressor(outFile, 6, 4096);
+  // Pieces that do not line up with the blocks
+  for (std::size_t start = 0; start < text.size(); start += 1000) {
+    compressor.write(std::string_view(text).substr(start, 1000));
+  }
+  compressor.finish();
+  outFile.close();
+
+  // --- Assert ---
+  EXPECT_EQ(compressor.nBytesIn(), text.size());
+  EXPECT_EQ(compressor.nBytesOut(), std::filesystem::file_size(fileName));
+  EXPECT_LT(compressor.nBytesOut(), text.size() / 2);
+
+  // zlib reads all members, as gunzip and OpenFOAM do
+  gzFile gzipFile = gzopen(fileName.string().c_str(), "rb");
+  ASSERT_NE(gzipFile, nullptr);
+  std::string zlibText(text.size() + 1, '\0');
+  const int nRead = gzread(gzipFile, zlibText.data(),
+                           static_cast<unsigned>(zlibText.size()));
+  gzclose(gzipFile);
+  zlibText.resize(nRead > 0 ? nRead : 0);
+  EXPECT_EQ(zlibText, text);
+
+  // Looked up without the extension
+  const std::string uncompressedName =
+      (std::filesystem::temp_directory_path() / "testCompressedFile").string();
+  EXPECT_EQ(CompressedFile::resolve(uncompressedName), fileName.string());
+  EXPECT_EQ(CompressedFile::read(uncompressedName), text);
+
+  std::filesystem::remove(fileName);
+}
+
+TEST(CompressedFileTest, EmptyAndCorruptFiles)
+{
+  // --- Arrange ---
+  const std::filesystem::path fileName =
+      std::filesystem::temp_directory_path() / "testCompressedFileEmpty.gz";
+
+  // --- Act ---
+  std::ofstream outFile(fileName, std::ios::binary);
+  GzipWriter compressor(outFile);
+  compressor.finish();
+  outFile.close();
+
+  // --- Assert ---
+  EXPECT_EQ(CompressedFile::read(fileName.string()), "");
+
+  // A truncated file is an error, not a short read
+  std::ofstream largeFile(fileName, std::ios::binary);
+  GzipWriter largeCompressor(largeFile);
+  largeCompressor.write(sampleText(1000));
+  largeCompressor.finish();
+  largeFile.close();
+  std::filesystem::resize_file(fileName,
+                               std::filesystem::file_size(fileName) - 12);
+  EXPECT_THROW(CompressedFile::read(fileName.string()), std::runtime_error);
+
+  std::filesystem::remove(fileName);
+  EXPECT_FALSE(CompressedFile::exists(fileName.string()));
+}
+
+TEST(CompressedFileTest, CompressedMeshReadsLikeUncompressed)
+{
+  // --- Arrange ---
+  const std::string caseDirectory =
+      "../../cases/testReadInitialBoundaryConditions";
+  const std::filesystem::path copy =
+      std::filesystem::temp_directory_path() / "testCompressedMesh";
+  std::filesystem::remove_all(copy);
+  std::filesystem::copy(caseDirectory, copy,
+                        std::filesystem::copy_options::recursive);
+  for (const char *name : {"points", "faces", "owner", "neighbour",
+                           "boundary"}) {
+    compressFile(copy / "constant" / "polyMesh" / name);
+  }
+  Mesh referenceMesh(caseDirectory);
+  Mesh fvMesh(copy.string());
+  ReadMesh meshReader;
+
+  // --- Act ---
+  meshReader.readOpenFoamMesh(referenceMesh);
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  // --- Assert ---
+  EXPECT_FALSE(std::filesystem::exists(copy / "constant/polyMesh/points"));
+  ASSERT_EQ(fvMesh.nNodes(), referenceMesh.nNodes());
+  ASSERT_EQ(fvMesh.nFaces(), referenceMesh.nFaces());
+  EXPECT_EQ(fvMesh.nCells(), referenceMesh.nCells());
+  EXPECT_EQ(fvMesh.nInteriorFaces(), referenceMesh.nInteriorFaces());
+  for (std::size_t iNode = 0; iNode < fvMesh.nNodes(); ++iNode) {
+    EXPECT_EQ(fvMesh.nodes()[iNode].centroid(),
+              referenceMesh.nodes()[iNode].centroid());
+  }
+  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+    EXPECT_EQ(fvMesh.faces()[iFace].iNodes(),
+              referenceMesh.faces()[iFace].iNodes());
+  }
+  ASSERT_EQ(fvMesh.nBoundaries(), referenceMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
+       ++iBoundary) {
+    EXPECT_EQ(fvMesh.boundaries()[iBoundary].userName(),
+              referenceMesh.boundaries()[iBoundary].userName());
+    EXPECT_EQ(fvMesh.boundaries()[iBoundary].nFaces(),
+              referenceMesh.boundaries()[iBoundary].nFaces());
+  }
+
+  std::filesystem::remove_all(copy);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "DecomposeMesh.hpp"
+#include "Decomposition.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "utilitiesForTesting.hpp"
+#include <string>
+#include <vector>
+
+// ****** Helpers ******
+// Check that every cell is listed exactly once, at its local index, and that
+// every interface face is listed on both sides
+void checkConsistency(Mesh &fvMesh, Decomposition &decomposition)
+{
+  std::vector<std::size_t> nListed(fvMesh.nCells(), 0);
+  for (std::size_t iSubdomain = 0; iSubdomain < decomposition.nSubdomains(); ++iSubdomain) {
+    auto &cells = decomposition.subdomains()[iSubdomain].cells();
+    for (std::size_t iLocal = 0; iLocal < cells.size(); ++iLocal) {
+      nListed[cells[iLocal]]++;
+      EXPECT_EQ(decomposition.cellToSubdomain()[cells[iLocal]], iSubdomain);
+      EXPECT_EQ(decomposition.localIndex()[cells[iLocal]], iLocal);
+    }
+  }
+  EXPECT_TRUE(VectorMatch(nListed, std::vector<std::size_t>(fvMesh.nCells(), 1), fvMesh.nCells()));
+
+  std::size_t nInterfaceFaces = 0;
+  for (std::size_t iSubdomain = 0; iSubdomain < decomposition.nSubdomains(); ++iSubdomain) {
+    for (auto &interface : decomposition.subdomains()[iSubdomain].interfaces()) {
+      nInterfaceFaces += interface.faces.size();
+      bool matched = false;
+      for (auto &other : decomposition.subdomains()[interface.neighbor].interfaces()) {
+        if (other.neighbor == iSubdomain) {
+          matched = true;
+          EXPECT_TRUE(VectorMatch(other.faces, interface.faces, interface.faces.size()));
+        }
+      }
+      EXPECT_TRUE(matched);
+    }
+  }
+  EXPECT_EQ(nInterfaceFaces, 2 * decomposition.edgeCut());
+}
+
+// ****** Tests ******
+TEST(DecomposeMeshTest, ReadDecomposeParDict)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/cavity");
+  Mesh fvMesh(caseDirectory);
+
+  // --- Act ---
+  DecomposeMesh meshDecomposer;
+  meshDecomposer.readDecomposeParDict(fvMesh);
+
+  // --- Assert ---
+  EXPECT_EQ(meshDecomposer.nSubdomains(), 9);
+  EXPECT_EQ(meshDecomposer.method(), DecompositionMethod::hierarchical);
+  EXPECT_EQ(meshDecomposer.n()[0], 3);
+  EXPECT_EQ(meshDecomposer.n()[1], 3);
+  EXPECT_EQ(meshDecomposer.n()[2], 1);
+}
+
+TEST(DecomposeMeshTest, HierarchicalSplitOfCavity)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/cavity");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  DecomposeMesh meshDecomposer;
+  meshDecomposer.readDecomposeParDict(fvMesh);
+
+  // --- Act ---
+  Decomposition decomposition = meshDecomposer.decompose(fvMesh);
+
+  // --- Assert ---
+  checkConsistency(fvMesh, decomposition);
+  // Slabs of 133, 133 and 134 cells split into 44 to 45 cells each. The cut
+  // is close to the two lines of 20 faces in each direction.
+  EXPECT_NEAR(decomposition.imbalance(), 45.0 * 9.0 / 400.0, 1.0e-12);
+  EXPECT_GE(decomposition.edgeCut(), 80);
+  EXPECT_LT(decomposition.edgeCut(), 100);
+}
+
+TEST(DecomposeMeshTest, AllMethodsBalanceElbow)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  DecomposeMesh meshDecomposer;
+  meshDecomposer.nSubdomains() = 6;
+  meshDecomposer.n() = {3, 2, 1};
+
+  for (auto method : {DecompositionMethod::simple, DecompositionMethod::hierarchical,
+                      DecompositionMethod::recursiveBisection, DecompositionMethod::multilevel}) {
+    // --- Act ---
+    meshDecomposer.method() = method;
+    Decomposition decomposition = meshDecomposer.decompose(fvMesh);
+
+    // --- Assert ---
+    checkConsistency(fvMesh, decomposition);
+    EXPECT_EQ(decomposition.nSubdomains(), 6);
+    if (method != DecompositionMethod::simple) {
+      EXPECT_LT(decomposition.imbalance(), 1.1) << static_cast<int>(method);
+    }
+  }
+}
+
+TEST(DecomposeMeshTest, MultilevelCutsFewerFacesThanSimple)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  DecomposeMesh meshDecomposer;
+  meshDecomposer.nSubdomains() = 4;
+  meshDecomposer.n() = {4, 1, 1};
+
+  // --- Act ---
+  meshDecomposer.method() = DecompositionMethod::simple;
+  const std::size_t simpleCut = meshDecomposer.decompose(fvMesh).edgeCut();
+  meshDecomposer.method() = DecompositionMethod::multilevel;
+  const std::size_t multilevelCut = meshDecomposer.decompose(fvMesh).edgeCut();
+
+  // --- Assert ---
+  EXPECT_LT(multilevelCut, simpleCut);
+}
@@ -0,0 +1,367 @@
+#include <gtest/gtest.h>
+
+#include "AssembleDiffusionTerm.hpp"
+#include "CsrMatrix.hpp"
+#include "DecomposeMesh.hpp"
+#include "DecomposedMesh.hpp"
+#include "DistributedMesh.hpp"
+#include "Field.hpp"
+#include "GenerateMesh.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "arrayOperations.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include "utilitiesForTesting.hpp"
+#include <algorithm>
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ****** Helpers ******
+// Assemble the diffusion term with T = 1 on the first patch and 0 elsewhere
+void assembleHeatConduction(Mesh &fvMesh, gko::matrix_data<double, int> &coeffMatrix, std::vector<double> &RHS)
+{
+  std::vector<boundaryField<double>> boundaryFields(fvMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    boundaryFields[iBoundary].setBoundaryType("fixedValue");
+    boundaryFields[iBoundary].resize(fvMesh.boundaries()[iBoundary].nFaces());
+    boundaryFields[iBoundary].set(iBoundary == 0 ? 1.0 : 0.0);
+  }
+  const std::vector<double> diffusionCoef(fvMesh.nFaces(), 1.0);
+  const std::vector<double> source(fvMesh.nCells(), 0.0);
+  RHS.assign(fvMesh.nCells(), 0.0);
+  AssembleDiffusionTerm diffusionTermAssembler;
+  diffusionTermAssembler.faceBasedAssemble(fvMesh, diffusionCoef, source, boundaryFields, coeffMatrix, RHS);
+}
+
+// ****** Tests ******
+TEST(GenerateMeshTest, CartesianBoxTopologyAndGeometry)
+{
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+
+  // --- Act ---
+  meshGenerator.cartesianBox(fvMesh, {4, 3, 2}, {2.0, 1.5, 1.0});
+
+  // --- Assert ---
+  EXPECT_EQ(fvMesh.nCells(), 24);
+  EXPECT_EQ(fvMesh.nNodes(), 60);
+  EXPECT_EQ(fvMesh.nInteriorFaces(), 3 * 3 * 2 + 4 * 2 * 2 + 4 * 3 * 1);
+  EXPECT_EQ(fvMesh.nFaces() - fvMesh.nInteriorFaces(), 2 * (3 * 2 + 4 * 2 + 4 * 3));
+  EXPECT_EQ(fvMesh.boundaries()[0].userName(), "left");
+  EXPECT_EQ(fvMesh.boundaries()[0].nFaces(), 6);
+
+  // Unit cubes of size 0.5 with outward boundary normals
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    EXPECT_NEAR(fvMesh.cells()[iElement].volume(), 0.125, 1.0e-14);
+  }
+  const std::array<double, 3> expected_centroid = {1.75, 1.25, 0.75};
+  EXPECT_TRUE(VectorAlmostEqual(fvMesh.cells()[23].centroid(), expected_centroid, 3, 1.0e-14, 1.0e-14));
+  for (std::size_t iFace = 0; iFace < fvMesh.nInteriorFaces(); ++iFace) {
+    Face &theFace = fvMesh.faces()[iFace];
+    EXPECT_LT(theFace.iOwner(), theFace.iNeighbor());
+    EXPECT_GT(dot_product(theFace.Sf(), theFace.CN()), 0.0);
+  }
+  for (std::size_t iFace = fvMesh.nInteriorFaces(); iFace < fvMesh.nFaces(); ++iFace) {
+    EXPECT_GT(dot_product(fvMesh.faces()[iFace].Sf(), fvMesh.faces()[iFace].CN()), 0.0);
+  }
+}
+
+TEST(DistributedMeshTest, LocalAssemblyReproducesGlobalRows)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh globalMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(globalMesh);
+  DecomposeMesh meshDecomposer;
+  meshDecomposer.nSubdomains() = 4;
+  meshDecomposer.method() = DecompositionMethod::multilevel;
+  Decomposition decomposition = meshDecomposer.decompose(globalMesh);
+
+  gko::matrix_data<double, int> globalMatrix;
+  std::vector<double> globalRHS;
+  assembleHeatConduction(globalMesh, globalMatrix, globalRHS);
+
+  // --- Act ---
+  gko::matrix_data<double, int> gatheredMatrix(gko::dim<2>(globalMesh.nCells(), globalMesh.nCells()));
+  std::vector<double> gatheredRHS(globalMesh.nCells(), 0.0);
+  std::size_t nOwnedCells = 0;
+  for (std::size_t iSubdomain = 0; iSubdomain < 4; ++iSubdomain) {
+    DistributedMesh distributedMesh(globalMesh, decomposition, iSubdomain);
+    gko::matrix_data<double, int> localMatrix;
+    std::vector<double> localRHS;
+    assembleHeatConduction(distributedMesh.localMesh(), localMatrix, localRHS);
+
+    const auto ownedRows = distributedMesh.ownedRows<int>(localMatrix);
+    gatheredMatrix.nonzeros.insert(gatheredMatrix.nonzeros.end(), ownedRows.nonzeros.begin(), ownedRows.nonzeros.end());
+    const auto ownedRHS = distributedMesh.ownedValues(localRHS);
+    auto &cells = decomposition.subdomains()[iSubdomain].cells();
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+      gatheredRHS[cells[i]] = ownedRHS[i];
+    }
+    nOwnedCells += distributedMesh.ownedCells().size();
+  }
+
+  // --- Assert ---
+  EXPECT_EQ(nOwnedCells, globalMesh.nCells());
+  const CsrMatrix<double, int> expected_matrix(globalMatrix);
+  const CsrMatrix<double, int> matrix(gatheredMatrix);
+  EXPECT_TRUE(matrix.samePattern(expected_matrix));
+  EXPECT_TRUE(VectorAlmostEqual(matrix.values(), expected_matrix.values(), matrix.nNonzeros(), 1.0e-12, 1.0e-12));
+  EXPECT_TRUE(VectorAlmostEqual(gatheredRHS, globalRHS, globalMesh.nCells(), 1.0e-12, 1.0e-12));
+}
+
+TEST(DistributedMeshTest, InteriorFirstOrderingPlacesInterfaceCellsLast)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh globalMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(globalMesh);
+  DecomposeMesh meshDecomposer;
+  meshDecomposer.nSubdomains() = 4;
+  meshDecomposer.method() = DecompositionMethod::multilevel;
+  Decomposition decomposition = meshDecomposer.decompose(globalMesh);
+
+  for (std::size_t iSubdomain = 0; iSubdomain < 4; ++iSubdomain) {
+    // --- Act ---
+    DistributedMesh referenceMesh(globalMesh, decomposition, iSubdomain);
+    DistributedMesh distributedMesh(globalMesh, decomposition, iSubdomain, LocalCellOrdering::interiorFirst);
+
+    // --- Assert ---
+    Mesh &localMesh = distributedMesh.localMesh();
+    const std::size_t nInteriorCells = distributedMesh.nInteriorCells();
+    const std::size_t nOwnedCells = distributedMesh.nOwnedCells();
+    EXPECT_EQ(nInteriorCells, referenceMesh.nInteriorCells());
+    EXPECT_LT(nInteriorCells, nOwnedCells);
+    for (std::size_t iLocal = 0; iLocal < localMesh.nCells(); ++iLocal) {
+      std::size_t nHaloNeighbors = 0;
+      for (const std::size_t iNeighbor : localMesh.cells()[iLocal].iNeighbors()) {
+        nHaloNeighbors += iNeighbor >= nOwnedCells ? 1 : 0;
+      }
+      if (iLocal < nInteriorCells) {
+        EXPECT_EQ(nHaloNeighbors, 0);
+      } else if (iLocal < nOwnedCells) {
+        EXPECT_GT(nHaloNeighbors, 0);
+      }
+    }
+
+    // Same owned rows in global indices as with the ascending numbering
+    gko::matrix_data<double, int> referenceMatrix;
+    gko::matrix_data<double, int> localMatrix;
+    std::vector<double> referenceRHS;
+    std::vector<double> localRHS;
+    assembleHeatConduction(referenceMesh.localMesh(), referenceMatrix, referenceRHS);
+    assembleHeatConduction(localMesh, localMatrix, localRHS);
+    const CsrMatrix<double, int> expected_matrix(referenceMesh.ownedRows<int>(referenceMatrix));
+    const CsrMatrix<double, int> matrix(distributedMesh.ownedRows<int>(localMatrix));
+    EXPECT_TRUE(matrix.samePattern(expected_matrix));
+    EXPECT_TRUE(VectorAlmostEqual(matrix.values(), expected_matrix.values(), matrix.nNonzeros(), 1.0e-12, 1.0e-12));
+    EXPECT_TRUE(VectorAlmostEqual(distributedMesh.ownedValues(localRHS), referenceMesh.ownedValues(referenceRHS),
+                                  nOwnedCells, 1.0e-12, 1.0e-12));
+  }
+}
+
+TEST(DistributedMeshTest, HaloExchangeListsMatchOnBothSides)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh globalMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(globalMesh);
+  DecomposeMesh meshDecomposer;
+  meshDecomposer.nSubdomains() = 4;
+  meshDecomposer.method() = DecompositionMethod::multilevel;
+  Decomposition decomposition = meshDecomposer.decompose(globalMesh);
+
+  // --- Act ---
+  std::vector<DistributedMesh> distributedMeshes;
+  for (std::size_t iSubdomain = 0; iSubdomain < 4; ++iSubdomain) {
+    distributedMeshes.emplace_back(globalMesh, decomposition, iSubdomain, LocalCellOrdering::interiorFirst);
+  }
+
+  // --- Assert ---
+  auto toGlobal = [](DistributedMesh &distributedMesh, const std::vector<std::size_t> &localCells) {
+    std::vector<std::size_t> globalCells;
+    for (const std::size_t iLocal : localCells) {
+      globalCells.push_back(distributedMesh.globalCells()[iLocal]);
+    }
+    return globalCells;
+  };
+  for (std::size_t iSubdomain = 0; iSubdomain < 4; ++iSubdomain) {
+    DistributedMesh &distributedMesh = distributedMeshes[iSubdomain];
+    std::size_t nReceived = 0;
+    for (auto &exchange : distributedMesh.haloExchanges()) {
+      nReceived += exchange.receiveCells.size();
+      for (const std::size_t iLocal : exchange.sendCells) {
+        EXPECT_GE(iLocal, distributedMesh.nInteriorCells());
+        EXPECT_LT(iLocal, distributedMesh.nOwnedCells());
+      }
+      bool matched = false;
+      for (auto &other : distributedMeshes[exchange.neighbor].haloExchanges()) {
+        if (other.neighbor != iSubdomain) {
+          continue;
+        }
+        matched = true;
+        const auto sent = toGlobal(distributedMesh, exchange.sendCells);
+        const auto received = toGlobal(distributedMeshes[exchange.neighbor], other.receiveCells);
+        ASSERT_EQ(sent.size(), received.size());
+        EXPECT_TRUE(VectorMatch(received, sent, sent.size()));
+      }
+      EXPECT_TRUE(matched);
+    }
+    EXPECT_EQ(nReceived, distributedMesh.localMesh().nCells() - distributedMesh.nOwnedCells());
+  }
+}
+
+TEST(DistributedMeshTest, GeneratedSlabsReproduceGlobalRows)
+{
+  // --- Arrange ---
+  const std::array<std::size_t, 3> nCells = {4, 3, 7};
+  const std::array<double, 3> lengths = {1.0, 1.0, 1.0};
+  Mesh globalMesh;
+  GenerateMesh meshGenerator;
+  meshGenerator.cartesianBox(globalMesh, nCells, lengths);
+  gko::matrix_data<double, int> globalMatrix;
+  std::vector<double> globalRHS;
+  assembleHeatConduction(globalMesh, globalMatrix, globalRHS);
+
+  // --- Act ---
+  // Layers [0, 2), [2, 5) and [5, 7), each generated with its halo layers
+  const std::size_t firstLayer[4] = {0, 2, 5, 7};
+  const std::size_t layerCells = nCells[0] * nCells[1];
+  gko::matrix_data<double, int> gatheredMatrix(gko::dim<2>(globalMesh.nCells(), globalMesh.nCells()));
+  std::vector<double> gatheredRHS;
+  std::vector<DistributedMesh> distributedMeshes;
+  for (std::size_t iSubdomain = 0; iSubdomain < 3; ++iSubdomain) {
+    const std::size_t haloBegin = iSubdomain > 0 ? firstLayer[iSubdomain] - 1 : 0;
+    const std::size_t haloEnd = std::min(firstLayer[iSubdomain + 1] + 1, nCells[2]);
+    Mesh localMesh;
+    meshGenerator.cartesianBoxLayers(localMesh, nCells, lengths, haloBegin, haloEnd);
+    std::vector<std::size_t> globalCells(localMesh.nCells());
+    std::vector<std::size_t> cellSubdomains(localMesh.nCells());
+    for (std::size_t iLocal = 0; iLocal < localMesh.nCells(); ++iLocal) {
+      globalCells[iLocal] = layerCells * haloBegin + iLocal;
+      const std::size_t k = haloBegin + iLocal / layerCells;
+      cellSubdomains[iLocal] = k < firstLayer[1] ? 0 : (k < firstLayer[2] ? 1 : 2);
+    }
+    distributedMeshes.emplace_back(std::move(localMesh), globalCells, cellSubdomains, iSubdomain, globalMesh.nCells());
+
+    gko::matrix_data<double, int> localMatrix;
+    std::vector<double> localRHS;
+    assembleHeatConduction(distributedMeshes.back().localMesh(), localMatrix, localRHS);
+    const auto ownedRows = distributedMeshes.back().ownedRows<int>(localMatrix);
+    gatheredMatrix.nonzeros.insert(gatheredMatrix.nonzeros.end(), ownedRows.nonzeros.begin(), ownedRows.nonzeros.end());
+    const auto ownedRHS = distributedMeshes.back().ownedValues(localRHS);
+    gatheredRHS.insert(gatheredRHS.end(), ownedRHS.begin(), ownedRHS.end());
+  }
+
+  // --- Assert ---
+  // The owned cells of the slabs are contiguous global ranges in order
+  ASSERT_EQ(gatheredRHS.size(), globalMesh.nCells());
+  const CsrMatrix<double, int> expected_matrix(globalMatrix);
+  const CsrMatrix<double, int> matrix(gatheredMatrix);
+  EXPECT_TRUE(matrix.samePattern(expected_matrix));
+  EXPECT_TRUE(VectorAlmostEqual(matrix.values(), expected_matrix.values(), matrix.nNonzeros(), 1.0e-12, 1.0e-12));
+  EXPECT_TRUE(VectorAlmostEqual(gatheredRHS, globalRHS, globalMesh.nCells(), 1.0e-12, 1.0e-12));
+
+  // The middle slab exchanges one layer with each neighbor
+  DistributedMesh &middle = distributedMeshes[1];
+  EXPECT_EQ(middle.nOwnedCells(), 3 * layerCells);
+  EXPECT_EQ(middle.nInteriorCells(), layerCells);
+  ASSERT_EQ(middle.haloExchanges().size(), 2);
+  for (auto &exchange : middle.haloExchanges()) {
+    EXPECT_EQ(exchange.sendCells.size(), layerCells);
+    EXPECT_EQ(exchange.receiveCells.size(), layerCells);
+  }
+  EXPECT_EQ(middle.haloExchanges()[0].neighbor, 0);
+  EXPECT_EQ(middle.globalCells()[middle.haloExchanges()[0].receiveCells[0]], layerCells * 1);
+  EXPECT_EQ(middle.globalCells()[middle.haloExchanges()[1].sendCells[0]], layerCells * 4);
+}
+
+TEST(DistributedMeshTest, ProcessorPiecesReproduceGlobalRows)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh globalMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(globalMesh);
+  gko::matrix_data<double, int> globalMatrix;
+  std::vector<double> globalRHS;
+  assembleHeatConduction(globalMesh, globalMatrix, globalRHS);
+  DecomposedMesh decomposedMesh(caseDirectory);
+  meshReader.readDecomposedOpenFoamMesh(decomposedMesh);
+
+  // Each piece read on its own, with its cells numbered after those of the
+  // preceding pieces
+  std::vector<Mesh> pieces(4);
+  std::vector<std::size_t> firstGlobalCell(5, 0);
+  for (std::size_t iProcessor = 0; iProcessor < 4; ++iProcessor) {
+    pieces[iProcessor].caseDir() = caseDirectory + "/processor" + std::to_string(iProcessor);
+    meshReader.readOpenFoamMesh(pieces[iProcessor]);
+    firstGlobalCell[iProcessor + 1] = firstGlobalCell[iProcessor] + pieces[iProcessor].nCells();
+  }
+
+  // The exchange over the processor patches: the k-th patch from p to q
+  // receives what q sends over its k-th patch to p
+  auto receivedCells = [&](std::size_t iProcessor) {
+    Mesh &piece = pieces[iProcessor];
+    std::vector<ProcessorPatchCells> patchCells(piece.nBoundaries());
+    std::vector<std::size_t> nPatchesTo(4, 0);
+    for (std::size_t iBoundary = 0; iBoundary < piece.nBoundaries(); ++iBoundary) {
+      const int neighbor = piece.boundaries()[iBoundary].neighborProcessor();
+      if (neighbor < 0) {
+        continue;
+      }
+      Mesh &other = pieces[neighbor];
+      std::size_t k = nPatchesTo[neighbor]++;
+      for (std::size_t jBoundary = 0; jBoundary < other.nBoundaries(); ++jBoundary) {
+        if (other.boundaries()[jBoundary].neighborProcessor() == static_cast<int>(iProcessor) && k-- == 0) {
+          patchCells[iBoundary] = DistributedMesh::processorPatchCells(other, jBoundary, firstGlobalCell[neighbor]);
+          break;
+        }
+      }
+    }
+    return patchCells;
+  };
+
+  // --- Act ---
+  gko::matrix_data<double, int> gatheredMatrix(gko::dim<2>(globalMesh.nCells(), globalMesh.nCells()));
+  std::vector<double> gatheredRHS(globalMesh.nCells(), 0.0);
+  for (std::size_t iProcessor = 0; iProcessor < 4; ++iProcessor) {
+    const auto patchCells = receivedCells(iProcessor);
+    DistributedMesh distributedMesh(Mesh(pieces[iProcessor]), firstGlobalCell[iProcessor], patchCells, iProcessor,
+                                    globalMesh.nCells());
+    gko::matrix_data<double, int> localMatrix;
+    std::vector<double> localRHS;
+    assembleHeatConduction(distributedMesh.localMesh(), localMatrix, localRHS);
+
+    // Back to the numbering of the undecomposed case
+    auto toCase = [&](std::size_t iGlobal) {
+      for (std::size_t jProcessor = 0; jProcessor < 4; ++jProcessor) {
+        if (iGlobal < firstGlobalCell[jProcessor + 1]) {
+          return static_cast<int>(decomposedMesh.cellAddressing()[jProcessor][iGlobal - firstGlobalCell[jProcessor]]);
+        }
+      }
+      return -1;
+    };
+    for (const auto &nonzero : distributedMesh.ownedRows<int>(localMatrix).nonzeros) {
+      gatheredMatrix.nonzeros.emplace_back(toCase(nonzero.row), toCase(nonzero.column), nonzero.value);
+    }
+    const auto ownedRHS = distributedMesh.ownedValues(localRHS);
+    for (std::size_t i = 0; i < ownedRHS.size(); ++i) {
+      gatheredRHS[toCase(firstGlobalCell[iProcessor] + i)] = ownedRHS[i];
+    }
+    EXPECT_EQ(distributedMesh.nOwnedCells(), pieces[iProcessor].nCells());
+  }
+
+  // --- Assert ---
+  const CsrMatrix<double, int> expected_matrix(globalMatrix);
+  const CsrMatrix<double, int> matrix(gatheredMatrix);
+  EXPECT_TRUE(matrix.samePattern(expected_matrix));
+  EXPECT_TRUE(VectorAlmostEqual(matrix.values(), expected_matrix.values(), matrix.nNonzeros(), 1.0e-10, 1.0e-10));
+  EXPECT_TRUE(VectorAlmostEqual(gatheredRHS, globalRHS, globalMesh.nCells(), 1.0e-10, 1.0e-10));
+}
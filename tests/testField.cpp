@@ -103,4 +103,29 @@ TEST(FieldTest, UseDefaultVectorVolField) {
       VectorMatch(cellVolField.values()[398], expected_cell_vector_field, 3));
   EXPECT_TRUE(
       VectorMatch(cellVolField.values()[399], expected_cell_vector_field, 3));
-}
\ No newline at end of file
+}
+TEST(FieldTest, UniformFieldIsExpandedOnFirstWrite) {
+
+  // --- Arrange ---
+  Field<double> cellScalarField(1000);
+
+  // --- Act ---
+  cellScalarField.set(2.0);
+  const bool uniformAfterSet = cellScalarField.isUniform();
+  const double valueBeforeWrite = cellScalarField.value(10);
+  cellScalarField.values()[10] = 3.0;
+
+  // --- Assert ---
+  EXPECT_TRUE(uniformAfterSet);
+  EXPECT_EQ(valueBeforeWrite, 2.0);
+  EXPECT_FALSE(cellScalarField.isUniform());
+  EXPECT_EQ(cellScalarField.size(), 1000);
+  EXPECT_EQ(cellScalarField.value(9), 2.0);
+  EXPECT_EQ(cellScalarField.value(10), 3.0);
+
+  // Setting a value again drops the per-element storage
+  cellScalarField.set(1.0);
+  EXPECT_TRUE(cellScalarField.isUniform());
+  EXPECT_EQ(cellScalarField.size(), 1000);
+  EXPECT_EQ(cellScalarField.value(10), 1.0);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include "AssembleDiffusionTerm.hpp"
+#include "CsrMatrix.hpp"
+#include "Field.hpp"
+#include "IncompleteFactorization.hpp"
+#include "LevelSchedule.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include "utilitiesForTesting.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+// ****** Helpers ******
+gko::matrix_data<double, int> tridiagonal(const int n)
+{
+  gko::matrix_data<double, int> data;
+  data.size = {static_cast<std::size_t>(n), static_cast<std::size_t>(n)};
+  for (int row = 0; row < n; ++row) {
+    data.nonzeros.emplace_back(row, row, 2.5);
+    if (row > 0) {
+      data.nonzeros.emplace_back(row, row - 1, -1.0);
+    }
+    if (row < n - 1) {
+      data.nonzeros.emplace_back(row, row + 1, -1.0);
+    }
+  }
+  return data;
+}
+
+// ****** Tests ******
+TEST(LevelScheduleTest, TridiagonalMatrixIsFullySequential)
+{
+  // --- Arrange ---
+  const CsrMatrix<double, int> matrix(tridiagonal(5));
+
+  // --- Act ---
+  const LevelSchedule schedule(matrix);
+
+  // --- Assert ---
+  EXPECT_EQ(schedule.nLevels(), 5);
+  EXPECT_EQ(schedule.nRows(), 5);
+  EXPECT_TRUE(schedule.matches(matrix));
+}
+
+TEST(LevelScheduleTest, GridLevelsAreAntiDiagonals)
+{
+  // --- Arrange ---
+  const int n = 4;
+  const CsrMatrix<double, int> matrix(laplacianMatrix(n));
+
+  const std::vector<std::size_t> expected_levelPtrs = {
+      0, 1, 3, 6, 10, 13, 15, 16};
+  const std::vector<std::size_t> expected_level3_rows = {3, 6, 9, 12};
+
+  // --- Act ---
+  const LevelSchedule schedule(matrix);
+
+  // --- Assert ---
+  EXPECT_EQ(schedule.nLevels(), 2 * n - 1);
+  EXPECT_TRUE(VectorMatch(schedule.levelPtrs(), expected_levelPtrs,
+                          expected_levelPtrs.size()));
+  EXPECT_TRUE(VectorMatch(schedule.rows().begin() + 6, expected_level3_rows,
+                          expected_level3_rows.size()));
+}
+
+TEST(IncompleteFactorizationTest, Ilu0IsExactForTridiagonalMatrix)
+{
+  // --- Arrange ---
+  const CsrMatrix<double, int> matrix(tridiagonal(6));
+  auto schedule = std::make_shared<const LevelSchedule>(matrix);
+  const std::vector<double> expected_solution = {1.0, -2.0, 3.0, 0.5, 4.0, -1.0};
+  std::vector<double> RHS(6);
+  std::vector<double> solution(6);
+  matrix.apply(expected_solution.data(), RHS.data());
+
+  // --- Act ---
+  IncompleteFactorization<double, int> factorization(
+      matrix, schedule, FactorizationType::ilu0);
+  factorization.apply(RHS.data(), solution.data());
+
+  // --- Assert ---
+  EXPECT_TRUE(VectorAlmostEqual(solution, expected_solution, 6, 1.0e-12, 1.0e-10));
+}
+
+TEST(IncompleteFactorizationTest, Ic0IsExactForTridiagonalMatrix)
+{
+  // --- Arrange ---
+  const CsrMatrix<double, int> matrix(tridiagonal(6));
+  auto schedule = std::make_shared<const LevelSchedule>(matrix);
+  const std::vector<double> expected_solution = {1.0, -2.0, 3.0, 0.5, 4.0, -1.0};
+  std::vector<double> RHS(6);
+  std::vector<double> solution(6);
+  matrix.apply(expected_solution.data(), RHS.data());
+
+  // --- Act ---
+  IncompleteFactorization<double, int> factorization(
+      matrix, schedule, FactorizationType::ic0);
+  factorization.apply(RHS.data(), solution.data());
+
+  // --- Assert ---
+  EXPECT_TRUE(VectorAlmostEqual(solution, expected_solution, 6, 1.0e-12, 1.0e-10));
+}
+
+TEST(IncompleteFactorizationTest, Ic0AndIlu0AgreeOnDiffusionMatrix)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/cavity");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  // Dirichlet conditions on all patches keep the matrix positive definite
+  std::vector<boundaryField<double>> boundaryFields(fvMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    boundaryFields[iBoundary].setBoundaryType("fixedValue");
+    boundaryFields[iBoundary].values().resize(fvMesh.boundaries()[iBoundary].nFaces());
+  }
+  const std::vector<double> diffusionCoef(fvMesh.nFaces(), 1.0);
+  const std::vector<double> source(fvMesh.nCells(), 0.0);
+  std::vector<double> RHS(fvMesh.nCells(), 0.0);
+  gko::matrix_data<double, int> coeffMatrix;
+  AssembleDiffusionTerm diffusionTermAssembler;
+  diffusionTermAssembler.faceBasedAssemble(
+      fvMesh, diffusionCoef, source, boundaryFields, coeffMatrix, RHS);
+
+  const CsrMatrix<double, int> matrix(coeffMatrix);
+  auto schedule = std::make_shared<const LevelSchedule>(matrix);
+  std::vector<double> residual(fvMesh.nCells());
+  for (std::size_t i = 0; i < residual.size(); ++i) {
+    residual[i] = 1.0 + 0.01 * static_cast<double>(i);
+  }
+  std::vector<double> iluResult(fvMesh.nCells());
+  std::vector<double> icResult(fvMesh.nCells());
+
+  // --- Act ---
+  IncompleteFactorization<double, int> ilu(matrix, schedule, FactorizationType::ilu0);
+  IncompleteFactorization<double, int> ic(matrix, schedule, FactorizationType::ic0);
+  ilu.apply(residual.data(), iluResult.data());
+  ic.apply(residual.data(), icResult.data());
+
+  // --- Assert ---
+  // The 20x20 cavity mesh has 39 anti-diagonal level sets
+  EXPECT_EQ(schedule->nLevels(), 39);
+  EXPECT_TRUE(VectorAlmostEqual(icResult, iluResult, fvMesh.nCells(), 1.0e-12, 1.0e-10));
+}
+
+TEST(IncompleteFactorizationTest, RejectsMismatchedSchedule)
+{
+  // --- Arrange ---
+  const CsrMatrix<double, int> matrix(laplacianMatrix(3));
+  auto schedule = std::make_shared<const LevelSchedule>(
+      CsrMatrix<double, int>(tridiagonal(9)));
+
+  // --- Act & Assert ---
+  EXPECT_THROW(
+      (IncompleteFactorization<double, int>(matrix, schedule, FactorizationType::ilu0)),
+      std::invalid_argument);
+}
@@ -120,4 +120,40 @@ TEST(LinearSolverTest, Solve4x4Matrix) {
     EXPECT_TRUE(
         ScalarAlmostEqual(solution[i], expectedSolution[i], absTol, relTol));
   }
-}
\ No newline at end of file
+}
+TEST(LinearSolverTest, Solve4x4MatrixWithIc0Preconditioner) {
+  // --- Arrange ---
+  // Same 4x4 linear system as above, preconditioned with IC(0)
+  using ValueType = double;
+  using IndexType = int;
+  using RealValueType = gko::remove_complex<ValueType>;
+
+  gko::matrix_data<ValueType, IndexType> coeffMatrix;
+  coeffMatrix.size = {4, 4};
+  coeffMatrix.nonzeros = {
+      {0, 0, 4.0},  {0, 1, -1.0},               // Row 0
+      {1, 0, -1.0}, {1, 1, 4.0},  {1, 2, -1.0}, // Row 1
+      {2, 1, -1.0}, {2, 2, 4.0},  {2, 3, -1.0}, // Row 2
+      {3, 2, -1.0}, {3, 3, 3.0}                 // Row 3
+  };
+
+  std::vector<ValueType> RHS = {8.0, 3.5, 3.5, 5.5}; // Right-hand side   vector
+  std::vector<ValueType> expectedSolution = {2.5, 2.0, 2.0,
+                                             2.5}; // Expected solution
+  std::vector<ValueType> solution(4, 0.0); // Solution vector initialized to 0
+
+  const ValueType absTol = 1.0e-12;
+  const ValueType relTol = 1.0e-8;
+  const RealValueType reduction_factor{1e-7};
+  const IndexType maxNumIterations = 1000;
+
+  // --- Act ---
+  LinearSolver solver(PreconditionerType::ic0);
+  solver.solve(coeffMatrix, RHS, solution, reduction_factor, maxNumIterations);
+
+  // --- Assert ---
+  for (std::size_t i = 0; i < solution.size(); ++i) {
+    EXPECT_TRUE(
+        ScalarAlmostEqual(solution[i], expectedSolution[i], absTol, relTol));
+  }
+}
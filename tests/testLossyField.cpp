@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include "LossyField.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ****** Helpers ******
+namespace {
+
+// A smooth, slowly changing temperature with some noise, like the
+// snapshots of a transient run
+std::vector<double> temperatureAt(std::size_t iTime, std::size_t nCells)
+{
+  std::vector<double> temperature(nCells);
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    const double x = 1.0e-3 * static_cast<double>(iElement);
+    temperature[iElement] =
+        300.0 + 20.0 * std::sin(3.0 * x + 0.05 * iTime) * std::exp(-x) +
+        1.0e-4 * std::sin(1.0e3 * x * x);
+  }
+  return temperature;
+}
+
+std::string temporaryCase(const std::string &name)
+{
+  const std::filesystem::path caseDirectory =
+      std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(caseDirectory);
+  return caseDirectory.string();
+}
+
+} // namespace
+
+// ****** Tests ******
+TEST(LossyFieldTest, ErrorBoundHoldsForEverySnapshot)
+{
+  // --- Arrange ---
+  const std::string caseDirectory = temporaryCase("testLossyField");
+  const std::size_t nCells = 20000;
+  const std::size_t nTimes = 25;
+  const double errorBound = 1.0e-3;
+  WriteLossyField fieldWriter(caseDirectory, errorBound, 10);
+  std::size_t nBytes = 0;
+
+  // --- Act ---
+  for (std::size_t iTime = 0; iTime < nTimes; ++iTime) {
+    fieldWriter.write(temperatureAt(iTime, nCells), std::to_string(iTime),
+                      "T");
+    nBytes += fieldWriter.bytesWritten();
+  }
+
+  // --- Assert ---
+  ReadLossyField fieldReader(caseDirectory);
+  for (std::size_t iTime = 0; iTime < nTimes; ++iTime) {
+    const std::vector<double> exact = temperatureAt(iTime, nCells);
+    const std::vector<double> decoded =
+        fieldReader.read<double>(std::to_string(iTime), "T");
+    ASSERT_EQ(decoded.size(), nCells);
+    double maxError = 0.0;
+    for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+      maxError = std::max(maxError, std::abs(decoded[iElement] - exact[iElement]));
+    }
+    EXPECT_LE(maxError, errorBound) << "at time " << iTime;
+  }
+
+  // At least 10x smaller than the raw doubles
+  EXPECT_LT(nBytes, nTimes * nCells * sizeof(double) / 10);
+
+  std::filesystem::remove_all(caseDirectory);
+}
+
+TEST(LossyFieldTest, AnySnapshotDecodesOnItsOwn)
+{
+  // --- Arrange ---
+  const std::string caseDirectory = temporaryCase("testLossyFieldRandom");
+  const std::size_t nCells = 1000;
+  WriteLossyField fieldWriter(caseDirectory, 1.0e-6, 4);
+  for (std::size_t iTime = 0; iTime < 10; ++iTime) {
+    fieldWriter.write(temperatureAt(iTime, nCells), std::to_string(iTime),
+                      "T");
+  }
+
+  // --- Act ---
+  // A fresh reader for the snapshot between two keyframes, and one that
+  // goes through all snapshots in order
+  ReadLossyField randomReader(caseDirectory);
+  const std::vector<double> randomAccess = randomReader.read<double>("6", "T");
+  ReadLossyField sequentialReader(caseDirectory);
+  std::vector<double> sequential;
+  for (std::size_t iTime = 0; iTime <= 6; ++iTime) {
+    sequential = sequentialReader.read<double>(std::to_string(iTime), "T");
+  }
+
+  // --- Assert ---
+  EXPECT_EQ(randomAccess, sequential);
+  const std::vector<double> exact = temperatureAt(6, nCells);
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    EXPECT_NEAR(randomAccess[iElement], exact[iElement], 1.0e-6);
+  }
+
+  std::filesystem::remove_all(caseDirectory);
+}
+
+TEST(LossyFieldTest, VectorsAndUnquantizableValues)
+{
+  // --- Arrange ---
+  const std::string caseDirectory = temporaryCase("testLossyFieldVector");
+  const double errorBound = 1.0e-5;
+  std::vector<std::array<double, 3>> velocity(100);
+  for (std::size_t iElement = 0; iElement < velocity.size(); ++iElement) {
+    velocity[iElement] = {std::sin(0.1 * iElement), -1.0 / (iElement + 1.0),
+                          0.0};
+  }
+  velocity[10][2] = std::numeric_limits<double>::quiet_NaN();
+  velocity[20][0] = 1.0e300;
+  velocity[21][0] = -1.0e300;
+  WriteLossyField fieldWriter(caseDirectory, errorBound);
+
+  // --- Act ---
+  fieldWriter.write(velocity, "1", "U");
+  velocity[10][2] = 0.5; // Predicted from a NaN
+  velocity[30][1] = std::numeric_limits<double>::infinity();
+  fieldWriter.write(velocity, "2", "U");
+  ReadLossyField fieldReader(caseDirectory);
+  const std::vector<std::array<double, 3>> decoded =
+      fieldReader.read<std::array<double, 3>>("2", "U");
+
+  // --- Assert ---
+  ASSERT_EQ(decoded.size(), velocity.size());
+  for (std::size_t iElement = 0; iElement < velocity.size(); ++iElement) {
+    for (std::size_t i = 0; i < 3; ++i) {
+      if (std::isfinite(velocity[iElement][i])) {
+        EXPECT_NEAR(decoded[iElement][i], velocity[iElement][i], errorBound);
+      } else {
+        EXPECT_EQ(decoded[iElement][i], velocity[iElement][i]);
+      }
+    }
+  }
+  EXPECT_EQ(decoded[20][0], 1.0e300);
+  EXPECT_EQ(decoded[21][0], -1.0e300);
+  EXPECT_THROW(fieldReader.read<double>("2", "U"), std::runtime_error);
+  EXPECT_THROW(WriteLossyField(caseDirectory, 0.0), std::runtime_error);
+
+  std::filesystem::remove_all(caseDirectory);
+}
+
+TEST(LossyFieldTest, RewrittenTimeAndReferenceCycles)
+{
+  // --- Arrange ---
+  const std::string caseDirectory = temporaryCase("testLossyFieldRewrite");
+  const std::string otherCaseDirectory =
+      temporaryCase("testLossyFieldRewriteOther");
+  const std::size_t nCells = 100;
+  const double errorBound = 1.0e-4;
+  WriteLossyField fieldWriter(caseDirectory, errorBound);
+  fieldWriter.write(temperatureAt(0, nCells), "1", "T");
+  fieldWriter.write(temperatureAt(1, nCells), "2", "T");
+
+  // --- Act ---
+  // The last time step written again, and the next one after it
+  fieldWriter.write(temperatureAt(2, nCells), "2", "T");
+  fieldWriter.write(temperatureAt(3, nCells), "3", "T");
+  ReadLossyField fieldReader(caseDirectory);
+  const std::vector<double> rewritten = fieldReader.read<double>("2", "T");
+  const std::vector<double> next = fieldReader.read<double>("3", "T");
+
+  // --- Assert ---
+  const std::vector<double> expectedRewritten = temperatureAt(2, nCells);
+  const std::vector<double> expectedNext = temperatureAt(3, nCells);
+  ASSERT_EQ(rewritten.size(), nCells);
+  ASSERT_EQ(next.size(), nCells);
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    EXPECT_NEAR(rewritten[iElement], expectedRewritten[iElement], errorBound);
+    EXPECT_NEAR(next[iElement], expectedNext[iElement], errorBound);
+  }
+
+  // Snapshot 2 references 1; a snapshot 1 that references 2 closes a cycle
+  WriteLossyField otherFieldWriter(otherCaseDirectory, errorBound);
+  otherFieldWriter.write(temperatureAt(0, nCells), "2", "T");
+  otherFieldWriter.write(temperatureAt(1, nCells), "1", "T");
+  WriteLossyField cycleFieldWriter(caseDirectory, errorBound);
+  cycleFieldWriter.write(temperatureAt(0, nCells), "1", "T");
+  cycleFieldWriter.write(temperatureAt(1, nCells), "2", "T");
+  std::filesystem::copy_file(
+      otherCaseDirectory + "/1/T.lossy", caseDirectory + "/1/T.lossy",
+      std::filesystem::copy_options::overwrite_existing);
+  ReadLossyField cycleFieldReader(caseDirectory);
+  EXPECT_THROW(cycleFieldReader.read<double>("2", "T"), std::runtime_error);
+
+  std::filesystem::remove_all(caseDirectory);
+  std::filesystem::remove_all(otherCaseDirectory);
+}
+
+TEST(LossyFieldTest, RewrittenReferenceIsDetected)
+{
+  // --- Arrange ---
+  const std::string caseDirectory = temporaryCase("testLossyFieldStale");
+  const std::size_t nCells = 100;
+  const double errorBound = 1.0e-4;
+  WriteLossyField fieldWriter(caseDirectory, errorBound);
+
+  // --- Act ---
+  // Snapshot 2 references the first values of 1, which are then replaced
+  fieldWriter.write(temperatureAt(0, nCells), "1", "T");
+  fieldWriter.write(temperatureAt(1, nCells), "2", "T");
+  fieldWriter.write(temperatureAt(5, nCells), "1", "T");
+  fieldWriter.write(temperatureAt(6, nCells), "3", "T");
+  ReadLossyField fieldReader(caseDirectory);
+  const std::vector<double> rewritten = fieldReader.read<double>("1", "T");
+  const std::vector<double> next = fieldReader.read<double>("3", "T");
+
+  // --- Assert ---
+  const std::vector<double> expectedRewritten = temperatureAt(5, nCells);
+  const std::vector<double> expectedNext = temperatureAt(6, nCells);
+  ASSERT_EQ(rewritten.size(), nCells);
+  ASSERT_EQ(next.size(), nCells);
+  for (std::size_t iElement = 0; iElement < nCells; ++iElement) {
+    EXPECT_NEAR(rewritten[iElement], expectedRewritten[iElement], errorBound);
+    EXPECT_NEAR(next[iElement], expectedNext[iElement], errorBound);
+  }
+  EXPECT_THROW(fieldReader.read<double>("2", "T"), std::runtime_error);
+  ReadLossyField freshReader(caseDirectory);
+  EXPECT_THROW(freshReader.read<double>("2", "T"), std::runtime_error);
+
+  std::filesystem::remove_all(caseDirectory);
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include "GenerateMesh.hpp"
+#include "Mesh.hpp"
+#include "ProcessMesh.hpp"
+#include "ReadMesh.hpp"
+#include "utilitiesForTesting.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Stretch the interior of a box along each axis; the boundary stays in place
+// and every face stays planar
+std::vector<std::array<double, 3>>
+stretchInterior(Mesh &fvMesh, const std::array<double, 3> &lengths,
+                double amplitude) {
+  std::vector<std::array<double, 3>> displacementField(fvMesh.nNodes());
+  for (std::size_t iNode = 0; iNode < fvMesh.nNodes(); ++iNode) {
+    const std::array<double, 3> &x = fvMesh.nodes()[iNode].centroid();
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      const double l = lengths[iCoordinate];
+      displacementField[iNode][iCoordinate] =
+          amplitude * x[iCoordinate] * (l - x[iCoordinate]) / l;
+    }
+  }
+  return displacementField;
+}
+
+// Sum of the outward swept volumes of the faces of a cell
+double cellSweptVolume(Mesh &fvMesh, std::size_t iElement) {
+  Cell &theCell = fvMesh.cells()[iElement];
+  double sweptVolume = 0.0;
+  for (std::size_t i = 0; i < theCell.iFaces().size(); ++i) {
+    sweptVolume += theCell.faceSigns()[i] *
+                   fvMesh.faces()[theCell.iFaces()[i]].sweptVolume();
+  }
+  return sweptVolume;
+}
+
+} // namespace
+
+// ****** Tests ******
+TEST(MeshMotionTest, IncrementalUpdateMatchesFullProcessing) {
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  ProcessMesh meshProcessor;
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  std::vector<std::size_t> movedNodes;
+  std::vector<std::array<double, 3>> displacements;
+  for (std::size_t iNode = 0; iNode < fvMesh.nNodes(); iNode += 7) {
+    movedNodes.push_back(iNode);
+    displacements.push_back({0.01 * std::sin(1.0 * iNode),
+                             0.01 * std::cos(1.0 * iNode),
+                             0.001 * std::sin(0.5 * iNode)});
+  }
+
+  Mesh reference = fvMesh;
+  for (std::size_t i = 0; i < movedNodes.size(); ++i) {
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      reference.nodes()[movedNodes[i]].centroid()[iCoordinate] +=
+          displacements[i][iCoordinate];
+    }
+  }
+
+  const double absTol = 1.0e-12;
+  const double relTol = 1.0e-10;
+
+  // --- Act ---
+  meshProcessor.moveNodes(fvMesh, movedNodes, displacements);
+  meshProcessor.processOpenFoamMesh(reference);
+
+  // --- Assert ---
+  EXPECT_LT(fvMesh.movedCells().size(), fvMesh.nCells());
+  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+    Face &theFace = fvMesh.faces()[iFace];
+    Face &expected = reference.faces()[iFace];
+    EXPECT_TRUE(VectorAlmostEqual(theFace.centroid(), expected.centroid(), 3,
+                                  absTol, relTol));
+    EXPECT_TRUE(
+        VectorAlmostEqual(theFace.Sf(), expected.Sf(), 3, absTol, relTol));
+    EXPECT_TRUE(
+        VectorAlmostEqual(theFace.T(), expected.T(), 3, absTol, relTol));
+    EXPECT_TRUE(AlmostEqualAbsAndRelative(theFace.gDiff(), expected.gDiff(),
+                                          absTol, relTol));
+    EXPECT_TRUE(AlmostEqualAbsAndRelative(theFace.gf(), expected.gf(), absTol,
+                                          relTol));
+  }
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
+       ++iBoundary) {
+    Boundary &boundary = fvMesh.boundaries()[iBoundary];
+    Boundary &expected = reference.boundaries()[iBoundary];
+    EXPECT_TRUE(VectorAlmostEqual(boundary.gDiff(), expected.gDiff(),
+                                  boundary.nFaces(), absTol, relTol));
+    EXPECT_TRUE(VectorAlmostEqual(boundary.area(), expected.area(),
+                                  boundary.nFaces(), absTol, relTol));
+  }
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    Cell &theCell = fvMesh.cells()[iElement];
+    Cell &expected = reference.cells()[iElement];
+    EXPECT_TRUE(AlmostEqualAbsAndRelative(theCell.volume(), expected.volume(),
+                                          absTol, relTol));
+    EXPECT_TRUE(VectorAlmostEqual(theCell.centroid(), expected.centroid(), 3,
+                                  absTol, relTol));
+  }
+}
+
+TEST(MeshMotionTest, SweptVolumesSumToVolumeChange) {
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+  ProcessMesh meshProcessor;
+  const std::array<double, 3> lengths = {1.0, 2.0, 0.5};
+  meshGenerator.cartesianBox(fvMesh, {6, 5, 4}, lengths);
+  const std::vector<std::array<double, 3>> displacementField =
+      stretchInterior(fvMesh, lengths, 0.2);
+
+  const double absTol = 1.0e-14;
+
+  // --- Act ---
+  meshProcessor.moveNodes(fvMesh, displacementField);
+
+  // --- Assert ---
+  EXPECT_FALSE(fvMesh.movedCells().empty());
+  double totalChange = 0.0;
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    Cell &theCell = fvMesh.cells()[iElement];
+    const double change = theCell.volume() - theCell.oldVolume();
+    EXPECT_NEAR(cellSweptVolume(fvMesh, iElement), change, absTol);
+    totalChange += change;
+  }
+  // The boundary does not move, so the total volume is conserved
+  EXPECT_NEAR(totalChange, 0.0, absTol);
+  for (std::size_t iFace = fvMesh.nInteriorFaces(); iFace < fvMesh.nFaces();
+       ++iFace) {
+    EXPECT_EQ(fvMesh.faces()[iFace].sweptVolume(), 0.0);
+  }
+}
+
+TEST(MeshMotionTest, SecondMotionStartsFromPreviousGeometry) {
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+  ProcessMesh meshProcessor;
+  const std::array<double, 3> lengths = {1.0, 1.0, 1.0};
+  meshGenerator.cartesianBox(fvMesh, {4, 4, 4}, lengths);
+  std::vector<double> initialVolumes;
+  for (auto &theCell : fvMesh.cells()) {
+    initialVolumes.push_back(theCell.volume());
+  }
+  std::vector<std::array<double, 3>> displacementField =
+      stretchInterior(fvMesh, lengths, 0.3);
+
+  const double absTol = 1.0e-14;
+
+  // --- Act ---
+  meshProcessor.moveNodes(fvMesh, displacementField);
+  std::vector<double> stretchedVolumes;
+  for (auto &theCell : fvMesh.cells()) {
+    stretchedVolumes.push_back(theCell.volume());
+  }
+  for (auto &d : displacementField) {
+    d = {-d[0], -d[1], -d[2]};
+  }
+  meshProcessor.moveNodes(fvMesh, displacementField);
+
+  // --- Assert ---
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    Cell &theCell = fvMesh.cells()[iElement];
+    EXPECT_EQ(theCell.oldVolume(), stretchedVolumes[iElement]);
+    EXPECT_NEAR(theCell.volume(), initialVolumes[iElement], absTol);
+    EXPECT_NEAR(cellSweptVolume(fvMesh, iElement),
+                theCell.volume() - theCell.oldVolume(), absTol);
+  }
+}
+
+TEST(MeshMotionTest, NodeMovedTwiceIsRejected) {
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+  ProcessMesh meshProcessor;
+  meshGenerator.cartesianBox(fvMesh, {2, 2, 2}, {1.0, 1.0, 1.0});
+  Mesh reference = fvMesh;
+  const std::vector<std::size_t> movedNodes = {13, 4, 13};
+  const std::vector<std::array<double, 3>> displacements = {
+      {0.1, 0.0, 0.0}, {0.0, 0.1, 0.0}, {0.1, 0.0, 0.0}};
+
+  // --- Act & Assert ---
+  EXPECT_THROW(meshProcessor.moveNodes(fvMesh, movedNodes, displacements),
+               std::invalid_argument);
+  for (std::size_t iNode = 0; iNode < fvMesh.nNodes(); ++iNode) {
+    EXPECT_EQ(fvMesh.nodes()[iNode].centroid(),
+              reference.nodes()[iNode].centroid());
+  }
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    EXPECT_EQ(fvMesh.cells()[iElement].volume(),
+              reference.cells()[iElement].volume());
+  }
+}
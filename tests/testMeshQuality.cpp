@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "GenerateMesh.hpp"
+#include "Mesh.hpp"
+#include "MeshQuality.hpp"
+#include "ReadMesh.hpp"
+#include <cstddef>
+#include <numeric>
+#include <sstream>
+#include <string>
+
+// ****** Tests ******
+TEST(MeshQualityTest, CartesianBoxIsOrthogonalAndUnskewed) {
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+  MeshQuality meshQuality;
+  meshGenerator.cartesianBox(fvMesh, {4, 3, 2}, {4.0, 1.5, 4.0});
+
+  const double absTol = 1.0e-12;
+
+  // --- Act ---
+  const MeshQualityReport report = meshQuality.check(fvMesh);
+
+  // --- Assert ---
+  // Cells of 1 x 0.5 x 2
+  EXPECT_NEAR(report.nonOrthogonality.max, 0.0, 1.0e-6);
+  EXPECT_NEAR(report.skewness.max, 0.0, absTol);
+  EXPECT_NEAR(report.aspectRatio.min, 4.0, absTol);
+  EXPECT_NEAR(report.aspectRatio.max, 4.0, absTol);
+  EXPECT_EQ(report.nSevereNonOrthogonalFaces, 0);
+  EXPECT_EQ(report.nonOrthogonality.counts[0], fvMesh.nInteriorFaces());
+  EXPECT_EQ(report.aspectRatio.counts[1], fvMesh.nCells());
+}
+
+TEST(MeshQualityTest, HistogramsCoverAllFacesAndCells) {
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  MeshQuality meshQuality;
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  // --- Act ---
+  const MeshQualityReport report = meshQuality.check(fvMesh);
+
+  // --- Assert ---
+  const auto total = [](const QualityDistribution &d) {
+    return std::accumulate(d.counts.begin(), d.counts.end(), std::size_t{0});
+  };
+  EXPECT_EQ(total(report.nonOrthogonality), fvMesh.nInteriorFaces());
+  EXPECT_EQ(total(report.skewness), fvMesh.nInteriorFaces());
+  EXPECT_EQ(total(report.aspectRatio), fvMesh.nCells());
+
+  // The triangulated elbow is not orthogonal
+  EXPECT_GT(report.nonOrthogonality.max, 0.0);
+  EXPECT_GT(report.skewness.max, 0.0);
+  EXPECT_LE(report.nonOrthogonality.min, report.nonOrthogonality.mean);
+  EXPECT_LE(report.nonOrthogonality.mean, report.nonOrthogonality.max);
+  EXPECT_LT(report.nonOrthogonality.iMax, fvMesh.nInteriorFaces());
+  EXPECT_LT(report.aspectRatio.iMax, fvMesh.nCells());
+  EXPECT_GE(report.aspectRatio.min, 1.0);
+
+  std::ostringstream summary;
+  meshQuality.writeSummary(report, summary);
+  EXPECT_NE(summary.str().find("Non-orthogonality"), std::string::npos);
+}
@@ -1,11 +1,147 @@
 #include <gtest/gtest.h>
 
 #include "Mesh.hpp"
+#include "ProcessMesh.hpp"
 #include "ReadMesh.hpp"
 #include "arrayOperations.hpp"
 #include "utilitiesForTesting.hpp"
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <numeric>
 #include <string>
+#include <utility>
+#include <vector>
+
+// ****** Helpers ******
+namespace {
+
+// One layer of cells extruded from a strip of quadrilaterals, pairs of
+// triangles and pentagons, so that the mesh has faces with 3, 4 and 5
+// nodes. The nodes are lifted unevenly, so most faces are not planar.
+Mesh mixedFaceMesh(std::size_t nUnits) {
+  // Nodes of the strip: the bottom row, the top row and the tips of the
+  // pentagons
+  std::vector<std::array<double, 2>> points;
+  for (std::size_t i = 0; i <= nUnits; ++i) {
+    points.push_back({static_cast<double>(i), 0.0});
+  }
+  for (std::size_t i = 0; i <= nUnits; ++i) {
+    points.push_back({static_cast<double>(i), 1.0});
+  }
+  auto bottom = [](std::size_t i) { return i; };
+  auto top = [nUnits](std::size_t i) { return nUnits + 1 + i; };
+
+  // Cells of the strip as counterclockwise node loops
+  std::vector<std::vector<std::size_t>> loops;
+  for (std::size_t i = 0; i < nUnits; ++i) {
+    if (i % 3 == 0) {
+      loops.push_back({bottom(i), bottom(i + 1), top(i + 1), top(i)});
+    } else if (i % 3 == 1) {
+      loops.push_back({bottom(i), bottom(i + 1), top(i + 1)});
+      loops.push_back({bottom(i), top(i + 1), top(i)});
+    } else {
+      points.push_back({i + 0.5, 1.3});
+      loops.push_back(
+          {bottom(i), bottom(i + 1), top(i + 1), points.size() - 1, top(i)});
+    }
+  }
+
+  Mesh fvMesh;
+  const std::size_t nPoints = points.size();
+  fvMesh.nNodes() = 2 * nPoints;
+  fvMesh.nodes().assign(fvMesh.nNodes(), Node());
+  for (std::size_t iNode = 0; iNode < fvMesh.nNodes(); ++iNode) {
+    const std::array<double, 2> &point = points[iNode % nPoints];
+    const double z = iNode < nPoints ? 0.1 * std::sin(1.0 * iNode)
+                                     : 1.0 + 0.2 * std::sin(3.0 * iNode);
+    fvMesh.nodes()[iNode].centroid() = {point[0], point[1], z};
+    fvMesh.nodes()[iNode].index() = iNode;
+  }
+
+  auto makeFace = [](std::vector<std::size_t> iNodes, int iOwner,
+                     int iNeighbor) {
+    Face theFace;
+    theFace.nNodes() = iNodes.size();
+    theFace.iNodes() = std::move(iNodes);
+    theFace.iOwner() = iOwner;
+    theFace.iNeighbor() = iNeighbor;
+    return theFace;
+  };
+
+  // Side faces: an edge shared by two cells is an interior face of the
+  // first one, the other edges are boundary faces
+  std::vector<Face> faces;
+  std::map<std::pair<std::size_t, std::size_t>,
+           std::pair<int, std::vector<std::size_t>>>
+      openEdges;
+  for (std::size_t iElement = 0; iElement < loops.size(); ++iElement) {
+    const std::vector<std::size_t> &loop = loops[iElement];
+    for (std::size_t k = 0; k < loop.size(); ++k) {
+      const std::size_t a = loop[k];
+      const std::size_t b = loop[(k + 1) % loop.size()];
+      const std::pair<std::size_t, std::size_t> edge = std::minmax(a, b);
+      const auto found = openEdges.find(edge);
+      if (found == openEdges.end()) {
+        openEdges.emplace(
+            edge, std::make_pair(static_cast<int>(iElement),
+                                 std::vector<std::size_t>{
+                                     a, b, b + nPoints, a + nPoints}));
+      } else {
+        faces.push_back(makeFace(found->second.second, found->second.first,
+                                 static_cast<int>(iElement)));
+        openEdges.erase(found);
+      }
+    }
+  }
+  std::sort(faces.begin(), faces.end(), [](Face &a, Face &b) {
+    return std::make_pair(a.iOwner(), a.iNeighbor()) <
+           std::make_pair(b.iOwner(), b.iNeighbor());
+  });
+  fvMesh.nInteriorFaces() = faces.size();
+
+  for (auto &entry : openEdges) {
+    faces.push_back(makeFace(entry.second.second, entry.second.first, -1));
+  }
+  for (std::size_t iElement = 0; iElement < loops.size(); ++iElement) {
+    std::vector<std::size_t> bottomFace(loops[iElement].rbegin(),
+                                        loops[iElement].rend());
+    std::vector<std::size_t> topFace = loops[iElement];
+    for (auto &iNode : topFace) {
+      iNode += nPoints;
+    }
+    faces.push_back(makeFace(bottomFace, static_cast<int>(iElement), -1));
+    faces.push_back(makeFace(topFace, static_cast<int>(iElement), -1));
+  }
+  for (std::size_t iFace = 0; iFace < faces.size(); ++iFace) {
+    faces[iFace].index() = iFace;
+  }
+
+  fvMesh.nBoundaries() = 1;
+  fvMesh.nPatches() = 1;
+  fvMesh.boundaries().assign(1, Boundary());
+  Boundary &walls = fvMesh.boundaries()[0];
+  walls.userName() = "walls";
+  walls.type() = "wall";
+  walls.startFace() = fvMesh.nInteriorFaces();
+  walls.nFaces() = faces.size() - fvMesh.nInteriorFaces();
+
+  fvMesh.nFaces() = faces.size();
+  fvMesh.nOwners() = faces.size();
+  fvMesh.faces() = std::move(faces);
+  fvMesh.nCells() = loops.size();
+  fvMesh.cells().assign(fvMesh.nCells(), Cell());
+
+  ReadMesh meshReader;
+  ProcessMesh meshProcessor;
+  meshReader.constructConnectivity(fvMesh);
+  meshProcessor.processOpenFoamMesh(fvMesh);
+  return fvMesh;
+}
+
+} // namespace
 
 // ****** Tests ******
 TEST(UnstructuredFaceGeometryTest, ComputeFaceCentroid) {
@@ -755,4 +891,73 @@ TEST(UnstructuredNodeClassificationTest, LabelInteriorNodes) {
   // Face 3289 (username = frontAndBackPlanes)
   // Node 1073, 945, 1012 belong to face 3289
   EXPECT_EQ(fvMesh.nodes()[1012].Flag(), 1);
-}
\ No newline at end of file
+}
+TEST(UnstructuredBoundaryGeometryTest, CollectPatchLocalArrays) {
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+
+  // --- Act ---
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  // --- Assert ---
+  for (auto &boundary : fvMesh.boundaries()) {
+    ASSERT_EQ(boundary.faceOwners().size(), boundary.nFaces());
+    for (std::size_t i = 0; i < boundary.nFaces(); ++i) {
+      Face &theFace = fvMesh.faces()[boundary.startFace() + i];
+      EXPECT_EQ(boundary.faceOwners()[i], theFace.iOwner());
+      EXPECT_EQ(boundary.gDiff()[i], theFace.gDiff());
+      EXPECT_EQ(boundary.area()[i], theFace.area());
+      EXPECT_TRUE(VectorMatch(boundary.Sf()[i], theFace.Sf(), 3));
+      EXPECT_EQ(boundary.walldist()[i], theFace.walldist());
+    }
+  }
+}
+
+TEST(UnstructuredFaceGeometryTest, BlockKernelsMatchPolygonPath) {
+  // --- Arrange ---
+  // processOpenFoamMesh computes the triangles and quadrilaterals with the
+  // block kernels
+  Mesh blockMesh = mixedFaceMesh(150);
+  Mesh fvMesh = blockMesh;
+  ProcessMesh meshProcessor;
+  std::array<std::size_t, 6> nFacesOfSize = {};
+  for (auto &theFace : fvMesh.faces()) {
+    ++nFacesOfSize[std::min<std::size_t>(theFace.nNodes(), 5)];
+  }
+  std::vector<std::size_t> movedNodes(fvMesh.nNodes());
+  std::iota(movedNodes.begin(), movedNodes.end(), 0);
+  const std::vector<std::array<double, 3>> displacements(
+      fvMesh.nNodes(), {0.0, 0.0, 0.0});
+
+  const double relTol = 1.0e-14;
+
+  // --- Act ---
+  // moveNodes recomputes every face around a moved node face by face, with
+  // the scalar path that polygons take; the nodes stay where they are
+  meshProcessor.moveNodes(fvMesh, movedNodes, displacements);
+
+  // --- Assert ---
+  // More than one block of triangles and of quadrilaterals
+  EXPECT_GT(nFacesOfSize[3], 64);
+  EXPECT_GT(nFacesOfSize[4], 64);
+  EXPECT_GT(nFacesOfSize[5], 0);
+  ASSERT_EQ(fvMesh.movedFaces().size(), fvMesh.nFaces());
+  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+    Face &blockFace = blockMesh.faces()[iFace];
+    Face &scalarFace = fvMesh.faces()[iFace];
+    const double centroidTol = relTol * mag(scalarFace.centroid());
+    const double areaTol = relTol * scalarFace.area();
+    for (std::size_t iCoordinate = 0; iCoordinate < 3; ++iCoordinate) {
+      EXPECT_NEAR(blockFace.centroid()[iCoordinate],
+                  scalarFace.centroid()[iCoordinate], centroidTol)
+          << "face " << iFace;
+      EXPECT_NEAR(blockFace.Sf()[iCoordinate], scalarFace.Sf()[iCoordinate],
+                  areaTol)
+          << "face " << iFace;
+    }
+    EXPECT_NEAR(blockFace.area(), scalarFace.area(), areaTol)
+        << "face " << iFace;
+  }
+}
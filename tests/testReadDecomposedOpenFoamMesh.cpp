@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "DecomposeMesh.hpp"
+#include "DecomposedMesh.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "utilitiesForTesting.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+TEST(ReadDecomposedOpenFoamMeshTest, ReadPiecesAndAddressing)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  DecomposedMesh decomposedMesh(caseDirectory);
+
+  // --- Act ---
+  ReadMesh meshReader;
+  meshReader.readDecomposedOpenFoamMesh(decomposedMesh);
+
+  // --- Assert ---
+  EXPECT_EQ(decomposedMesh.nProcessors(), 4);
+  EXPECT_EQ(decomposedMesh.nGlobalCells(), 918);
+  EXPECT_EQ(decomposedMesh.nGlobalFaces(), 3290);
+  EXPECT_EQ(decomposedMesh.nGlobalNodes(), 1074);
+
+  std::size_t nCells = 0;
+  for (std::size_t iProcessor = 0; iProcessor < 4; ++iProcessor) {
+    Mesh &piece = decomposedMesh.processorMeshes()[iProcessor];
+    nCells += piece.nCells();
+    EXPECT_EQ(decomposedMesh.cellAddressing()[iProcessor].size(), piece.nCells());
+    for (std::size_t iLocal = 0; iLocal < piece.nCells(); ++iLocal) {
+      EXPECT_EQ(decomposedMesh.cellToProcessor()[decomposedMesh.cellAddressing()[iProcessor][iLocal]], iProcessor);
+    }
+  }
+  EXPECT_EQ(nCells, 918);
+}
+
+TEST(ReadDecomposedOpenFoamMeshTest, ProcessorPatchesMatchOnBothSides)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  DecomposedMesh decomposedMesh(caseDirectory);
+
+  // --- Act ---
+  ReadMesh meshReader;
+  meshReader.readDecomposedOpenFoamMesh(decomposedMesh);
+
+  // --- Assert ---
+  std::size_t nInterfaceFaces = 0;
+  for (std::size_t iProcessor = 0; iProcessor < 4; ++iProcessor) {
+    for (auto &interface : decomposedMesh.interfaces()[iProcessor]) {
+      nInterfaceFaces += interface.faces.size();
+      bool matched = false;
+      for (auto &other : decomposedMesh.interfaces()[interface.neighbor]) {
+        if (other.neighbor != iProcessor) {
+          continue;
+        }
+        matched = true;
+        ASSERT_EQ(other.faces.size(), interface.faces.size());
+        for (std::size_t i = 0; i < interface.faces.size(); ++i) {
+          // Same global face, reversed on exactly one side
+          EXPECT_EQ(decomposedMesh.faceAddressing()[iProcessor][interface.faces[i]],
+                    decomposedMesh.faceAddressing()[interface.neighbor][other.faces[i]]);
+          EXPECT_NE(decomposedMesh.faceFlipped()[iProcessor][interface.faces[i]],
+                    decomposedMesh.faceFlipped()[interface.neighbor][other.faces[i]]);
+        }
+      }
+      EXPECT_TRUE(matched);
+    }
+  }
+  EXPECT_EQ(nInterfaceFaces, 2 * 103);
+}
+
+TEST(ReadDecomposedOpenFoamMeshTest, MergeMatchesUndecomposedMesh)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh expectedMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(expectedMesh);
+  DecomposedMesh decomposedMesh(caseDirectory);
+  meshReader.readDecomposedOpenFoamMesh(decomposedMesh);
+
+  // --- Act ---
+  Mesh fvMesh;
+  meshReader.mergeDecomposedMesh(decomposedMesh, fvMesh);
+
+  // --- Assert ---
+  ASSERT_EQ(fvMesh.nCells(), expectedMesh.nCells());
+  ASSERT_EQ(fvMesh.nFaces(), expectedMesh.nFaces());
+  ASSERT_EQ(fvMesh.nNodes(), expectedMesh.nNodes());
+  EXPECT_EQ(fvMesh.nInteriorFaces(), expectedMesh.nInteriorFaces());
+
+  ASSERT_EQ(fvMesh.nBoundaries(), expectedMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    EXPECT_EQ(fvMesh.boundaries()[iBoundary].userName(), expectedMesh.boundaries()[iBoundary].userName());
+    EXPECT_EQ(fvMesh.boundaries()[iBoundary].nFaces(), expectedMesh.boundaries()[iBoundary].nFaces());
+    EXPECT_EQ(fvMesh.boundaries()[iBoundary].startFace(), expectedMesh.boundaries()[iBoundary].startFace());
+  }
+
+  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+    EXPECT_EQ(fvMesh.faces()[iFace].iOwner(), expectedMesh.faces()[iFace].iOwner());
+    EXPECT_EQ(fvMesh.faces()[iFace].iNeighbor(), expectedMesh.faces()[iFace].iNeighbor());
+    EXPECT_TRUE(VectorMatch(fvMesh.faces()[iFace].iNodes(), expectedMesh.faces()[iFace].iNodes(),
+                            expectedMesh.faces()[iFace].nNodes()));
+  }
+
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    EXPECT_DOUBLE_EQ(fvMesh.cells()[iElement].volume(), expectedMesh.cells()[iElement].volume());
+    EXPECT_TRUE(VectorAlmostEqual(fvMesh.cells()[iElement].centroid(), expectedMesh.cells()[iElement].centroid(),
+                                  3, 1e-12, 1e-12));
+  }
+}
+
+TEST(ReadDecomposedOpenFoamMeshTest, DecompositionFromProcessorDirectories)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  DecomposedMesh decomposedMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readDecomposedOpenFoamMesh(decomposedMesh);
+  Mesh fvMesh;
+  meshReader.mergeDecomposedMesh(decomposedMesh, fvMesh);
+
+  // --- Act ---
+  DecomposeMesh meshDecomposer;
+  meshDecomposer.readDecomposeParDict(fvMesh);
+  Decomposition decomposition =
+      meshDecomposer.decompose(fvMesh, decomposedMesh.cellToProcessor());
+
+  // --- Assert ---
+  EXPECT_EQ(decomposition.nSubdomains(), 4);
+  EXPECT_EQ(decomposition.edgeCut(), 103);
+  for (std::size_t iProcessor = 0; iProcessor < 4; ++iProcessor) {
+    Mesh &piece = decomposedMesh.processorMeshes()[iProcessor];
+    auto &cells = decomposition.subdomains()[iProcessor].cells();
+    ASSERT_EQ(cells.size(), piece.nCells());
+    EXPECT_TRUE(VectorMatch(cells, decomposedMesh.cellAddressing()[iProcessor], cells.size()));
+
+    // The pieces hold complete cells, so their geometry is the global one up
+    // to the summation order of the faces
+    for (std::size_t iLocal = 0; iLocal < piece.nCells(); ++iLocal) {
+      EXPECT_TRUE(AlmostEqualAbsAndRelative(piece.cells()[iLocal].volume(),
+                                            fvMesh.cells()[cells[iLocal]].volume(), 1e-12, 1e-12));
+    }
+  }
+}
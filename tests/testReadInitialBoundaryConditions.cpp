@@ -2,9 +2,14 @@
 #include "Mesh.hpp"
 #include "ReadInitialBoundaryConditions.hpp"
 #include "ReadMesh.hpp"
+#include "RenumberMesh.hpp"
 #include "utilitiesForTesting.hpp"
 #include <array>
+#include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
 // ****** Tests ******
@@ -333,4 +338,278 @@ TEST(ReadCustomBoundaryConditionsTest, ReadBoundaryTemperature) {
   EXPECT_EQ(boundaryTemperatureFields[4].boundaryType(),
             expected_boundary_types[4]);
   EXPECT_EQ(boundaryTemperatureFields[4].size(), expected_boundary_nFaces[4]);
-}
\ No newline at end of file
+}
+TEST(ReadInitialConditionTest, ReadNonuniformAsciiFields) {
+
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/testReadInitialBoundaryConditions");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+
+  // The lists of the "0.5" time directory are written with full precision,
+  // so the values are read back exactly
+  meshReader.readOpenFoamMesh(fvMesh);
+  Field<double> internalTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryTemperatureFields;
+  Field<std::array<double, 3>> internalVelocityField(fvMesh.nCells());
+  std::vector<boundaryField<std::array<double, 3>>> boundaryVelocityFields;
+  Field<double> internalPressureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryPressureFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+
+  // --- Act ---
+  initialBoundaryConditionsReader.readOpenFoamInitialBoundaryConditions(
+      fvMesh, internalVelocityField, boundaryVelocityFields,
+      internalTemperatureField, boundaryTemperatureFields,
+      internalPressureField, boundaryPressureFields, "0.5");
+
+  // --- Assert ---
+  ASSERT_EQ(internalTemperatureField.size(), fvMesh.nCells());
+  ASSERT_EQ(internalVelocityField.size(), fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    EXPECT_EQ(internalTemperatureField.value(iElement), 300.0 + iElement / 3.0);
+    const std::array<double, 3> expected = {iElement / 7.0, -(iElement / 11.0),
+                                            0.5};
+    EXPECT_TRUE(
+        VectorMatch(internalVelocityField.value(iElement), expected, 3));
+    EXPECT_EQ(internalPressureField.value(iElement), 1.0e5 + iElement / 9.0);
+  }
+
+  EXPECT_EQ(boundaryTemperatureFields[0].boundaryType(), "fixedValue");
+  ASSERT_EQ(boundaryTemperatureFields[0].size(), 20);
+  EXPECT_EQ(boundaryTemperatureFields[0].value(19), 419.0);
+  EXPECT_EQ(boundaryTemperatureFields[1].boundaryType(), "fixedGradient");
+  ASSERT_EQ(boundaryTemperatureFields[1].gradient().size(), 60);
+  EXPECT_EQ(boundaryTemperatureFields[1].gradient()[59], 29.5);
+
+  ASSERT_EQ(boundaryVelocityFields[0].size(), 20);
+  const std::array<double, 3> expected_last_face_velocity = {1.0 - 19 / 20.0,
+                                                             0.0, 0.0};
+  EXPECT_TRUE(VectorMatch(boundaryVelocityFields[0].value(19),
+                          expected_last_face_velocity, 3));
+  EXPECT_TRUE(boundaryVelocityFields[1].isUniform());
+}
+
+TEST(ReadInitialConditionTest, BinaryFieldsMatchAsciiFields) {
+
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/testReadInitialBoundaryConditions");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+
+  Field<std::array<double, 3>> asciiVelocityField(fvMesh.nCells());
+  std::vector<boundaryField<std::array<double, 3>>> asciiBoundaryVelocityFields;
+  Field<double> asciiTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> asciiBoundaryTemperatureFields;
+  Field<std::array<double, 3>> binaryVelocityField(fvMesh.nCells());
+  std::vector<boundaryField<std::array<double, 3>>>
+      binaryBoundaryVelocityFields;
+  Field<double> binaryTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> binaryBoundaryTemperatureFields;
+  Field<double> asciiPressureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> asciiBoundaryPressureFields;
+  Field<double> binaryPressureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> binaryBoundaryPressureFields;
+
+  // --- Act ---
+  initialBoundaryConditionsReader.readOpenFoamInitialBoundaryConditions(
+      fvMesh, asciiVelocityField, asciiBoundaryVelocityFields,
+      asciiTemperatureField, asciiBoundaryTemperatureFields,
+      asciiPressureField, asciiBoundaryPressureFields, "0.5");
+  initialBoundaryConditionsReader.readOpenFoamInitialBoundaryConditions(
+      fvMesh, binaryVelocityField, binaryBoundaryVelocityFields,
+      binaryTemperatureField, binaryBoundaryTemperatureFields,
+      binaryPressureField, binaryBoundaryPressureFields, "1");
+
+  // --- Assert ---
+  EXPECT_TRUE(VectorMatch(binaryTemperatureField.values(),
+                          asciiTemperatureField.values(), fvMesh.nCells()));
+  EXPECT_EQ(binaryVelocityField.values(), asciiVelocityField.values());
+  EXPECT_TRUE(VectorMatch(binaryPressureField.values(),
+                          asciiPressureField.values(), fvMesh.nCells()));
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries();
+       ++iBoundary) {
+    EXPECT_EQ(binaryBoundaryTemperatureFields[iBoundary].boundaryType(),
+              asciiBoundaryTemperatureFields[iBoundary].boundaryType());
+    EXPECT_EQ(binaryBoundaryVelocityFields[iBoundary].boundaryType(),
+              asciiBoundaryVelocityFields[iBoundary].boundaryType());
+  }
+  EXPECT_TRUE(VectorMatch(binaryBoundaryTemperatureFields[0].values(),
+                          asciiBoundaryTemperatureFields[0].values(), 20));
+  EXPECT_TRUE(VectorMatch(binaryBoundaryTemperatureFields[1].gradient(),
+                          asciiBoundaryTemperatureFields[1].gradient(), 60));
+  EXPECT_EQ(binaryBoundaryVelocityFields[0].values(),
+            asciiBoundaryVelocityFields[0].values());
+}
+
+TEST(ReadInitialConditionTest, NonuniformFieldFollowsCellRenumbering) {
+
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/testReadInitialBoundaryConditions");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  RenumberMesh meshRenumberer;
+  meshReader.readOpenFoamMesh(fvMesh);
+  meshRenumberer.reverseCuthillMcKee(fvMesh);
+  Field<double> internalTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryTemperatureFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+
+  // --- Act ---
+  initialBoundaryConditionsReader.readTemperatureField(
+      fvMesh, internalTemperatureField, boundaryTemperatureFields, "1");
+
+  // --- Assert ---
+  ASSERT_EQ(fvMesh.cellOrdering().size(), fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    EXPECT_EQ(internalTemperatureField.value(iElement),
+              300.0 + fvMesh.cellOrdering()[iElement] / 3.0);
+  }
+}
+
+TEST(ReadInitialConditionTest, ReadPressure) {
+
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/testReadInitialBoundaryConditions");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  Field<double> internalPressureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryPressureFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+
+  // --- Act ---
+  initialBoundaryConditionsReader.readPressureField(
+      fvMesh, internalPressureField, boundaryPressureFields);
+
+  // --- Assert ---
+  EXPECT_TRUE(internalPressureField.isUniform());
+  EXPECT_EQ(internalPressureField.size(), fvMesh.nCells());
+  EXPECT_EQ(internalPressureField.uniformValue(), 0.0);
+  ASSERT_EQ(boundaryPressureFields.size(), 3);
+  EXPECT_EQ(boundaryPressureFields[0].boundaryType(), "zeroGradient");
+  EXPECT_EQ(boundaryPressureFields[1].boundaryType(), "zeroGradient");
+  EXPECT_EQ(boundaryPressureFields[2].boundaryType(), "empty");
+}
+
+TEST(ReadInitialConditionTest, ReadTensorFieldWithIncludeAndMacro) {
+
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/testReadInitialBoundaryConditions");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  Field<std::array<double, 9>> internalGradUField(fvMesh.nCells());
+  std::vector<boundaryField<std::array<double, 9>>> boundaryGradUFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+
+  const std::array<double, 9> expected_gradU = {1.0, 2.0, 3.0, 4.0, 5.0,
+                                                6.0, 7.0, 8.0, 9.0};
+
+  // --- Act ---
+  initialBoundaryConditionsReader.readField(
+      fvMesh, "gradU", internalGradUField, boundaryGradUFields, "0.5");
+
+  // --- Assert ---
+  EXPECT_TRUE(VectorMatch(internalGradUField.uniformValue(), expected_gradU, 9));
+
+  // The value of the 1st boundary refers to the internal field
+  EXPECT_EQ(boundaryGradUFields[0].boundaryType(), "fixedValue");
+  EXPECT_EQ(boundaryGradUFields[0].size(), 20);
+  EXPECT_TRUE(
+      VectorMatch(boundaryGradUFields[0].uniformValue(), expected_gradU, 9));
+
+  // The other boundaries are read from the included file
+  EXPECT_EQ(boundaryGradUFields[1].boundaryType(), "zeroGradient");
+  EXPECT_EQ(boundaryGradUFields[2].boundaryType(), "empty");
+}
+
+TEST(ReadInitialConditionTest, MissingFieldFileThrows) {
+
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/testReadInitialBoundaryConditions");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  Field<double> internalField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+
+  // --- Act and Assert ---
+  EXPECT_THROW(initialBoundaryConditionsReader.readField(
+                   fvMesh, "alpha", internalField, boundaryFields),
+               std::runtime_error);
+}
+
+TEST(ReadBoundaryConditionsTest, OtherPatchTypesReadAsZeroGradient) {
+
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/testReadInitialBoundaryConditions");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  Field<double> internalTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryTemperatureFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+
+  // --- Act ---
+  // calculated on movingWall and symmetryPlane on fixedWalls
+  initialBoundaryConditionsReader.readTemperatureField(
+      fvMesh, internalTemperatureField, boundaryTemperatureFields, "0.25");
+
+  // --- Assert ---
+  EXPECT_EQ(boundaryTemperatureFields[0].boundaryType(), "calculated");
+  EXPECT_EQ(boundaryTemperatureFields[0].conditionType(),
+            BoundaryConditionType::zeroGradient);
+  EXPECT_EQ(boundaryTemperatureFields[0].uniformValue(), 350.0);
+  EXPECT_EQ(boundaryTemperatureFields[1].boundaryType(), "symmetryPlane");
+  EXPECT_EQ(boundaryTemperatureFields[1].conditionType(),
+            BoundaryConditionType::zeroGradient);
+  EXPECT_EQ(boundaryTemperatureFields[2].conditionType(),
+            BoundaryConditionType::empty);
+}
+
+TEST(ReadBoundaryConditionsTest, UnknownAndCoupledPatchTypesThrow) {
+
+  // --- Arrange ---
+  // A copy of the case whose temperature at 0.25 uses the given patch type
+  const std::filesystem::path caseDirectory =
+      std::filesystem::temp_directory_path() / "testUnknownPatchTypes";
+  std::filesystem::remove_all(caseDirectory);
+  std::filesystem::copy("../../cases/testReadInitialBoundaryConditions",
+                        caseDirectory,
+                        std::filesystem::copy_options::recursive);
+  auto writeTemperatureWithType = [&caseDirectory](const std::string &type) {
+    std::ifstream original("../../cases/testReadInitialBoundaryConditions/0.25/T");
+    std::stringstream text;
+    text << original.rdbuf();
+    std::string content = text.str();
+    content.replace(content.find("symmetryPlane"), 13, type);
+    std::ofstream(caseDirectory / "0.25" / "T") << content;
+  };
+  Mesh fvMesh(caseDirectory.string());
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  Field<double> internalTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryTemperatureFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+
+  for (const std::string type : {"fixedvalue", "processor", "cyclic"}) {
+    writeTemperatureWithType(type);
+
+    // --- Act and Assert ---
+    try {
+      initialBoundaryConditionsReader.readTemperatureField(
+          fvMesh, internalTemperatureField, boundaryTemperatureFields, "0.25");
+      ADD_FAILURE() << "Patch type " << type << " was accepted";
+    } catch (const std::runtime_error &error) {
+      const std::string message = error.what();
+      EXPECT_NE(message.find(type), std::string::npos) << message;
+      EXPECT_NE(message.find("patch fixedWalls of field T"), std::string::npos)
+          << message;
+    }
+  }
+  std::filesystem::remove_all(caseDirectory);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "CsrMatrix.hpp"
+#include "RecycledCg.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include "utilitiesForTesting.hpp"
+#include <cmath>
+#include <vector>
+
+// ****** Helpers ******
+void identity(const double *r, double *z, const std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i) {
+    z[i] = r[i];
+  }
+}
+
+// ****** Tests ******
+TEST(RecycledCgTest, SolvesWithoutRecycling)
+{
+  // --- Arrange ---
+  const int n = 10;
+  const CsrMatrix<double, int> matrix(laplacianMatrix(n));
+  std::vector<double> expected_solution(n * n);
+  for (std::size_t i = 0; i < expected_solution.size(); ++i) {
+    expected_solution[i] = std::sin(0.1 * static_cast<double>(i));
+  }
+  std::vector<double> RHS(n * n);
+  matrix.apply(expected_solution.data(), RHS.data());
+  std::vector<double> solution(n * n, 0.0);
+
+  RecycledCg<double, int> solver(0);
+
+  // --- Act ---
+  solver.solve(
+      matrix, RHS, solution,
+      [&](const double *r, double *z) { identity(r, z, RHS.size()); },
+      1.0e-12, 1000);
+
+  // --- Assert ---
+  EXPECT_EQ(solver.nRecycledVectors(), 0);
+  EXPECT_TRUE(VectorAlmostEqual(solution, expected_solution, n * n, 1.0e-9, 1.0e-8));
+}
+
+TEST(RecycledCgTest, RecyclingReducesIterationsOfLaterSolves)
+{
+  // --- Arrange ---
+  const int n = 30;
+  const std::size_t nSteps = 6;
+  RecycledCg<double, int> solver(10);
+  std::vector<std::size_t> nIterations;
+  std::vector<double> solution(n * n, 0.0);
+
+  // --- Act ---
+  for (std::size_t step = 0; step < nSteps; ++step) {
+    // The shift mimics the slowly varying transient term of consecutive steps
+    const CsrMatrix<double, int> matrix(
+        laplacianMatrix(n, 2, 1.0e-3 * static_cast<double>(step)));
+    std::vector<double> RHS(n * n);
+    for (std::size_t i = 0; i < RHS.size(); ++i) {
+      RHS[i] = 1.0 + std::cos(0.05 * static_cast<double>(i + step));
+    }
+    std::fill(solution.begin(), solution.end(), 0.0);
+    nIterations.push_back(solver.solve(
+        matrix, RHS, solution,
+        [&](const double *r, double *z) { identity(r, z, RHS.size()); },
+        1.0e-8, 1000));
+
+    // Verify the solution of every step
+    std::vector<double> Ax(n * n);
+    matrix.apply(solution.data(), Ax.data());
+    EXPECT_TRUE(VectorAlmostEqual(Ax, RHS, n * n, 1.0e-6, 1.0e-6));
+  }
+
+  // --- Assert ---
+  EXPECT_EQ(solver.nRecycledVectors(), 10);
+  for (std::size_t step = 2; step < nSteps; ++step) {
+    EXPECT_LT(nIterations[step], nIterations[0]);
+  }
+  EXPECT_LT(nIterations.back(), 0.75 * static_cast<double>(nIterations[0]));
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include "AssembleDiffusionTerm.hpp"
+#include "CsrMatrix.hpp"
+#include "Field.hpp"
+#include "Graph.hpp"
+#include "GraphOrdering.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "RenumberMesh.hpp"
+#include "arrayOperations.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include "utilitiesForTesting.hpp"
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+// ****** Helpers ******
+// Diffusion matrix of a mesh with fixedValue boundaries everywhere
+CsrMatrix<double, int> diffusionMatrix(Mesh &fvMesh, std::vector<double> &RHS)
+{
+  std::vector<boundaryField<double>> boundaryFields(fvMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    boundaryFields[iBoundary].setBoundaryType("fixedValue");
+    boundaryFields[iBoundary].resize(fvMesh.boundaries()[iBoundary].nFaces());
+    boundaryFields[iBoundary].set(1.0);
+  }
+  const std::vector<double> diffusionCoef(fvMesh.nFaces(), 1.0);
+  const std::vector<double> source(fvMesh.nCells(), 0.0);
+  RHS.assign(fvMesh.nCells(), 0.0);
+  gko::matrix_data<double, int> coeffMatrix;
+  AssembleDiffusionTerm diffusionTermAssembler;
+  diffusionTermAssembler.faceBasedAssemble(
+      fvMesh, diffusionCoef, source, boundaryFields, coeffMatrix, RHS);
+  return CsrMatrix<double, int>(coeffMatrix);
+}
+
+// ****** Tests ******
+TEST(GraphOrderingTest, ReverseCuthillMcKeeRestoresBandOfShuffledGrid)
+{
+  // --- Arrange ---
+  // 2D grid whose rows are numbered in a scattered order
+  const std::size_t n = 12;
+  std::vector<std::size_t> scattered(n * n);
+  for (std::size_t i = 0; i < scattered.size(); ++i) {
+    scattered[i] = (i * 37) % scattered.size();
+  }
+  gko::matrix_data<double, int> data;
+  data.size = {n * n, n * n};
+  for (std::size_t j = 0; j < n; ++j) {
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto row = static_cast<int>(scattered[j * n + i]);
+      data.nonzeros.emplace_back(row, row, 4.0);
+      if (i > 0) {
+        data.nonzeros.emplace_back(row, static_cast<int>(scattered[j * n + i - 1]), -1.0);
+      }
+      if (i < n - 1) {
+        data.nonzeros.emplace_back(row, static_cast<int>(scattered[j * n + i + 1]), -1.0);
+      }
+      if (j > 0) {
+        data.nonzeros.emplace_back(row, static_cast<int>(scattered[(j - 1) * n + i]), -1.0);
+      }
+      if (j < n - 1) {
+        data.nonzeros.emplace_back(row, static_cast<int>(scattered[(j + 1) * n + i]), -1.0);
+      }
+    }
+  }
+  const Graph graph{CsrMatrix<double, int>(data)};
+
+  // --- Act ---
+  const auto perm = GraphOrdering::reverseCuthillMcKee(graph);
+
+  // --- Assert ---
+  // A diagonal sweep of the grid has bandwidth n
+  EXPECT_GT(GraphOrdering::bandwidth(graph), n * n / 2);
+  EXPECT_LE(GraphOrdering::bandwidth(graph, perm), n);
+}
+
+TEST(RenumberMeshTest, ReverseCuthillMcKeeKeepsUpperTriangularFaceOrder)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  const std::size_t bandwidthBefore = GraphOrdering::bandwidth(Graph(fvMesh));
+
+  // --- Act ---
+  RenumberMesh meshRenumberer;
+  meshRenumberer.reverseCuthillMcKee(fvMesh);
+
+  // --- Assert ---
+  EXPECT_LT(GraphOrdering::bandwidth(Graph(fvMesh)), bandwidthBefore);
+  for (std::size_t iFace = 0; iFace < fvMesh.nInteriorFaces(); ++iFace) {
+    Face &theFace = fvMesh.faces()[iFace];
+    EXPECT_LT(theFace.iOwner(), theFace.iNeighbor());
+    if (iFace > 0) {
+      Face &previousFace = fvMesh.faces()[iFace - 1];
+      EXPECT_LE(previousFace.iOwner(), theFace.iOwner());
+      if (previousFace.iOwner() == theFace.iOwner()) {
+        EXPECT_LT(previousFace.iNeighbor(), theFace.iNeighbor());
+      }
+    }
+  }
+}
+
+TEST(RenumberMeshTest, RenumberedDiffusionSystemIsPermutedOriginal)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh originalMesh(caseDirectory);
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(originalMesh);
+  meshReader.readOpenFoamMesh(fvMesh);
+  std::vector<double> originalRHS;
+  const auto originalMatrix = diffusionMatrix(originalMesh, originalRHS);
+  const auto originalDiagonal = originalMatrix.diagonal();
+
+  // --- Act ---
+  RenumberMesh meshRenumberer;
+  meshRenumberer.reverseCuthillMcKee(fvMesh);
+  std::vector<double> RHS;
+  const auto matrix = diffusionMatrix(fvMesh, RHS);
+
+  // --- Assert ---
+  const auto &cellOrdering = fvMesh.cellOrdering();
+  std::vector<double> expected_diagonal(fvMesh.nCells());
+  std::vector<double> expected_RHS(fvMesh.nCells());
+  std::vector<double> expected_volume(fvMesh.nCells());
+  std::vector<double> volume(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    expected_diagonal[iElement] = originalDiagonal[cellOrdering[iElement]];
+    expected_RHS[iElement] = originalRHS[cellOrdering[iElement]];
+    expected_volume[iElement] = originalMesh.cells()[cellOrdering[iElement]].volume();
+    volume[iElement] = fvMesh.cells()[iElement].volume();
+  }
+  EXPECT_EQ(matrix.nNonzeros(), originalMatrix.nNonzeros());
+  EXPECT_TRUE(VectorAlmostEqual(matrix.diagonal(), expected_diagonal, fvMesh.nCells(), 1.0e-12, 1.0e-12));
+  EXPECT_TRUE(VectorAlmostEqual(RHS, expected_RHS, fvMesh.nCells(), 1.0e-12, 1.0e-12));
+  EXPECT_TRUE(VectorAlmostEqual(volume, expected_volume, fvMesh.nCells(), 1.0e-12, 1.0e-12));
+}
+
+TEST(RenumberMeshTest, CellFieldRoundTrip)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/cavity");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  std::vector<double> expected_values(fvMesh.nCells());
+  std::iota(expected_values.begin(), expected_values.end(), 0.0);
+
+  RenumberMesh meshRenumberer;
+  std::vector<std::size_t> reversed(fvMesh.nCells());
+  std::iota(reversed.rbegin(), reversed.rend(), 0);
+  meshRenumberer.renumberCells(fvMesh, reversed);
+  meshRenumberer.reverseCuthillMcKee(fvMesh);
+
+  // --- Act ---
+  std::vector<double> values = expected_values;
+  RenumberMesh::toCurrentNumbering(fvMesh, values);
+  const auto originalValues = RenumberMesh::toOriginalNumbering(fvMesh.cellOrdering(), values);
+
+  // --- Assert ---
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    EXPECT_EQ(values[iElement], static_cast<double>(fvMesh.cellOrdering()[iElement]));
+  }
+  EXPECT_TRUE(VectorMatch(originalValues, expected_values, fvMesh.nCells()));
+}
+
+TEST(RenumberMeshTest, HilbertCurveOrdersCellsAndNodesLocally)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/cavity");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  std::vector<double> expected_volume(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    expected_volume[iElement] = fvMesh.cells()[iElement].volume();
+  }
+
+  // --- Act ---
+  RenumberMesh meshRenumberer;
+  meshRenumberer.spaceFillingCurve(fvMesh, SpaceFillingCurve::hilbert);
+
+  // --- Assert ---
+  // On the 20x20 cavity consecutive cells along the curve are at most a few
+  // cell widths (0.005) apart
+  double maxJump = 0.0;
+  for (std::size_t iElement = 1; iElement < fvMesh.nCells(); ++iElement) {
+    maxJump = std::max(maxJump, mag(fvMesh.cells()[iElement].centroid() -
+                                    fvMesh.cells()[iElement - 1].centroid()));
+  }
+  EXPECT_LT(maxJump, 0.0151);
+
+  // Faces are upper triangular and nodes numbered by first use
+  std::size_t nNumberedNodes = 0;
+  for (std::size_t iFace = 0; iFace < fvMesh.nFaces(); ++iFace) {
+    Face &theFace = fvMesh.faces()[iFace];
+    if (iFace < fvMesh.nInteriorFaces()) {
+      EXPECT_LT(theFace.iOwner(), theFace.iNeighbor());
+    }
+    for (const std::size_t iNode : theFace.iNodes()) {
+      EXPECT_LE(iNode, nNumberedNodes);
+      if (iNode == nNumberedNodes) {
+        nNumberedNodes++;
+      }
+    }
+  }
+  EXPECT_EQ(nNumberedNodes, fvMesh.nNodes());
+
+  std::vector<double> volume(fvMesh.nCells());
+  std::vector<double> expected_renumbered_volume(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    volume[iElement] = fvMesh.cells()[iElement].volume();
+    expected_renumbered_volume[iElement] = expected_volume[fvMesh.cellOrdering()[iElement]];
+  }
+  EXPECT_TRUE(VectorAlmostEqual(volume, expected_renumbered_volume, fvMesh.nCells(), 1.0e-15, 1.0e-12));
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include "AssembleDiffusionTerm.hpp"
+#include "CsrMatrix.hpp"
+#include "Field.hpp"
+#include "Graph.hpp"
+#include "GraphOrdering.hpp"
+#include "Mesh.hpp"
+#include "ReadMesh.hpp"
+#include "SparseCholesky.hpp"
+#include "ginkgo/ginkgo.hpp"
+#include "utilitiesForTesting.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <vector>
+
+// ****** Tests ******
+TEST(GraphTest, CellGraphOfCavityMesh)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/cavity");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  // --- Act ---
+  const Graph graph(fvMesh);
+
+  // --- Assert ---
+  // 20x20 cells: corners have two neighbors, each interior face is an edge
+  EXPECT_EQ(graph.nVertices(), 400);
+  EXPECT_EQ(graph.degree(0), 2);
+  EXPECT_EQ(graph.adjacency().size(), 2 * fvMesh.nInteriorFaces());
+}
+
+TEST(GraphOrderingTest, NestedDissectionIsPermutation)
+{
+  // --- Arrange ---
+  const Graph graph(CsrMatrix<double, int>(laplacianMatrix(25)));
+
+  // --- Act ---
+  std::vector<std::size_t> perm = GraphOrdering::nestedDissection(graph, 8);
+
+  // --- Assert ---
+  std::vector<std::size_t> expected_perm(graph.nVertices());
+  std::iota(expected_perm.begin(), expected_perm.end(), 0);
+  std::sort(perm.begin(), perm.end());
+  EXPECT_TRUE(VectorMatch(perm, expected_perm, expected_perm.size()));
+}
+
+TEST(SparseCholeskyTest, SolvesLaplacian)
+{
+  // --- Arrange ---
+  const int n = 20;
+  const CsrMatrix<double, int> matrix(laplacianMatrix(n));
+  std::vector<double> expected_solution(n * n);
+  for (std::size_t i = 0; i < expected_solution.size(); ++i) {
+    expected_solution[i] = std::sin(0.1 * static_cast<double>(i));
+  }
+  std::vector<double> RHS(n * n);
+  matrix.apply(expected_solution.data(), RHS.data());
+  std::vector<double> solution(n * n);
+
+  // --- Act ---
+  SparseCholesky<double, int> cholesky;
+  cholesky.factorize(matrix);
+  cholesky.solve(RHS.data(), solution.data());
+
+  // --- Assert ---
+  EXPECT_TRUE(VectorAlmostEqual(solution, expected_solution, n * n, 1.0e-10, 1.0e-10));
+}
+
+TEST(SparseCholeskyTest, NestedDissectionReducesFill)
+{
+  // --- Arrange ---
+  const int n = 40;
+  const CsrMatrix<double, int> matrix(laplacianMatrix(n));
+  std::vector<std::size_t> naturalOrdering(n * n);
+  std::iota(naturalOrdering.begin(), naturalOrdering.end(), 0);
+
+  SparseCholesky<double, int> natural;
+  SparseCholesky<double, int> dissected;
+
+  // --- Act ---
+  natural.analyze(matrix, naturalOrdering);
+  dissected.analyze(matrix);
+
+  // --- Assert ---
+  // The banded natural ordering fills the whole band of width n
+  EXPECT_LT(dissected.nNonzerosFactor(), natural.nNonzerosFactor());
+}
+
+TEST(SparseCholeskyTest, RefactorizationReusesSymbolicAnalysis)
+{
+  // --- Arrange ---
+  const int n = 15;
+  SparseCholesky<double, int> cholesky;
+  cholesky.factorize(CsrMatrix<double, int>(laplacianMatrix(n)));
+  const std::vector<std::size_t> expected_ordering = cholesky.ordering();
+
+  const CsrMatrix<double, int> shiftedMatrix(laplacianMatrix(n, 2, 0.5));
+  const std::vector<double> expected_solution(n * n, 1.0);
+  std::vector<double> RHS(n * n);
+  shiftedMatrix.apply(expected_solution.data(), RHS.data());
+  std::vector<double> solution(n * n);
+
+  // --- Act ---
+  cholesky.factorize(shiftedMatrix);
+  cholesky.solve(RHS.data(), solution.data());
+
+  // --- Assert ---
+  EXPECT_TRUE(VectorMatch(cholesky.ordering(), expected_ordering, n * n));
+  EXPECT_TRUE(VectorAlmostEqual(solution, expected_solution, n * n, 1.0e-10, 1.0e-10));
+}
+
+TEST(SparseCholeskyTest, SolvesDiffusionMatrixOfElbowMesh)
+{
+  // --- Arrange ---
+  std::string caseDirectory("../../cases/elbow");
+  Mesh fvMesh(caseDirectory);
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+
+  std::vector<boundaryField<double>> boundaryFields(fvMesh.nBoundaries());
+  for (std::size_t iBoundary = 0; iBoundary < fvMesh.nBoundaries(); ++iBoundary) {
+    boundaryFields[iBoundary].setBoundaryType("fixedValue");
+    boundaryFields[iBoundary].resize(fvMesh.boundaries()[iBoundary].nFaces());
+    boundaryFields[iBoundary].set(1.0);
+  }
+  const std::vector<double> diffusionCoef(fvMesh.nFaces(), 1.0);
+  const std::vector<double> source(fvMesh.nCells(), 0.0);
+  std::vector<double> RHS(fvMesh.nCells(), 0.0);
+  gko::matrix_data<double, int> coeffMatrix;
+  AssembleDiffusionTerm diffusionTermAssembler;
+  diffusionTermAssembler.faceBasedAssemble(
+      fvMesh, diffusionCoef, source, boundaryFields, coeffMatrix, RHS);
+  const CsrMatrix<double, int> matrix(coeffMatrix);
+
+  // A uniform Dirichlet value of 1 everywhere gives the solution 1
+  const std::vector<double> expected_solution(fvMesh.nCells(), 1.0);
+  std::vector<double> solution(fvMesh.nCells());
+
+  // --- Act ---
+  SparseCholesky<double, int> cholesky;
+  cholesky.factorize(matrix);
+  cholesky.solve(RHS.data(), solution.data());
+
+  // --- Assert ---
+  EXPECT_TRUE(VectorAlmostEqual(solution, expected_solution, fvMesh.nCells(), 1.0e-9, 1.0e-9));
+}
@@ -0,0 +1,368 @@
+#include <gtest/gtest.h>
+
+#include "AsyncWriteField.hpp"
+#include "Field.hpp"
+#include "FoamTokenizer.hpp"
+#include "Mesh.hpp"
+#include "ReadInitialBoundaryConditions.hpp"
+#include "ReadMesh.hpp"
+#include "WriteField.hpp"
+#include "utilitiesForTesting.hpp"
+#include <cmath>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ****** Helpers ******
+namespace {
+
+// Copy of a case in the temporary directory, so that written time
+// directories do not end up in the source tree
+std::string copyCase(const std::string &caseDirectory, const std::string &name)
+{
+  const std::filesystem::path copy =
+      std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(copy);
+  std::filesystem::copy(caseDirectory, copy,
+                        std::filesystem::copy_options::recursive);
+  return copy.string();
+}
+
+} // namespace
+
+// ****** Tests ******
+TEST(WriteFieldTest, ShortestValuesReadBackExactly)
+{
+  // --- Arrange ---
+  Mesh fvMesh(copyCase("../../cases/testReadInitialBoundaryConditions",
+                       "testWriteFieldShortest"));
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  std::vector<double> temperature(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    temperature[iElement] = 300.0 + std::sin(0.1 * iElement) / 3.0;
+  }
+  WriteField fieldWriter(fvMesh.caseDir());
+  fieldWriter.writePrecision() = 0;
+
+  // --- Act ---
+  fieldWriter.write(temperature, "2", "T");
+  Field<double> internalTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryTemperatureFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+  initialBoundaryConditionsReader.readTemperatureField(
+      fvMesh, internalTemperatureField, boundaryTemperatureFields, "2");
+
+  // --- Assert ---
+  EXPECT_GT(fieldWriter.bytesWritten(), 0);
+  EXPECT_TRUE(VectorMatch(internalTemperatureField.values(), temperature,
+                          fvMesh.nCells()));
+  // The boundary conditions are those of the initial conditions
+  EXPECT_EQ(boundaryTemperatureFields[0].boundaryType(), "fixedValue");
+  EXPECT_EQ(boundaryTemperatureFields[0].uniformValue(), 493.0);
+  EXPECT_EQ(boundaryTemperatureFields[1].boundaryType(), "zeroGradient");
+
+  std::filesystem::remove_all(fvMesh.caseDir());
+}
+
+TEST(WriteFieldTest, WritePrecisionOfControlDict)
+{
+  // --- Arrange ---
+  Mesh fvMesh(copyCase("../../cases/testReadInitialBoundaryConditions",
+                       "testWriteFieldPrecision"));
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  std::vector<double> temperature(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    temperature[iElement] = 300.0 + iElement / 3.0;
+  }
+
+  // --- Act ---
+  WriteField fieldWriter(fvMesh.caseDir());
+  fieldWriter.write(temperature, "2", "T");
+  fieldWriter.write(temperature, "3", "T");
+  Field<double> internalTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryTemperatureFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+  initialBoundaryConditionsReader.readTemperatureField(
+      fvMesh, internalTemperatureField, boundaryTemperatureFields, "3");
+
+  // --- Assert ---
+  // writePrecision 6 of the case
+  EXPECT_EQ(fieldWriter.writePrecision(), 6);
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    EXPECT_NEAR(internalTemperatureField.value(iElement), temperature[iElement],
+                5.0e-6 * temperature[iElement]);
+  }
+  EXPECT_EQ(internalTemperatureField.value(1), 300.333);
+
+  std::filesystem::remove_all(fvMesh.caseDir());
+}
+
+TEST(WriteFieldTest, LongNumbersAreWrittenWhole)
+{
+  // --- Arrange ---
+  Mesh fvMesh(copyCase("../../cases/testReadInitialBoundaryConditions",
+                       "testWriteFieldLongNumbers"));
+  const std::string controlDictName = fvMesh.caseDir() + "/system/controlDict";
+  std::ifstream controlDictFile(controlDictName);
+  std::stringstream controlDict;
+  controlDict << controlDictFile.rdbuf();
+  controlDictFile.close();
+  std::string text = controlDict.str();
+  text.replace(text.find("writePrecision  6;"), 18, "writePrecision  40;");
+  std::ofstream(controlDictName) << text;
+  // More than a chunk of the output buffer
+  std::vector<double> temperature(100000);
+  for (std::size_t iElement = 0; iElement < temperature.size(); ++iElement) {
+    temperature[iElement] = 300.0 + std::sin(0.1 * iElement) / 3.0;
+  }
+
+  // --- Act ---
+  WriteField fieldWriter(fvMesh.caseDir());
+  const int controlDictPrecision = fieldWriter.writePrecision();
+  fieldWriter.writePrecision() = 40;
+  fieldWriter.write(temperature, "2", "T");
+  FoamTokenizer tokens(fvMesh.caseDir() + "/2/T");
+  tokens.readHeader();
+  while (!tokens.peek().is("internalField")) {
+    tokens.skipEntry();
+  }
+  tokens.next();
+  const std::string nonuniform = tokens.word();
+  const std::string listType = tokens.word();
+  std::vector<double> written;
+  tokens.readList(written);
+
+  // --- Assert ---
+  // More digits than a double has are limited when read from the case
+  EXPECT_EQ(controlDictPrecision, 17);
+  EXPECT_EQ(listType, "List<scalar>");
+  EXPECT_EQ(written, temperature);
+
+  std::filesystem::remove_all(fvMesh.caseDir());
+}
+
+TEST(WriteFieldTest, VectorFieldsInAsciiAndBinary)
+{
+  // --- Arrange ---
+  Mesh fvMesh(copyCase("../../cases/testReadInitialBoundaryConditions",
+                       "testWriteFieldVector"));
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  std::vector<std::array<double, 3>> velocity(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    velocity[iElement] = {std::sin(0.1 * iElement), -iElement / 7.0,
+                          1.0e-9 * iElement};
+  }
+  WriteField fieldWriter(fvMesh.caseDir());
+  fieldWriter.writePrecision() = 0;
+
+  // --- Act ---
+  fieldWriter.write(velocity, "2", "U");
+  fieldWriter.writeFormat() = WriteFormat::binary;
+  fieldWriter.write(velocity, "3", "U");
+
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+  Field<std::array<double, 3>> asciiVelocityField(fvMesh.nCells());
+  std::vector<boundaryField<std::array<double, 3>>> asciiBoundaryFields;
+  initialBoundaryConditionsReader.readVelocityField(
+      fvMesh, asciiVelocityField, asciiBoundaryFields, "2");
+  Field<std::array<double, 3>> binaryVelocityField(fvMesh.nCells());
+  std::vector<boundaryField<std::array<double, 3>>> binaryBoundaryFields;
+  initialBoundaryConditionsReader.readVelocityField(
+      fvMesh, binaryVelocityField, binaryBoundaryFields, "3");
+
+  // --- Assert ---
+  EXPECT_EQ(asciiVelocityField.values(), velocity);
+  EXPECT_EQ(binaryVelocityField.values(), velocity);
+  EXPECT_EQ(binaryBoundaryFields[1].boundaryType(), "noSlip");
+
+  // The binary file holds the doubles themselves, and the dimensions are
+  // those of the initial conditions
+  std::ifstream binaryFile(fvMesh.caseDir() + "/3/U", std::ios::binary);
+  std::stringstream text;
+  text << binaryFile.rdbuf();
+  EXPECT_NE(text.str().find("volVectorField"), std::string::npos);
+  EXPECT_NE(text.str().find("dimensions      [0 1 -1 0 0 0 0];"),
+            std::string::npos);
+  EXPECT_GT(fieldWriter.bytesWritten(),
+            fvMesh.nCells() * sizeof(std::array<double, 3>));
+
+  std::filesystem::remove_all(fvMesh.caseDir());
+}
+
+TEST(WriteFieldTest, BoundaryListsInTheFormatOfTheFile)
+{
+  // --- Arrange ---
+  Mesh fvMesh(copyCase("../../cases/testReadInitialBoundaryConditions",
+                       "testWriteFieldBoundaryLists"));
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  const std::size_t nFaces = fvMesh.boundaries()[0].nFaces();
+  std::string wallValues = std::to_string(nFaces) + "(";
+  for (std::size_t iFace = 0; iFace < nFaces; ++iFace) {
+    wallValues += " " + std::to_string(400 + iFace);
+  }
+  wallValues += ")";
+  const std::string initialName = fvMesh.caseDir() + "/0/T";
+  std::ifstream initialFile(initialName);
+  std::stringstream initial;
+  initial << initialFile.rdbuf();
+  initialFile.close();
+  std::string text = initial.str();
+  text.replace(text.find("uniform 493"), 11,
+               "nonuniform List<scalar> " + wallValues);
+  std::ofstream(initialName) << text;
+  const std::vector<double> temperature(fvMesh.nCells(), 300.0);
+
+  // --- Act ---
+  // An ascii source written in binary, and that binary file as the source
+  // of an ascii file
+  WriteField binaryFieldWriter(fvMesh.caseDir());
+  binaryFieldWriter.writeFormat() = WriteFormat::binary;
+  binaryFieldWriter.write(temperature, "2", "T");
+  std::filesystem::copy_file(fvMesh.caseDir() + "/2/T", initialName,
+                             std::filesystem::copy_options::overwrite_existing);
+  WriteField asciiFieldWriter(fvMesh.caseDir());
+  asciiFieldWriter.write(temperature, "3", "T");
+
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+  Field<double> binaryTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> binaryBoundaryFields;
+  initialBoundaryConditionsReader.readTemperatureField(
+      fvMesh, binaryTemperatureField, binaryBoundaryFields, "2");
+  Field<double> asciiTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> asciiBoundaryFields;
+  initialBoundaryConditionsReader.readTemperatureField(
+      fvMesh, asciiTemperatureField, asciiBoundaryFields, "3");
+
+  // --- Assert ---
+  ASSERT_EQ(binaryBoundaryFields[0].values().size(), nFaces);
+  ASSERT_EQ(asciiBoundaryFields[0].values().size(), nFaces);
+  for (std::size_t iFace = 0; iFace < nFaces; ++iFace) {
+    EXPECT_EQ(binaryBoundaryFields[0].values()[iFace], 400.0 + iFace);
+    EXPECT_EQ(asciiBoundaryFields[0].values()[iFace], 400.0 + iFace);
+  }
+  EXPECT_EQ(asciiBoundaryFields[1].boundaryType(), "zeroGradient");
+
+  std::filesystem::remove_all(fvMesh.caseDir());
+}
+
+TEST(WriteFieldTest, CompressionOfControlDict)
+{
+  // --- Arrange ---
+  Mesh fvMesh(copyCase("../../cases/testReadInitialBoundaryConditions",
+                       "testWriteFieldCompression"));
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  const std::string controlDictName = fvMesh.caseDir() + "/system/controlDict";
+  std::ifstream controlDictFile(controlDictName);
+  std::stringstream controlDict;
+  controlDict << controlDictFile.rdbuf();
+  controlDictFile.close();
+  std::string text = controlDict.str();
+  text.replace(text.find("writeCompression off;"), 21, "writeCompression on;");
+  std::ofstream(controlDictName) << text;
+  std::vector<double> temperature(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    temperature[iElement] = 300.0 + std::sin(0.1 * iElement) / 3.0;
+  }
+  const std::filesystem::path timeDirectory =
+      std::filesystem::path(fvMesh.caseDir()) / "2";
+
+  // --- Act ---
+  WriteField fieldWriter(fvMesh.caseDir());
+  fieldWriter.writePrecision() = 0;
+  fieldWriter.write(temperature, "2", "T");
+  Field<double> internalTemperatureField(fvMesh.nCells());
+  std::vector<boundaryField<double>> boundaryTemperatureFields;
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+  initialBoundaryConditionsReader.readTemperatureField(
+      fvMesh, internalTemperatureField, boundaryTemperatureFields, "2");
+
+  // --- Assert ---
+  EXPECT_TRUE(fieldWriter.writeCompression());
+  EXPECT_TRUE(std::filesystem::exists(timeDirectory / "T.gz"));
+  EXPECT_FALSE(std::filesystem::exists(timeDirectory / "T"));
+  EXPECT_EQ(fieldWriter.bytesWritten(),
+            std::filesystem::file_size(timeDirectory / "T.gz"));
+  EXPECT_TRUE(VectorMatch(internalTemperatureField.values(), temperature,
+                          fvMesh.nCells()));
+  EXPECT_EQ(boundaryTemperatureFields[1].boundaryType(), "zeroGradient");
+
+  // An uncompressed write replaces the compressed file
+  const std::size_t compressedSize = fieldWriter.bytesWritten();
+  fieldWriter.writeCompression() = false;
+  fieldWriter.write(temperature, "2", "T");
+  EXPECT_TRUE(std::filesystem::exists(timeDirectory / "T"));
+  EXPECT_FALSE(std::filesystem::exists(timeDirectory / "T.gz"));
+  EXPECT_LT(compressedSize, fieldWriter.bytesWritten());
+
+  std::filesystem::remove_all(fvMesh.caseDir());
+}
+
+TEST(AsyncWriteFieldTest, QueuedWritesAreSnapshots)
+{
+  // --- Arrange ---
+  Mesh fvMesh(copyCase("../../cases/testReadInitialBoundaryConditions",
+                       "testAsyncWriteField"));
+  ReadMesh meshReader;
+  meshReader.readOpenFoamMesh(fvMesh);
+  std::vector<double> temperature(fvMesh.nCells(), 300.0);
+  const std::size_t nTimes = 5;
+
+  // --- Act ---
+  {
+    AsyncWriteField fieldWriter(fvMesh.caseDir(), 1);
+    fieldWriter.fieldWriter().writePrecision() = 0;
+    for (std::size_t iTime = 1; iTime <= nTimes; ++iTime) {
+      // The values change right after each write is queued
+      fieldWriter.write(temperature, std::to_string(iTime), "T");
+      for (auto &value : temperature) {
+        value += 1.0 / 3.0;
+      }
+    }
+    fieldWriter.flush();
+  }
+
+  // --- Assert ---
+  ReadInitialBoundaryConditions initialBoundaryConditionsReader;
+  double expected = 300.0;
+  for (std::size_t iTime = 1; iTime <= nTimes; ++iTime) {
+    Field<double> internalTemperatureField(fvMesh.nCells());
+    std::vector<boundaryField<double>> boundaryTemperatureFields;
+    initialBoundaryConditionsReader.readTemperatureField(
+        fvMesh, internalTemperatureField, boundaryTemperatureFields,
+        std::to_string(iTime));
+    for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+      EXPECT_EQ(internalTemperatureField.value(iElement), expected);
+    }
+    expected += 1.0 / 3.0;
+  }
+
+  std::filesystem::remove_all(fvMesh.caseDir());
+}
+
+TEST(AsyncWriteFieldTest, BackgroundErrorIsThrownOnFlush)
+{
+  // --- Arrange ---
+  Mesh fvMesh(copyCase("../../cases/testReadInitialBoundaryConditions",
+                       "testAsyncWriteFieldError"));
+  AsyncWriteField fieldWriter(fvMesh.caseDir());
+  const std::vector<double> values(400, 1.0);
+
+  // --- Act ---
+  // There are no initial conditions to take the boundaryField entry from
+  fieldWriter.write(values, "1", "alpha");
+
+  // --- Assert ---
+  EXPECT_THROW(fieldWriter.flush(), std::exception);
+  EXPECT_NO_THROW(fieldWriter.flush());
+
+  std::filesystem::remove_all(fvMesh.caseDir());
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include "GenerateMesh.hpp"
+#include "Mesh.hpp"
+#include "WriteVtu.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ****** Helpers ******
+namespace {
+
+std::string readFile(const std::string &fileName)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  std::stringstream text;
+  text << file.rdbuf();
+  return text.str();
+}
+
+// Values of a DataArray of the appended block, found by its name
+template <typename T>
+std::vector<T> appendedValues(const std::string &text, const std::string &name)
+{
+  const std::size_t element = text.find("Name=\"" + name + "\"");
+  const std::size_t offsetStart = text.find("offset=\"", element) + 8;
+  const std::size_t offset =
+      std::stoul(text.substr(offsetStart, text.find('"', offsetStart)));
+  const std::size_t start = text.find("<AppendedData");
+  const char *block = text.data() + text.find('_', start) + 1 + offset;
+
+  std::uint64_t nBytes = 0;
+  std::memcpy(&nBytes, block, sizeof(nBytes));
+  std::vector<T> values(nBytes / sizeof(T));
+  std::memcpy(values.data(), block + sizeof(nBytes), nBytes);
+  return values;
+}
+
+} // namespace
+
+// ****** Tests ******
+TEST(WriteVtuTest, PolyhedraAndFieldsReadBack)
+{
+  // --- Arrange ---
+  Mesh fvMesh;
+  GenerateMesh meshGenerator;
+  meshGenerator.cartesianBox(fvMesh, {3, 2, 2}, {3.0, 2.0, 2.0});
+  std::vector<double> temperature(fvMesh.nCells());
+  std::vector<std::array<double, 3>> velocity(fvMesh.nCells());
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    temperature[iElement] = 300.0 + iElement / 3.0;
+    velocity[iElement] = {1.0 * iElement, -0.5, 0.25 * iElement};
+  }
+  const std::string fileName =
+      (std::filesystem::temp_directory_path() / "testWriteVtu.vtu").string();
+  WriteVtu vtuWriter(fvMesh);
+
+  // --- Act ---
+  vtuWriter.addField("T", temperature);
+  vtuWriter.addField("U", velocity);
+  vtuWriter.write(fileName);
+  const std::string text = readFile(fileName);
+
+  // --- Assert ---
+  EXPECT_EQ(vtuWriter.bytesWritten(), text.size());
+  EXPECT_NE(text.find("NumberOfPoints=\"36\" NumberOfCells=\"12\""),
+            std::string::npos);
+
+  const std::vector<double> points = appendedValues<double>(text, "Points");
+  ASSERT_EQ(points.size(), 3 * fvMesh.nNodes());
+  for (std::size_t iNode = 0; iNode < fvMesh.nNodes(); ++iNode) {
+    for (std::size_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(points[3 * iNode + i], fvMesh.nodes()[iNode].centroid()[i]);
+    }
+  }
+
+  const std::vector<std::uint8_t> types =
+      appendedValues<std::uint8_t>(text, "types");
+  EXPECT_EQ(types, std::vector<std::uint8_t>(fvMesh.nCells(), 42));
+
+  // Hexahedra: 6 faces of 4 nodes each, with outward normals
+  const std::vector<std::int64_t> faces =
+      appendedValues<std::int64_t>(text, "faces");
+  const std::vector<std::int64_t> faceOffsets =
+      appendedValues<std::int64_t>(text, "faceoffsets");
+  ASSERT_EQ(faceOffsets.size(), fvMesh.nCells());
+  EXPECT_EQ(faceOffsets.back(), static_cast<std::int64_t>(faces.size()));
+  std::size_t position = 0;
+  for (std::size_t iElement = 0; iElement < fvMesh.nCells(); ++iElement) {
+    const std::array<double, 3> &cellCentroid =
+        fvMesh.cells()[iElement].centroid();
+    ASSERT_EQ(faces[position++], 6);
+    for (std::size_t iFace = 0; iFace < 6; ++iFace) {
+      ASSERT_EQ(faces[position++], 4);
+      std::array<std::array<double, 3>, 4> corners;
+      std::array<double, 3> faceCentroid = {0.0, 0.0, 0.0};
+      for (std::size_t iNode = 0; iNode < 4; ++iNode) {
+        corners[iNode] = fvMesh.nodes()[faces[position++]].centroid();
+        for (std::size_t i = 0; i < 3; ++i) {
+          faceCentroid[i] += 0.25 * corners[iNode][i];
+        }
+      }
+      std::array<double, 3> a, b;
+      for (std::size_t i = 0; i < 3; ++i) {
+        a[i] = corners[1][i] - corners[0][i];
+        b[i] = corners[2][i] - corners[1][i];
+      }
+      const std::array<double, 3> normal = {a[1] * b[2] - a[2] * b[1],
+                                            a[2] * b[0] - a[0] * b[2],
+                                            a[0] * b[1] - a[1] * b[0]};
+      double outward = 0.0;
+      for (std::size_t i = 0; i < 3; ++i) {
+        outward += normal[i] * (faceCentroid[i] - cellCentroid[i]);
+      }
+      EXPECT_GT(outward, 0.0);
+    }
+    EXPECT_EQ(faceOffsets[iElement], static_cast<std::int64_t>(position));
+  }
+
+  EXPECT_EQ(appendedValues<double>(text, "T"), temperature);
+  EXPECT_EQ((appendedValues<std::array<double, 3>>(text, "U")), velocity);
+  EXPECT_NE(text.find("Name=\"U\" NumberOfComponents=\"3\""),
+            std::string::npos);
+}
+
+TEST(WriteVtuTest, TimeStepsAreListedInSeries)
+{
+  // --- Arrange ---
+  const std::filesystem::path caseDirectory =
+      std::filesystem::temp_directory_path() / "testWriteVtuSeries";
+  std::filesystem::remove_all(caseDirectory);
+  Mesh fvMesh(caseDirectory.string());
+  GenerateMesh meshGenerator;
+  meshGenerator.cartesianBox(fvMesh, {2, 1, 1}, {2.0, 1.0, 1.0});
+  std::vector<double> temperature = {300.0, 310.0};
+  WriteVtu vtuWriter(fvMesh);
+
+  // --- Act ---
+  for (const double time : {0.5, 1.0}) {
+    temperature[1] += 10.0;
+    vtuWriter.addField("T", temperature);
+    vtuWriter.writeTimeStep(time);
+  }
+  const std::string series =
+      readFile((caseDirectory / "VTK" / "testWriteVtuSeries.pvd").string());
+
+  // --- Assert ---
+  EXPECT_NE(series.find("<DataSet timestep=\"0.5\" part=\"0\" "
+                        "file=\"testWriteVtuSeries_0.vtu\"/>\n"
+                        "    <DataSet timestep=\"1\" part=\"0\" "
+                        "file=\"testWriteVtuSeries_1.vtu\"/>"),
+            std::string::npos);
+  const std::string lastStep =
+      readFile((caseDirectory / "VTK" / "testWriteVtuSeries_1.vtu").string());
+  EXPECT_EQ(appendedValues<double>(lastStep, "T"),
+            std::vector<double>({300.0, 330.0}));
+  EXPECT_THROW(vtuWriter.addField("T", std::vector<double>(3)),
+               std::runtime_error);
+}
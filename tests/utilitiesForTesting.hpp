@@ -1,6 +1,7 @@
 #ifndef TEST_UTILITY_HPP
 #define TEST_UTILITY_HPP
 
+#include "ginkgo/ginkgo.hpp"
 #include <cmath>
 #include <cstddef>
 #include <gtest/gtest.h>
@@ -67,4 +68,35 @@ inline ::testing::AssertionResult ScalarAlmostEqual(const double &actual,
   return ::testing::AssertionSuccess();
 }
 
+// Finite-difference Laplacian with Dirichlet boundaries on a grid of n points
+// in each of nDimensions directions, numbered with the first direction
+// fastest, plus a diagonal shift. In 1D the eigenvalues are
+// 2 - 2 cos(k pi / (n + 1)).
+inline gko::matrix_data<double, int>
+laplacianMatrix(const int n, const int nDimensions = 2,
+                const double shift = 0.0) {
+  int nRows = 1;
+  for (int d = 0; d < nDimensions; ++d) {
+    nRows *= n;
+  }
+  gko::matrix_data<double, int> data;
+  data.size = {static_cast<std::size_t>(nRows),
+               static_cast<std::size_t>(nRows)};
+  for (int row = 0; row < nRows; ++row) {
+    data.nonzeros.emplace_back(row, row, 2.0 * nDimensions + shift);
+    int stride = 1;
+    for (int d = 0; d < nDimensions; ++d) {
+      const int i = row / stride % n;
+      if (i > 0) {
+        data.nonzeros.emplace_back(row, row - stride, -1.0);
+      }
+      if (i < n - 1) {
+        data.nonzeros.emplace_back(row, row + stride, -1.0);
+      }
+      stride *= n;
+    }
+  }
+  return data;
+}
+
 #endif // TEST_UTILITY_HPP
\ No newline at end of file